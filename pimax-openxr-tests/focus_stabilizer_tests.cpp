@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <gaze_history.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using gaze::FocusStabilizer;
+
+    // One call to FocusStabilizer::update() from a gaze trace (see traces/generate_traces.py), and its result.
+    struct ReplayedFrame {
+        double time;
+        double sampleTime;
+        XrVector3f gaze;
+        std::string phase;
+
+        gaze::FocusRegion region;
+    };
+
+    std::vector<ReplayedFrame> replayTrace(const std::string& name) {
+        const std::filesystem::path path = test::getDataDirectory() / "traces" / name;
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw test::Failure{fmt::format("Cannot open {}", path.string())};
+        }
+
+        std::vector<ReplayedFrame> frames;
+        FocusStabilizer stabilizer;
+        bool hasHeader = false;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            if (!hasHeader) {
+                hasHeader = true;
+                continue;
+            }
+
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream fields(line);
+            ReplayedFrame frame;
+            if (!(fields >> frame.time >> frame.sampleTime >> frame.gaze.x >> frame.gaze.y >> frame.gaze.z >>
+                  frame.phase)) {
+                throw test::Failure{fmt::format("Malformed line in {}: {}", name, line)};
+            }
+
+            frame.region = stabilizer.update(frame.time, frame.gaze, frame.sampleTime);
+            frames.push_back(frame);
+        }
+        CHECK(!frames.empty());
+
+        return frames;
+    }
+
+    float angleBetween(const XrVector3f& a, const XrVector3f& b) {
+        return std::acos(std::clamp(a.x * b.x + a.y * b.y + a.z * b.z, -1.f, 1.f));
+    }
+
+    using FrameIterator = std::vector<ReplayedFrame>::const_iterator;
+
+    bool isSameRegion(const gaze::FocusRegion& a, const gaze::FocusRegion& b) {
+        return a.unitVector.x == b.unitVector.x && a.unitVector.y == b.unitVector.y && a.unitVector.z == b.unitVector.z;
+    }
+
+    // Check that the region of a fixation covers the gaze, and that it is held once it settled on the average gaze.
+    void checkFixation(FrameIterator begin, FrameIterator end) {
+        const double settledTime = begin->time + FocusStabilizer::k_settleDuration;
+        const auto settled =
+            std::find_if(begin, end, [&](const ReplayedFrame& frame) { return frame.time >= settledTime; });
+        CHECK(settled != end);
+
+        for (auto frame = begin; frame != end; ++frame) {
+            CHECK(angleBetween(frame->region.unitVector, frame->gaze) <= FocusStabilizer::k_fixationRadius);
+            if (frame->time >= settledTime) {
+                CHECK(isSameRegion(frame->region, settled->region));
+            }
+        }
+    }
+
+} // namespace
+
+TEST_CASE(FocusStabilizer_FixationWithJitter) {
+    const std::vector<ReplayedFrame> frames = replayTrace("fixation_jitter.csv");
+
+    // The region is held, and never widened.
+    checkFixation(frames.cbegin(), frames.cend());
+    for (const ReplayedFrame& frame : frames) {
+        CHECK(frame.region.confidence == 1.f);
+    }
+}
+
+TEST_CASE(FocusStabilizer_Saccade) {
+    const std::vector<ReplayedFrame> frames = replayTrace("saccade.csv");
+
+    const auto isSaccade = [](const ReplayedFrame& frame) { return frame.phase == "saccade"; };
+    const auto firstSaccade = std::find_if(frames.cbegin(), frames.cend(), isSaccade);
+    const auto landing = std::find_if_not(firstSaccade, frames.cend(), isSaccade);
+    CHECK(firstSaccade != frames.cend());
+    CHECK(landing != frames.cend());
+
+    // The region is held during the first fixation.
+    checkFixation(frames.cbegin(), firstSaccade);
+    for (auto frame = frames.cbegin(); frame != firstSaccade; ++frame) {
+        CHECK(frame->region.confidence == 1.f);
+    }
+
+    // The region follows the gaze in flight, and the confidence drops. The saccade is detected from the motion of the
+    // gaze, so its first and last samples, where the eye is still slow, may count as fixations.
+    auto lastInFlight = frames.cend();
+    for (auto frame = firstSaccade; frame != landing; ++frame) {
+        CHECK(angleBetween(frame->region.unitVector, frame->gaze) <= FocusStabilizer::k_fixationRadius);
+        if (frame->region.confidence == 0.f) {
+            lastInFlight = frame;
+        }
+    }
+    CHECK(lastInFlight != frames.cend());
+    CHECK(angleBetween(landing->region.unitVector, std::prev(firstSaccade)->region.unitVector) >
+          FocusStabilizer::k_fixationRadius);
+
+    // The region is held where the saccade landed, while the confidence recovers over the settle duration.
+    checkFixation(landing, frames.cend());
+    for (auto frame = std::next(lastInFlight); frame != frames.cend(); ++frame) {
+        const double elapsed = frame->time - lastInFlight->time;
+        CHECK_NEAR(frame->region.confidence, std::min(elapsed / FocusStabilizer::k_settleDuration, 1.0), 1e-6);
+    }
+    CHECK(landing->region.confidence < 1.f);
+    CHECK(frames.back().region.confidence == 1.f);
+}
+
+TEST_CASE(FocusStabilizer_StaleSample) {
+    const std::vector<ReplayedFrame> frames = replayTrace("stale_sample.csv");
+
+    // The eyes did not move, so the region is held.
+    checkFixation(frames.cbegin(), frames.cend());
+
+    bool hasFadingConfidence = false;
+    bool hasZeroConfidence = false;
+    for (const ReplayedFrame& frame : frames) {
+        // The confidence fades once the sample is too old, and recovers with the next sample.
+        const double age = frame.time - frame.sampleTime;
+        if (age <= FocusStabilizer::k_maxSampleAge) {
+            CHECK(frame.region.confidence == 1.f);
+        } else {
+            CHECK(frame.phase == "stale");
+            const double expected = std::max(1.0 - (age - FocusStabilizer::k_maxSampleAge) /
+                                                       FocusStabilizer::k_maxSampleAge,
+                                             0.0);
+            CHECK_NEAR(frame.region.confidence, expected, 1e-6);
+            hasFadingConfidence = hasFadingConfidence || (expected > 0 && expected < 1);
+            hasZeroConfidence = hasZeroConfidence || expected == 0;
+        }
+    }
+    CHECK(hasFadingConfidence);
+    CHECK(hasZeroConfidence);
+    CHECK(frames.back().region.confidence == 1.f);
+}
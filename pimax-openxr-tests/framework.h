@@ -0,0 +1,103 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// A minimal test and benchmark harness. The test cases exercise the units of the runtime that do not need a headset,
+// and the benchmarks measure the hot paths. The tests run by default, the benchmarks run with --benchmark.
+
+namespace pimax_openxr::test {
+
+    using TestFunction = void (*)();
+
+    struct TestCase {
+        const char* name;
+        TestFunction function;
+        bool isBenchmark;
+    };
+
+    std::vector<TestCase>& getTestCases();
+
+    struct Registration {
+        Registration(const char* name, TestFunction function, bool isBenchmark) {
+            getTestCases().push_back({name, function, isBenchmark});
+        }
+    };
+
+    // Thrown by a failed check, to abort the test case.
+    struct Failure {
+        std::string message;
+    };
+
+    // Thrown when the test case cannot run in this environment (eg: the runtime is not installed).
+    struct Skipped {
+        std::string reason;
+    };
+
+    namespace detail {
+        void check(bool condition, const char* expression, const char* fileAndLine);
+        void checkNear(
+            double actual, double expected, double tolerance, const char* expressions, const char* fileAndLine);
+
+        // Defined in another translation unit, so that the compiler cannot see that the value is not used.
+        void useValue(const volatile void* value);
+    } // namespace detail
+
+    // The directory of the executable, where the data files (eg: the gaze traces) are deployed.
+    const std::filesystem::path& getDataDirectory();
+
+    // Print a measurement of a benchmark.
+    void report(const std::string& name, double value, const char* unit);
+
+    // Run the function repeatedly and return the average duration of one iteration, in nanoseconds.
+    template <typename F>
+    double measure(size_t iterations, F&& function) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            function(i);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+    }
+
+    // Prevent the compiler from optimizing out a computation whose result is not used.
+    template <typename T>
+    void doNotOptimize(const T& value) {
+        detail::useValue(&value);
+    }
+
+} // namespace pimax_openxr::test
+
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static const pimax_openxr::test::Registration name##Registration(#name, name, false);                              \
+    static void name()
+
+#define BENCHMARK(name)                                                                                                \
+    static void name();                                                                                                \
+    static const pimax_openxr::test::Registration name##Registration(#name, name, true);                               \
+    static void name()
+
+#define CHECK(condition) pimax_openxr::test::detail::check(!!(condition), #condition, FILE_AND_LINE)
+#define CHECK_NEAR(actual, expected, tolerance)                                                                        \
+    pimax_openxr::test::detail::checkNear((actual), (expected), (tolerance), #actual ", " #expected, FILE_AND_LINE)
+#define SKIP(reason) throw pimax_openxr::test::Skipped{reason}
@@ -0,0 +1,259 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <thread>
+
+#include <gaze_history.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+
+    XrVector3f normalize(const XrVector3f& v) {
+        const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        return {v.x / length, v.y / length, v.z / length};
+    }
+
+    // A gaze rotated by the given angle (in radians) to the right.
+    XrVector3f gazeAt(double angle) {
+        return {static_cast<float>(std::sin(angle)), 0, static_cast<float>(-std::cos(angle))};
+    }
+
+    // Linear blend, with t beyond [0, 1] extrapolating.
+    XrVector3f mix(const XrVector3f& a, const XrVector3f& b, double t) {
+        const float s = static_cast<float>(t);
+        return normalize({a.x + (b.x - a.x) * s, a.y + (b.y - a.y) * s, a.z + (b.z - a.z) * s});
+    }
+
+    void checkGaze(const XrVector3f& actual, const XrVector3f& expected) {
+        CHECK_NEAR(actual.x, expected.x, 1e-5);
+        CHECK_NEAR(actual.y, expected.y, 1e-5);
+        CHECK_NEAR(actual.z, expected.z, 1e-5);
+    }
+
+} // namespace
+
+TEST_CASE(GazeHistory_Interpolation) {
+    gaze::History history;
+    gaze::Sample sample;
+    CHECK(!history.getLatest(sample));
+    CHECK(!history.sample(1.0, sample));
+
+    history.push({1.00, gazeAt(0.00)});
+    history.push({1.01, gazeAt(0.02)});
+    history.push({1.02, gazeAt(0.06)});
+
+    // Between two samples, the gaze is blended and stamped with the requested time.
+    CHECK(history.sample(1.005, sample));
+    CHECK_NEAR(sample.time, 1.005, 1e-9);
+    checkGaze(sample.unitVector, mix(gazeAt(0.00), gazeAt(0.02), 0.5));
+    CHECK(history.sample(1.0175, sample));
+    CHECK_NEAR(sample.time, 1.0175, 1e-9);
+    checkGaze(sample.unitVector, mix(gazeAt(0.02), gazeAt(0.06), 0.75));
+
+    // Exactly on a sample.
+    CHECK(history.sample(1.01, sample));
+    checkGaze(sample.unitVector, gazeAt(0.02));
+
+    // Before the history, the oldest sample is held.
+    CHECK(history.sample(0.5, sample));
+    CHECK_NEAR(sample.time, 1.0, 1e-9);
+    checkGaze(sample.unitVector, gazeAt(0.00));
+
+    CHECK(history.getLatest(sample));
+    CHECK_NEAR(sample.time, 1.02, 1e-9);
+}
+
+TEST_CASE(GazeHistory_BoundedExtrapolation) {
+    gaze::History history;
+    history.push({1.00, gazeAt(0.00)});
+    history.push({1.01, gazeAt(0.01)});
+
+    // Past the latest sample, the motion since the previous sample continues. The time is the one of the latest
+    // sample, since the gaze was not observed later.
+    const auto extrapolate = [](double t) { return mix(gazeAt(0.00), gazeAt(0.01), t); };
+    gaze::Sample sample;
+    CHECK(history.sample(1.015, sample));
+    CHECK_NEAR(sample.time, 1.01, 1e-9);
+    checkGaze(sample.unitVector, extrapolate(1.5));
+
+    // The horizon is clamped to k_maxExtrapolation.
+    const double maxT = 1 + gaze::History::k_maxExtrapolation / 0.01;
+    CHECK(history.sample(1.01 + gaze::History::k_maxExtrapolation, sample));
+    checkGaze(sample.unitVector, extrapolate(maxT));
+    CHECK(history.sample(2.0, sample));
+    checkGaze(sample.unitVector, extrapolate(maxT));
+
+    // Samples too far apart do not tell the motion of the gaze: the latest one is held.
+    history.push({1.01 + 2 * gaze::History::k_maxSampleInterval, gazeAt(0.1)});
+    CHECK(history.sample(2.0, sample));
+    checkGaze(sample.unitVector, gazeAt(0.1));
+
+    // A single sample is held too.
+    gaze::History single;
+    single.push({1.0, gazeAt(0.05)});
+    CHECK(single.sample(1.01, sample));
+    CHECK_NEAR(sample.time, 1.0, 1e-9);
+    checkGaze(sample.unitVector, gazeAt(0.05));
+}
+
+TEST_CASE(GazeHistory_Clear) {
+    gaze::History history;
+    for (int i = 0; i < 100; i++) {
+        history.push({i * 0.01, gazeAt(0.00)});
+    }
+
+    history.clear();
+    gaze::Sample sample;
+    CHECK(!history.getLatest(sample));
+    CHECK(!history.sample(1.0, sample));
+
+    // The samples of the new run are not blended with the previous ones.
+    history.push({0.5, gazeAt(0.1)});
+    CHECK(history.sample(0.5, sample));
+    checkGaze(sample.unitVector, gazeAt(0.1));
+    CHECK(history.getLatest(sample));
+    CHECK_NEAR(sample.time, 0.5, 1e-9);
+}
+
+TEST_CASE(GazeHistory_ConcurrentPublication) {
+    // Two eye trackers push samples while the application reads them. Each field of a sample is derived from its
+    // time, so that a torn read (fields from different samples) can be detected.
+    constexpr int k_producers = 2;
+    const auto makeSample = [](double time) {
+        const float t = static_cast<float>(time);
+        return gaze::Sample{time, {t, -t, 2 * t}};
+    };
+    const auto isConsistent = [&](const gaze::Sample& sample) {
+        const gaze::Sample expected = makeSample(sample.time);
+        return sample.unitVector.x == expected.unitVector.x && sample.unitVector.y == expected.unitVector.y &&
+               sample.unitVector.z == expected.unitVector.z;
+    };
+
+    gaze::History history;
+    std::atomic<bool> stop{false};
+    std::array<double, k_producers> lastPushedTimes{};
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < k_producers; producer++) {
+        producers.emplace_back([&, producer]() {
+            uint64_t i = 0;
+            while (!stop) {
+                lastPushedTimes[producer] = static_cast<double>(++i * k_producers + producer);
+                history.push(makeSample(lastPushedTimes[producer]));
+            }
+        });
+    }
+
+    // The checks are made once the producers are joined.
+    uint64_t reads = 0;
+    uint64_t tornReads = 0;
+    uint64_t snapshots = 0;
+    const auto end = std::chrono::steady_clock::now() + 500ms;
+    while (std::chrono::steady_clock::now() < end) {
+        gaze::Sample sample;
+        if (!history.getLatest(sample)) {
+            continue;
+        }
+        reads++;
+        if (!isConsistent(sample)) {
+            tornReads++;
+        }
+
+        // The snapshot of the ring must be consistent too. It may come up empty when the producers overwrite the whole
+        // ring while it is being read. The samples are too far apart to be extrapolated.
+        if (history.sample(INFINITY, sample)) {
+            snapshots++;
+            if (!isConsistent(sample)) {
+                tornReads++;
+            }
+        }
+    }
+    stop = true;
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    CHECK(reads > 0);
+    CHECK(tornReads == 0);
+    CHECK(snapshots > 0);
+
+    // Once the producers are done, the most recent sample is the last one of a producer (the others might have pushed
+    // enough samples after it to overwrite it).
+    gaze::Sample latest;
+    CHECK(history.sample(INFINITY, latest));
+    CHECK(isConsistent(latest));
+    CHECK(std::find(lastPushedTimes.cbegin(), lastPushedTimes.cend(), latest.time) != lastPushedTimes.cend());
+}
+
+TEST_CASE(ClockMapping_Calibration) {
+    // A 100Hz tracker, counting in milliseconds, microseconds or 100ns units, whose samples arrive 5 to 8ms after they
+    // were taken.
+    for (const double secondsPerTick : {1e-3, 1e-6, 1e-7}) {
+        gaze::ClockMapping clock;
+        const int64_t firstTimestamp = 123456789;
+        const double firstTime = 100.0;
+        constexpr double minLatency = 0.005;
+        bool wasCalibrated = false;
+        for (int i = 0; i < 300; i++) {
+            const double time = firstTime + i * 0.01;
+            const int64_t timestamp = firstTimestamp + static_cast<int64_t>(std::llround(i * 0.01 / secondsPerTick));
+            const double arrivalTime = time + minLatency + 0.003 * ((i * 7) % 5) / 4;
+
+            const double mapped = clock.map(timestamp, arrivalTime);
+            if (!clock.isCalibrated()) {
+                // Until the units are known, the arrival time is the best guess.
+                CHECK(!wasCalibrated);
+                CHECK(mapped == arrivalTime);
+                continue;
+            }
+            wasCalibrated = true;
+
+            // The units are snapped to a power of ten despite the jitter, and once the minimum latency has been
+            // observed (every 5 samples), the sample time is recovered up to that constant latency.
+            CHECK(mapped <= arrivalTime);
+            if (i >= 105) {
+                CHECK_NEAR(mapped, time + minLatency, 1e-9);
+            }
+        }
+        CHECK(wasCalibrated);
+    }
+}
+
+TEST_CASE(ClockMapping_Restart) {
+    gaze::ClockMapping clock;
+    for (int i = 0; i < 200; i++) {
+        clock.map(1000 + i * 10, 100.0 + i * 0.01 + 0.005);
+    }
+    CHECK(clock.isCalibrated());
+
+    // The timestamps went backwards: the tracker restarted, and the mapping starts over.
+    CHECK(clock.map(50, 110.0) == 110.0);
+    CHECK(!clock.isCalibrated());
+
+    // Invalid timestamps are stamped with their arrival time.
+    CHECK(clock.map(0, 111.0) == 111.0);
+    CHECK(clock.map(-5, 112.0) == 112.0);
+}
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <random>
+
+#include <hand_skeleton.h>
+#include <space_motion.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using namespace xr::math;
+    using Joints = extrapolation::SkeletonExtrapolator::Joints;
+
+    void checkQuaternion(const XrQuaternionf& actual, const XrQuaternionf& expected) {
+        // q and -q are the same rotation.
+        const float dot =
+            actual.x * expected.x + actual.y * expected.y + actual.z * expected.z + actual.w * expected.w;
+        const float sign = dot >= 0 ? 1.f : -1.f;
+        CHECK_NEAR(actual.x, sign * expected.x, 1e-5);
+        CHECK_NEAR(actual.y, sign * expected.y, 1e-5);
+        CHECK_NEAR(actual.z, sign * expected.z, 1e-5);
+        CHECK_NEAR(actual.w, sign * expected.w, 1e-5);
+    }
+
+    void checkPose(const XrPosef& actual, const XrPosef& expected) {
+        checkQuaternion(actual.orientation, expected.orientation);
+        CHECK_NEAR(actual.position.x, expected.position.x, 1e-5);
+        CHECK_NEAR(actual.position.y, expected.position.y, 1e-5);
+        CHECK_NEAR(actual.position.z, expected.position.z, 1e-5);
+    }
+
+    XrPosef makeRandomPose(std::mt19937& random, float maxAngle, float maxDistance) {
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+        const XrVector3f angles{unit(random) * maxAngle, unit(random) * maxAngle, unit(random) * maxAngle};
+        const XrVector3f position{unit(random) * maxDistance, unit(random) * maxDistance, unit(random) * maxDistance};
+        return Pose::MakePose(Quaternion::RotationRollPitchYaw(angles), position);
+    }
+
+    // A skeleton with each bone slightly bent and offset from its parent, like PVR reports it.
+    pvrSkeletalData makeRandomSkeleton(std::mt19937& random) {
+        pvrSkeletalData skeletalData{};
+        skeletalData.boneCount = XR_HAND_JOINT_COUNT_EXT;
+        for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+            const XrPosef bone = makeRandomPose(random, 0.5f, 0.03f);
+            skeletalData.boneTransforms[i].Orientation = {
+                bone.orientation.x, bone.orientation.y, bone.orientation.z, bone.orientation.w};
+            skeletalData.boneTransforms[i].Position = {bone.position.x, bone.position.y, bone.position.z};
+        }
+        return skeletalData;
+    }
+
+    // The bone structure composed one bone at a time with Pose::Multiply().
+    // https://github.com/ValveSoftware/openvr/wiki/Hand-Skeleton#bone-structure
+    Joints getReferenceJoints(const pvrSkeletalData& skeletalData, int side) {
+        Joints joints;
+        XrPosef parent = Pose::Identity();
+        XrPosef wrist = parent;
+        XrVector3f barycenter{0, 0, 0};
+        for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+            const pvrPosef& bone = skeletalData.boneTransforms[i];
+            const XrQuaternionf boneOrientation{
+                bone.Orientation.x, bone.Orientation.y, bone.Orientation.z, bone.Orientation.w};
+            const XrVector3f bonePosition{bone.Position.x, bone.Position.y, bone.Position.z};
+            const XrPosef pose = Pose::Multiply(Pose::MakePose(boneOrientation, bonePosition), parent);
+            parent = pose;
+
+            const XrQuaternionf& correction =
+                i == XR_HAND_JOINT_WRIST_EXT ? hands::k_wristCorrection[side] : hands::k_fingerCorrection[side];
+            joints[i] = Pose::MakePose(Quaternion::Multiply(correction, pose.orientation), pose.position);
+
+            if (i == XR_HAND_JOINT_WRIST_EXT) {
+                wrist = pose;
+            }
+            if (i == XR_HAND_JOINT_INDEX_METACARPAL_EXT || i == XR_HAND_JOINT_INDEX_PROXIMAL_EXT ||
+                i == XR_HAND_JOINT_MIDDLE_METACARPAL_EXT || i == XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT ||
+                i == XR_HAND_JOINT_RING_METACARPAL_EXT || i == XR_HAND_JOINT_RING_PROXIMAL_EXT ||
+                i == XR_HAND_JOINT_LITTLE_METACARPAL_EXT || i == XR_HAND_JOINT_LITTLE_PROXIMAL_EXT) {
+                barycenter = barycenter + pose.position;
+            }
+            if (i == XR_HAND_JOINT_THUMB_TIP_EXT || i == XR_HAND_JOINT_INDEX_TIP_EXT ||
+                i == XR_HAND_JOINT_MIDDLE_TIP_EXT || i == XR_HAND_JOINT_RING_TIP_EXT ||
+                i == XR_HAND_JOINT_LITTLE_TIP_EXT) {
+                parent = wrist;
+            }
+        }
+        joints[XR_HAND_JOINT_PALM_EXT] = Pose::MakePose(joints[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT].orientation,
+                                                        barycenter * (1.f / 8.f));
+        return joints;
+    }
+
+} // namespace
+
+TEST_CASE(HandSkeleton_CorrectionQuaternions) {
+    const auto fromDegrees = [](float pitch, float yaw, float roll) {
+        return Quaternion::RotationRollPitchYaw(
+            {PVR::DegreeToRad(pitch), PVR::DegreeToRad(yaw), PVR::DegreeToRad(roll)});
+    };
+
+    checkQuaternion(hands::k_fingerCorrection[0], fromDegrees(0, -90, 180));
+    checkQuaternion(hands::k_fingerCorrection[1], fromDegrees(180, -90, 180));
+    checkQuaternion(hands::k_wristCorrection[0], fromDegrees(180, 0, -90));
+    checkQuaternion(hands::k_wristCorrection[1], fromDegrees(180, 0, 90));
+}
+
+TEST_CASE(HandSkeleton_SkeletonJoints) {
+    std::mt19937 random(1);
+    for (int side = 0; side < 2; side++) {
+        for (int i = 0; i < 20; i++) {
+            const pvrSkeletalData skeletalData = makeRandomSkeleton(random);
+            Joints joints;
+            hands::getSkeletonJoints(skeletalData, side, joints);
+
+            const Joints expected = getReferenceJoints(skeletalData, side);
+            for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+                checkPose(joints[j], expected[j]);
+            }
+        }
+    }
+}
+
+TEST_CASE(HandSkeleton_ComposeJoints) {
+    std::mt19937 random(2);
+    for (int i = 0; i < 20; i++) {
+        Joints joints;
+        hands::getSkeletonJoints(makeRandomSkeleton(random), i % 2, joints);
+        const XrPosef controllerPose = makeRandomPose(random, 3.f, 1.f);
+
+        Joints jointsToVirtual;
+        hands::composeJoints(joints, controllerPose, jointsToVirtual);
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+            checkPose(jointsToVirtual[j], Pose::Multiply(joints[j], controllerPose));
+        }
+    }
+}
+
+// The work of xrLocateHandJointsEXT() for both hands, for each of the base spaces an application locates the hands in
+// during a frame. The skeleton only depends on the frame (see m_skeletalCache), so it can be composed once per hand
+// rather than once per base space.
+BENCHMARK(HandSkeleton_LocateJoints) {
+    constexpr size_t k_frames = 2000;
+
+    std::mt19937 random(3);
+    const pvrSkeletalData skeletalData[2] = {makeRandomSkeleton(random), makeRandomSkeleton(random)};
+    const XrPosef controllerPoses[2] = {makeRandomPose(random, 3.f, 1.f), makeRandomPose(random, 3.f, 1.f)};
+    std::vector<XrPosef> baseSpaces;
+    for (int i = 0; i < 16; i++) {
+        baseSpaces.push_back(makeRandomPose(random, 3.f, 1.f));
+    }
+
+    const auto locateJoints = [&](const Joints& joints, const XrPosef& controllerPose, const XrPosef& baseSpace) {
+        Joints jointsToVirtual;
+        hands::composeJoints(joints, controllerPose, jointsToVirtual);
+
+        const XrPosef virtualToBaseSpace = Pose::Invert(baseSpace);
+        std::array<XrPosef, XR_HAND_JOINT_COUNT_EXT> locations;
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+            const XrSpaceVelocity noVelocity{XR_TYPE_SPACE_VELOCITY};
+            motion::composeLocation(XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT,
+                                    jointsToVirtual[j],
+                                    noVelocity,
+                                    XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT,
+                                    virtualToBaseSpace,
+                                    noVelocity,
+                                    locations[j],
+                                    nullptr);
+        }
+        test::doNotOptimize(locations);
+    };
+
+    for (const size_t baseSpacesCount : {1, 2, 4, 16}) {
+        const double uncached = test::measure(k_frames, [&](size_t) {
+            for (int side = 0; side < 2; side++) {
+                for (size_t i = 0; i < baseSpacesCount; i++) {
+                    Joints joints;
+                    hands::getSkeletonJoints(skeletalData[side], side, joints);
+                    locateJoints(joints, controllerPoses[side], baseSpaces[i]);
+                }
+            }
+        });
+        const double cached = test::measure(k_frames, [&](size_t) {
+            for (int side = 0; side < 2; side++) {
+                Joints joints;
+                hands::getSkeletonJoints(skeletalData[side], side, joints);
+                for (size_t i = 0; i < baseSpacesCount; i++) {
+                    locateJoints(joints, controllerPoses[side], baseSpaces[i]);
+                }
+            }
+        });
+        test::report(fmt::format("{} base spaces, per frame, uncached", baseSpacesCount), uncached, "ns");
+        test::report(fmt::format("{} base spaces, per frame, cached", baseSpacesCount), cached, "ns");
+    }
+
+    // The joints moved along with the controller in registers, versus one Pose::Multiply() per joint.
+    Joints joints;
+    hands::getSkeletonJoints(skeletalData[0], 0, joints);
+    const double composeJoints = test::measure(100000, [&](size_t) {
+        Joints jointsToVirtual;
+        hands::composeJoints(joints, controllerPoses[0], jointsToVirtual);
+        test::doNotOptimize(jointsToVirtual);
+    });
+    const double multiply = test::measure(100000, [&](size_t) {
+        Joints jointsToVirtual;
+        for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+            jointsToVirtual[j] = Pose::Multiply(joints[j], controllerPoses[0]);
+        }
+        test::doNotOptimize(jointsToVirtual);
+    });
+    test::report("composeJoints()", composeJoints, "ns");
+    test::report("Pose::Multiply() per joint", multiply, "ns");
+}
@@ -0,0 +1,205 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <haptics.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using haptics::Scheduler;
+
+    struct Pulse {
+        int side;
+        float amplitude;
+        int64_t step; // The millisecond at which the pulse was emitted, relative to the start of the test.
+    };
+
+    // Records the pulses instead of sending them to the device.
+    struct RecordingSink : haptics::IPulseSink {
+        void pulse(int side, float amplitude) override {
+            pulses.push_back({side, amplitude, step});
+        }
+
+        std::vector<Pulse> getPulses(int side) const {
+            std::vector<Pulse> sidePulses;
+            std::copy_if(pulses.cbegin(), pulses.cend(), std::back_inserter(sidePulses), [&](const Pulse& pulse) {
+                return pulse.side == side;
+            });
+            return sidePulses;
+        }
+
+        std::vector<Pulse> pulses;
+        int64_t step{0};
+    };
+
+    // Drives a scheduler without its thread, one millisecond at a time.
+    struct Harness {
+        Harness() : sink(std::make_shared<RecordingSink>()), scheduler(sink, false /* useThread */) {
+            // The scheduler starts a vibration at the later of the current time and the last processed time. Start the
+            // steps ahead of the clock, so that the vibrations start exactly at the next step.
+            start = Scheduler::clock::now() + 10s;
+            scheduler.processUntil(start - 1ms);
+        }
+
+        void runUntil(int64_t lastStep) {
+            for (; nextStep <= lastStep; nextStep++) {
+                sink->step = nextStep;
+                scheduler.processUntil(start + std::chrono::milliseconds(nextStep));
+            }
+        }
+
+        // Jump to the given step at once, like a scheduler thread that woke up late.
+        void jumpTo(int64_t step) {
+            nextStep = step;
+            runUntil(step);
+        }
+
+        const std::shared_ptr<RecordingSink> sink;
+        Scheduler scheduler;
+        Scheduler::clock::time_point start;
+        int64_t nextStep{0};
+    };
+
+    void checkSpacing(const std::vector<Pulse>& pulses, int64_t spacing) {
+        for (size_t i = 1; i < pulses.size(); i++) {
+            CHECK(pulses[i].step - pulses[i - 1].step == spacing);
+        }
+    }
+
+} // namespace
+
+TEST_CASE(HapticsScheduler_PulseTrain) {
+    Harness harness;
+    harness.scheduler.apply(0, 0.5f, 100'000'000, 50.f);
+    harness.runUntil(300);
+
+    // One pulse per period, for the duration of the vibration.
+    const std::vector<Pulse> pulses = harness.sink->getPulses(0);
+    CHECK(pulses.size() == 5);
+    CHECK(pulses[0].step == 0);
+    checkSpacing(pulses, 20);
+    for (const Pulse& pulse : pulses) {
+        CHECK(pulse.amplitude == 0.5f);
+    }
+    CHECK(harness.sink->getPulses(1).empty());
+}
+
+TEST_CASE(HapticsScheduler_DefaultAndClampedFrequencies) {
+    Harness harness;
+
+    // Without a frequency, the pulses are 10ms apart.
+    harness.scheduler.apply(0, 1.f, 50'000'000, 0.f);
+
+    // PVR cannot render pulses closer than 5ms.
+    harness.scheduler.apply(1, 1.f, 50'000'000, 1000.f);
+    harness.runUntil(100);
+
+    CHECK(harness.sink->getPulses(0).size() == 5);
+    checkSpacing(harness.sink->getPulses(0), 10);
+    CHECK(harness.sink->getPulses(1).size() == 10);
+    checkSpacing(harness.sink->getPulses(1), 5);
+}
+
+TEST_CASE(HapticsScheduler_MinimumDuration) {
+    Harness harness;
+    harness.scheduler.apply(0, 1.f, XR_MIN_HAPTIC_DURATION, 50.f);
+
+    // Shorter than one period.
+    harness.scheduler.apply(1, 1.f, 1'000'000, 50.f);
+    harness.runUntil(200);
+
+    CHECK(harness.sink->getPulses(0).size() == 1);
+    CHECK(harness.sink->getPulses(1).size() == 1);
+}
+
+TEST_CASE(HapticsScheduler_Preemption) {
+    Harness harness;
+    harness.scheduler.apply(0, 0.5f, 1'000'000'000, 10.f);
+    harness.scheduler.apply(1, 0.2f, 1'000'000'000, 10.f);
+    harness.runUntil(50);
+    CHECK(harness.sink->getPulses(0).size() == 1);
+
+    // The new vibration starts right away, and the pending pulse of the previous one is discarded.
+    harness.scheduler.apply(0, 0.8f, 100'000'000, 50.f);
+    harness.runUntil(1500);
+
+    const std::vector<Pulse> pulses = harness.sink->getPulses(0);
+    CHECK(pulses.size() == 6);
+    CHECK(pulses[1].step == 51);
+    checkSpacing(std::vector<Pulse>(pulses.cbegin() + 1, pulses.cend()), 20);
+    for (size_t i = 1; i < pulses.size(); i++) {
+        CHECK(pulses[i].amplitude == 0.8f);
+    }
+
+    // The other side is not affected.
+    CHECK(harness.sink->getPulses(1).size() == 10);
+    checkSpacing(harness.sink->getPulses(1), 100);
+}
+
+TEST_CASE(HapticsScheduler_Stop) {
+    Harness harness;
+    harness.scheduler.apply(0, 1.f, 1'000'000'000, 50.f);
+    harness.scheduler.apply(1, 1.f, 1'000'000'000, 50.f);
+    harness.runUntil(30);
+    CHECK(harness.sink->getPulses(0).size() == 2);
+
+    harness.scheduler.stop(0);
+    harness.runUntil(100);
+    CHECK(harness.sink->getPulses(0).size() == 2);
+    CHECK(harness.sink->getPulses(1).size() == 6);
+
+    harness.scheduler.stopAll();
+    harness.runUntil(1500);
+    CHECK(harness.sink->getPulses(0).size() == 2);
+    CHECK(harness.sink->getPulses(1).size() == 6);
+
+    // A null amplitude stops the vibration too.
+    harness.scheduler.apply(0, 1.f, 1'000'000'000, 50.f);
+    harness.runUntil(1510);
+    CHECK(harness.sink->getPulses(0).size() == 3);
+    harness.scheduler.apply(0, 0.f, 1'000'000'000, 50.f);
+    harness.runUntil(2000);
+    CHECK(harness.sink->getPulses(0).size() == 3);
+}
+
+TEST_CASE(HapticsScheduler_LateTimersCoalescing) {
+    Harness harness;
+    harness.scheduler.apply(0, 1.f, 100'000'000, 200.f);
+    harness.runUntil(0);
+    CHECK(harness.sink->getPulses(0).size() == 1);
+
+    // Waking up 32ms late emits a single pulse for the 6 that were due, rather than a burst.
+    harness.jumpTo(32);
+    CHECK(harness.sink->getPulses(0).size() == 2);
+
+    // The following pulses stay on the original 5ms grid.
+    harness.runUntil(200);
+    const std::vector<Pulse> pulses = harness.sink->getPulses(0);
+    CHECK(pulses[1].step == 32);
+    CHECK(pulses[2].step == 35);
+    checkSpacing(std::vector<Pulse>(pulses.cbegin() + 2, pulses.cend()), 5);
+    CHECK(pulses.back().step == 95);
+}
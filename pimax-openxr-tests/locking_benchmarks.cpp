@@ -0,0 +1,423 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+#include "runtime_instance.h"
+
+#include <functional>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using namespace xr::math;
+
+    // A thread that does not make progress for this long is considered deadlocked.
+    constexpr auto k_deadlockTimeout = 5s;
+
+    // The threads of the benchmark, each calling the entry points in a loop. A watchdog checks that all of them keep
+    // making progress: when one is stuck, the locks are deadlocked, and since the threads cannot be joined anymore,
+    // the process is terminated.
+    class Workers {
+      public:
+        ~Workers() {
+            stop();
+        }
+
+        // The iteration returns whether it did any work.
+        void add(std::string name, std::function<bool()> iteration) {
+            auto worker = std::make_unique<Worker>();
+            worker->name = std::move(name);
+            worker->thread = std::thread([this, state = worker.get(), iteration = std::move(iteration)]() {
+                try {
+                    while (!m_stop) {
+                        if (iteration()) {
+                            state->iterations++;
+                        }
+                    }
+                } catch (const std::exception& exception) {
+                    std::unique_lock lock(m_errorMutex);
+                    if (m_error.empty()) {
+                        m_error = fmt::format("{}: {}", state->name, exception.what());
+                    }
+                }
+                state->exited = true;
+            });
+            m_workers.push_back(std::move(worker));
+        }
+
+        void run(std::chrono::steady_clock::duration duration) {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<uint64_t> lastIterations(m_workers.size(), 0);
+            std::vector<std::chrono::steady_clock::time_point> lastProgress(m_workers.size(), start);
+            while (std::chrono::steady_clock::now() - start < duration && getError().empty()) {
+                std::this_thread::sleep_for(100ms);
+
+                const auto now = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < m_workers.size(); i++) {
+                    const uint64_t iterations = m_workers[i]->iterations;
+                    if (iterations != lastIterations[i]) {
+                        lastIterations[i] = iterations;
+                        lastProgress[i] = now;
+                    } else if (now - lastProgress[i] > k_deadlockTimeout && getError().empty()) {
+                        terminate(fmt::format("{} made no progress", m_workers[i]->name));
+                    }
+                }
+            }
+        }
+
+        void stop() {
+            m_stop = true;
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& worker : m_workers) {
+                while (!worker->exited) {
+                    if (std::chrono::steady_clock::now() - start > k_deadlockTimeout) {
+                        terminate(fmt::format("{} did not exit", worker->name));
+                    }
+                    std::this_thread::sleep_for(10ms);
+                }
+                worker->thread.join();
+            }
+            m_workers.clear();
+        }
+
+        // The first error that stopped a thread.
+        std::string getError() {
+            std::unique_lock lock(m_errorMutex);
+            return m_error;
+        }
+
+        uint64_t getIterations(const std::string& name) const {
+            uint64_t iterations = 0;
+            for (const auto& worker : m_workers) {
+                if (worker->name.rfind(name, 0) == 0) {
+                    iterations += worker->iterations;
+                }
+            }
+            return iterations;
+        }
+
+      private:
+        struct Worker {
+            std::string name;
+            std::thread thread;
+            std::atomic<uint64_t> iterations{0};
+            std::atomic<bool> exited{false};
+        };
+
+        [[noreturn]] void terminate(const std::string& reason) {
+            std::cout << fmt::format("    FAILED: {} in {}s, the locks are deadlocked",
+                                     reason,
+                                     std::chrono::duration_cast<std::chrono::seconds>(k_deadlockTimeout).count())
+                      << std::endl;
+            std::quick_exit(1);
+        }
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::atomic<bool> m_stop{false};
+        std::mutex m_errorMutex;
+        std::string m_error;
+    };
+
+    ComPtr<ID3D11Device> createDevice(const XrGraphicsRequirementsD3D11KHR& requirements) {
+        ComPtr<IDXGIFactory1> dxgiFactory;
+        CHECK_HRCMD(CreateDXGIFactory1(IID_PPV_ARGS(dxgiFactory.ReleaseAndGetAddressOf())));
+
+        ComPtr<IDXGIAdapter1> dxgiAdapter;
+        for (UINT i = 0; dxgiFactory->EnumAdapters1(i, dxgiAdapter.ReleaseAndGetAddressOf()) == S_OK; i++) {
+            DXGI_ADAPTER_DESC1 desc;
+            CHECK_HRCMD(dxgiAdapter->GetDesc1(&desc));
+            if (!memcmp(&desc.AdapterLuid, &requirements.adapterLuid, sizeof(LUID))) {
+                break;
+            }
+        }
+        if (!dxgiAdapter) {
+            SKIP("Cannot find the adapter of the headset");
+        }
+
+        ComPtr<ID3D11Device> device;
+        CHECK_HRCMD(D3D11CreateDevice(dxgiAdapter.Get(),
+                                      D3D_DRIVER_TYPE_UNKNOWN,
+                                      nullptr,
+                                      0,
+                                      &requirements.minFeatureLevel,
+                                      1,
+                                      D3D11_SDK_VERSION,
+                                      device.ReleaseAndGetAddressOf(),
+                                      nullptr,
+                                      nullptr));
+        return device;
+    }
+
+} // namespace
+
+// Locate spaces from several threads while the frame loop, the actions synchronization and the hand tracking run on
+// their own threads, and a last thread creates and destroys spaces. This needs a headset.
+BENCHMARK(Runtime_LocateSpaceContention) {
+    test::RuntimeInstance runtime({XR_KHR_D3D11_ENABLE_EXTENSION_NAME, XR_EXT_HAND_TRACKING_EXTENSION_NAME});
+    const XrInstance instance = runtime.getInstance();
+    const auto xrGetSystem = runtime.getFunction<PFN_xrGetSystem>("xrGetSystem");
+    const auto xrGetD3D11GraphicsRequirementsKHR =
+        runtime.getFunction<PFN_xrGetD3D11GraphicsRequirementsKHR>("xrGetD3D11GraphicsRequirementsKHR");
+    const auto xrCreateSession = runtime.getFunction<PFN_xrCreateSession>("xrCreateSession");
+    const auto xrDestroySession = runtime.getFunction<PFN_xrDestroySession>("xrDestroySession");
+    const auto xrPollEvent = runtime.getFunction<PFN_xrPollEvent>("xrPollEvent");
+    const auto xrBeginSession = runtime.getFunction<PFN_xrBeginSession>("xrBeginSession");
+    const auto xrStringToPath = runtime.getFunction<PFN_xrStringToPath>("xrStringToPath");
+    const auto xrCreateActionSet = runtime.getFunction<PFN_xrCreateActionSet>("xrCreateActionSet");
+    const auto xrCreateAction = runtime.getFunction<PFN_xrCreateAction>("xrCreateAction");
+    const auto xrSuggestInteractionProfileBindings =
+        runtime.getFunction<PFN_xrSuggestInteractionProfileBindings>("xrSuggestInteractionProfileBindings");
+    const auto xrAttachSessionActionSets =
+        runtime.getFunction<PFN_xrAttachSessionActionSets>("xrAttachSessionActionSets");
+    const auto xrCreateReferenceSpace = runtime.getFunction<PFN_xrCreateReferenceSpace>("xrCreateReferenceSpace");
+    const auto xrCreateActionSpace = runtime.getFunction<PFN_xrCreateActionSpace>("xrCreateActionSpace");
+    const auto xrDestroySpace = runtime.getFunction<PFN_xrDestroySpace>("xrDestroySpace");
+    const auto xrLocateSpace = runtime.getFunction<PFN_xrLocateSpace>("xrLocateSpace");
+    const auto xrSyncActions = runtime.getFunction<PFN_xrSyncActions>("xrSyncActions");
+    const auto xrCreateHandTrackerEXT = runtime.getFunction<PFN_xrCreateHandTrackerEXT>("xrCreateHandTrackerEXT");
+    const auto xrLocateHandJointsEXT = runtime.getFunction<PFN_xrLocateHandJointsEXT>("xrLocateHandJointsEXT");
+    const auto xrCreateSwapchain = runtime.getFunction<PFN_xrCreateSwapchain>("xrCreateSwapchain");
+    const auto xrAcquireSwapchainImage = runtime.getFunction<PFN_xrAcquireSwapchainImage>("xrAcquireSwapchainImage");
+    const auto xrWaitSwapchainImage = runtime.getFunction<PFN_xrWaitSwapchainImage>("xrWaitSwapchainImage");
+    const auto xrReleaseSwapchainImage = runtime.getFunction<PFN_xrReleaseSwapchainImage>("xrReleaseSwapchainImage");
+    const auto xrWaitFrame = runtime.getFunction<PFN_xrWaitFrame>("xrWaitFrame");
+    const auto xrBeginFrame = runtime.getFunction<PFN_xrBeginFrame>("xrBeginFrame");
+    const auto xrEndFrame = runtime.getFunction<PFN_xrEndFrame>("xrEndFrame");
+
+    XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+    systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+    XrSystemId systemId = XR_NULL_SYSTEM_ID;
+    if (XR_FAILED(xrGetSystem(instance, &systemInfo, &systemId))) {
+        SKIP("No headset");
+    }
+
+    XrGraphicsRequirementsD3D11KHR requirements{XR_TYPE_GRAPHICS_REQUIREMENTS_D3D11_KHR};
+    CHECK_XRCMD(xrGetD3D11GraphicsRequirementsKHR(instance, systemId, &requirements));
+    const ComPtr<ID3D11Device> device = createDevice(requirements);
+
+    XrGraphicsBindingD3D11KHR graphicsBinding{XR_TYPE_GRAPHICS_BINDING_D3D11_KHR};
+    graphicsBinding.device = device.Get();
+    XrSessionCreateInfo sessionInfo{XR_TYPE_SESSION_CREATE_INFO, &graphicsBinding};
+    sessionInfo.systemId = systemId;
+    XrSession session = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateSession(instance, &sessionInfo, &session));
+    auto scopeGuard = MakeScopeGuard([&] { xrDestroySession(session); });
+
+    // The actions of a simple game, bound to the controllers.
+    XrPath handPaths[2];
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/left", &handPaths[0]));
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/right", &handPaths[1]));
+
+    XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+    strcpy_s(actionSetInfo.actionSetName, "gameplay");
+    strcpy_s(actionSetInfo.localizedActionSetName, "Gameplay");
+    XrActionSet actionSet = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateActionSet(instance, &actionSetInfo, &actionSet));
+
+    XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+    actionInfo.countSubactionPaths = static_cast<uint32_t>(std::size(handPaths));
+    actionInfo.subactionPaths = handPaths;
+    strcpy_s(actionInfo.actionName, "grip_pose");
+    strcpy_s(actionInfo.localizedActionName, "Grip Pose");
+    actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+    XrAction poseAction = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateAction(actionSet, &actionInfo, &poseAction));
+    strcpy_s(actionInfo.actionName, "select");
+    strcpy_s(actionInfo.localizedActionName, "Select");
+    actionInfo.actionType = XR_ACTION_TYPE_BOOLEAN_INPUT;
+    XrAction selectAction = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateAction(actionSet, &actionInfo, &selectAction));
+
+    XrActionSuggestedBinding bindings[4]{{poseAction}, {poseAction}, {selectAction}, {selectAction}};
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/left/input/grip/pose", &bindings[0].binding));
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/right/input/grip/pose", &bindings[1].binding));
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/left/input/select/click", &bindings[2].binding));
+    CHECK_XRCMD(xrStringToPath(instance, "/user/hand/right/input/select/click", &bindings[3].binding));
+    XrInteractionProfileSuggestedBinding suggestedBindings{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+    CHECK_XRCMD(xrStringToPath(
+        instance, "/interaction_profiles/khr/simple_controller", &suggestedBindings.interactionProfile));
+    suggestedBindings.countSuggestedBindings = static_cast<uint32_t>(std::size(bindings));
+    suggestedBindings.suggestedBindings = bindings;
+    CHECK_XRCMD(xrSuggestInteractionProfileBindings(instance, &suggestedBindings));
+
+    XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+    attachInfo.countActionSets = 1;
+    attachInfo.actionSets = &actionSet;
+    CHECK_XRCMD(xrAttachSessionActionSets(session, &attachInfo));
+
+    XrReferenceSpaceCreateInfo referenceSpaceInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+    referenceSpaceInfo.poseInReferenceSpace = Pose::Identity();
+    referenceSpaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+    XrSpace localSpace = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateReferenceSpace(session, &referenceSpaceInfo, &localSpace));
+    referenceSpaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+    XrSpace viewSpace = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateReferenceSpace(session, &referenceSpaceInfo, &viewSpace));
+
+    XrActionSpaceCreateInfo actionSpaceInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+    actionSpaceInfo.action = poseAction;
+    actionSpaceInfo.poseInActionSpace = Pose::Identity();
+    XrSpace gripSpaces[2];
+    for (uint32_t side = 0; side < 2; side++) {
+        actionSpaceInfo.subactionPath = handPaths[side];
+        CHECK_XRCMD(xrCreateActionSpace(session, &actionSpaceInfo, &gripSpaces[side]));
+    }
+
+    XrHandTrackerCreateInfoEXT handTrackerInfo{XR_TYPE_HAND_TRACKER_CREATE_INFO_EXT};
+    handTrackerInfo.hand = XR_HAND_LEFT_EXT;
+    handTrackerInfo.handJointSet = XR_HAND_JOINT_SET_DEFAULT_EXT;
+    XrHandTrackerEXT handTracker = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateHandTrackerEXT(session, &handTrackerInfo, &handTracker));
+
+    XrSwapchainCreateInfo swapchainInfo{XR_TYPE_SWAPCHAIN_CREATE_INFO};
+    swapchainInfo.usageFlags = XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT | XR_SWAPCHAIN_USAGE_SAMPLED_BIT;
+    swapchainInfo.format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    swapchainInfo.sampleCount = 1;
+    swapchainInfo.width = swapchainInfo.height = 256;
+    swapchainInfo.faceCount = swapchainInfo.arraySize = swapchainInfo.mipCount = 1;
+    XrSwapchain swapchain = XR_NULL_HANDLE;
+    CHECK_XRCMD(xrCreateSwapchain(session, &swapchainInfo, &swapchain));
+
+    // Wait for the session to be ready.
+    XrSessionState sessionState = XR_SESSION_STATE_UNKNOWN;
+    const auto start = std::chrono::steady_clock::now();
+    while (sessionState != XR_SESSION_STATE_READY) {
+        if (std::chrono::steady_clock::now() - start > 5s) {
+            SKIP("The session did not become ready");
+        }
+        XrEventDataBuffer event{XR_TYPE_EVENT_DATA_BUFFER};
+        CHECK_XRCMD(xrPollEvent(instance, &event));
+        if (event.type == XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED) {
+            sessionState = reinterpret_cast<const XrEventDataSessionStateChanged*>(&event)->state;
+        } else {
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+    XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+    beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+    CHECK_XRCMD(xrBeginSession(session, &beginInfo));
+
+    // One frame, with a quad layer in each kind of space. xrEndFrame() looks up the spaces of the layers.
+    std::atomic<XrTime> displayTime{0};
+    const auto renderFrame = [&] {
+        XrFrameState frameState{XR_TYPE_FRAME_STATE};
+        CHECK_XRCMD(xrWaitFrame(session, nullptr, &frameState));
+        CHECK_XRCMD(xrBeginFrame(session, nullptr));
+
+        uint32_t imageIndex;
+        CHECK_XRCMD(xrAcquireSwapchainImage(swapchain, nullptr, &imageIndex));
+        XrSwapchainImageWaitInfo waitInfo{XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO};
+        waitInfo.timeout = XR_INFINITE_DURATION;
+        CHECK_XRCMD(xrWaitSwapchainImage(swapchain, &waitInfo));
+        CHECK_XRCMD(xrReleaseSwapchainImage(swapchain, nullptr));
+
+        XrCompositionLayerQuad quads[4];
+        const XrSpace layerSpaces[] = {localSpace, viewSpace, gripSpaces[0], gripSpaces[1]};
+        std::vector<const XrCompositionLayerBaseHeader*> layers;
+        for (uint32_t i = 0; i < std::size(quads); i++) {
+            quads[i] = {XR_TYPE_COMPOSITION_LAYER_QUAD};
+            quads[i].space = layerSpaces[i];
+            quads[i].eyeVisibility = XR_EYE_VISIBILITY_BOTH;
+            quads[i].subImage.swapchain = swapchain;
+            quads[i].subImage.imageRect.extent = {256, 256};
+            quads[i].pose = Pose::Translation({0, 0, -1});
+            quads[i].size = {0.1f, 0.1f};
+            layers.push_back(reinterpret_cast<const XrCompositionLayerBaseHeader*>(&quads[i]));
+        }
+        XrFrameEndInfo frameEndInfo{XR_TYPE_FRAME_END_INFO};
+        frameEndInfo.displayTime = frameState.predictedDisplayTime;
+        frameEndInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+        frameEndInfo.layerCount = static_cast<uint32_t>(layers.size());
+        frameEndInfo.layers = layers.data();
+        CHECK_XRCMD(xrEndFrame(session, &frameEndInfo));
+
+        displayTime = frameState.predictedDisplayTime;
+        return true;
+    };
+    const auto locateSpace = [&](XrSpace space) {
+        XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+        CHECK_XRCMD(xrLocateSpace(space, localSpace, displayTime, &location));
+        return true;
+    };
+
+    // The first frame gives a valid time to locate the spaces at.
+    renderFrame();
+
+    // Without other threads, for reference.
+    const double uncontendedTime = test::measure(10000, [&](size_t i) { locateSpace(gripSpaces[i % 2]); });
+    test::report("xrLocateSpace(), uncontended", uncontendedTime, "ns");
+
+    constexpr auto Duration = 2s;
+    for (const uint32_t locatingThreads : {1u, 2u, 4u, 8u}) {
+        Workers workers;
+        workers.add("frame", renderFrame);
+        workers.add("sync", [&] {
+            const XrActiveActionSet activeActionSet{actionSet, XR_NULL_PATH};
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = 1;
+            syncInfo.activeActionSets = &activeActionSet;
+            CHECK_XRCMD(xrSyncActions(session, &syncInfo));
+            return true;
+        });
+        workers.add("joints", [&] {
+            XrHandJointsLocateInfoEXT locateInfo{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
+            locateInfo.baseSpace = localSpace;
+            locateInfo.time = displayTime;
+            XrHandJointLocationEXT jointLocations[XR_HAND_JOINT_COUNT_EXT];
+            XrHandJointLocationsEXT locations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
+            locations.jointCount = XR_HAND_JOINT_COUNT_EXT;
+            locations.jointLocations = jointLocations;
+            CHECK_XRCMD(xrLocateHandJointsEXT(handTracker, &locateInfo, &locations));
+            return true;
+        });
+        // The creation and destruction of spaces take the exclusive side of the locks.
+        workers.add("churn", [&] {
+            XrSpace space = XR_NULL_HANDLE;
+            CHECK_XRCMD(xrCreateActionSpace(session, &actionSpaceInfo, &space));
+            CHECK_XRCMD(xrDestroySpace(space));
+            std::this_thread::sleep_for(1ms);
+            return true;
+        });
+        for (uint32_t i = 0; i < locatingThreads; i++) {
+            const XrSpace space = i % 3 == 2 ? viewSpace : gripSpaces[i % 3];
+            workers.add(fmt::format("locate{}", i), [&, space] { return locateSpace(space); });
+        }
+
+        workers.run(Duration);
+        const uint64_t frames = workers.getIterations("frame");
+        const uint64_t locates = workers.getIterations("locate");
+        workers.stop();
+        if (const std::string error = workers.getError(); !error.empty()) {
+            throw test::Failure{error};
+        }
+
+        const double duration = std::chrono::duration<double, std::nano>(Duration).count();
+        CHECK(frames > 0);
+        CHECK(locates > 0);
+        test::report(fmt::format("xrLocateSpace(), {} threads and a frame loop", locatingThreads),
+                     duration * locatingThreads / locates,
+                     "ns");
+        test::report(fmt::format("Frame time, {} locating threads", locatingThreads), duration / frames / 1e3, "us");
+    }
+}
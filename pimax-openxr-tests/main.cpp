@@ -0,0 +1,129 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+namespace pimax_openxr::log {
+    // The runtime defines its trace provider in log.cpp, which depends on the whole runtime.
+    // {5d3df04d-1eab-423c-8204-1585c7335c37}
+    TRACELOGGING_DEFINE_PROVIDER(g_traceProvider,
+                                 "PimaxOpenXRTests",
+                                 (0x5d3df04d, 0x1eab, 0x423c, 0x82, 0x04, 0x15, 0x85, 0xc7, 0x33, 0x5c, 0x37));
+} // namespace pimax_openxr::log
+
+namespace pimax_openxr::test {
+
+    namespace {
+        std::filesystem::path g_dataDirectory;
+    } // namespace
+
+    std::vector<TestCase>& getTestCases() {
+        static std::vector<TestCase> testCases;
+        return testCases;
+    }
+
+    namespace detail {
+        void check(bool condition, const char* expression, const char* fileAndLine) {
+            if (!condition) {
+                throw Failure{fmt::format("{}: CHECK({})", fileAndLine, expression)};
+            }
+        }
+
+        void checkNear(
+            double actual, double expected, double tolerance, const char* expressions, const char* fileAndLine) {
+            if (!(std::abs(actual - expected) <= tolerance)) {
+                throw Failure{fmt::format("{}: CHECK_NEAR({}): {} vs {} (tolerance {})",
+                                          fileAndLine,
+                                          expressions,
+                                          actual,
+                                          expected,
+                                          tolerance)};
+            }
+        }
+
+        void useValue(const volatile void* value) {
+            static const volatile void* sink;
+            sink = value;
+        }
+    } // namespace detail
+
+    const std::filesystem::path& getDataDirectory() {
+        return g_dataDirectory;
+    }
+
+    void report(const std::string& name, double value, const char* unit) {
+        std::cout << fmt::format("    {:<48} {:>12.1f} {}", name, value, unit) << std::endl;
+    }
+
+} // namespace pimax_openxr::test
+
+// Usage: pimax-openxr-tests [--benchmark] [filter]
+// Run the test cases (or the benchmarks) whose name contains the filter.
+int main(int argc, char** argv) {
+    using namespace pimax_openxr::test;
+
+    g_dataDirectory = std::filesystem::absolute(argv[0]).parent_path();
+
+    bool runBenchmarks = false;
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--benchmark") {
+            runBenchmarks = true;
+        } else {
+            filter = arg;
+        }
+    }
+
+    TraceLoggingRegister(pimax_openxr::log::g_traceProvider);
+
+    uint32_t passed = 0, failed = 0, skipped = 0;
+    for (const TestCase& testCase : getTestCases()) {
+        if (testCase.isBenchmark != runBenchmarks ||
+            std::string_view(testCase.name).find(filter) == std::string_view::npos) {
+            continue;
+        }
+
+        std::cout << testCase.name << std::endl;
+        try {
+            testCase.function();
+            passed++;
+        } catch (const Failure& failure) {
+            std::cout << "    FAILED: " << failure.message << std::endl;
+            failed++;
+        } catch (const Skipped& skip) {
+            std::cout << "    SKIPPED: " << skip.reason << std::endl;
+            skipped++;
+        } catch (const std::exception& exception) {
+            std::cout << "    FAILED: " << exception.what() << std::endl;
+            failed++;
+        }
+    }
+
+    std::cout << fmt::format("{} passed, {} failed, {} skipped", passed, failed, skipped) << std::endl;
+
+    TraceLoggingUnregister(pimax_openxr::log::g_traceProvider);
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,208 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <random>
+
+#include <mappings.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using namespace pimax_openxr::mappings;
+
+    // The validation of the path strings before the PathAutomaton replaced it.
+    // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#well-formed-path-strings
+    bool validateString(const std::string_view& str) {
+        for (const auto c : str) {
+            if (!islower(c) && !isdigit(c) && c != '-' && c != '_' && c != '.') {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool validatePath(std::string path) {
+        if (path.size() < 2 || path[0] != '/' || path[path.size() - 1] == '/') {
+            return false;
+        }
+
+        path.erase(0, 1);
+        size_t pos = 0;
+        while (!path.empty()) {
+            pos = path.find('/');
+            const auto token = pos != std::string::npos ? path.substr(0, pos) : path;
+            if (token.empty() || !validateString(token)) {
+                return false;
+            }
+            bool notADot = false;
+            for (const auto c : token) {
+                if (c != '.') {
+                    notADot = true;
+                }
+            }
+            if (!notADot) {
+                return false;
+            }
+            path.erase(0, std::min(token.size() + 1, path.size()));
+        }
+        return true;
+    }
+
+    // Recognize a binding path by comparing it with every top-level user path and component, like the per-profile
+    // validators used to.
+    PathMatch matchByComparison(const std::string& path) {
+        PathMatch result;
+        result.isWellFormed = validatePath(path);
+        if (!result.isWellFormed) {
+            return result;
+        }
+        for (size_t user = 0; user < k_userPaths.size(); user++) {
+            if (path.compare(0, k_userPaths[user].size(), k_userPaths[user]) != 0) {
+                continue;
+            }
+            const std::string_view component = std::string_view(path).substr(k_userPaths[user].size());
+            for (size_t i = 0; i < k_componentCount; i++) {
+                if (component == k_componentPaths[i]) {
+                    result.user = static_cast<UserPath>(user);
+                    result.component = static_cast<Component>(i);
+                }
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::string> getBindingPaths() {
+        std::vector<std::string> paths;
+        for (const std::string_view user : k_userPaths) {
+            for (const std::string_view component : k_componentPaths) {
+                paths.push_back(std::string(user) + std::string(component));
+            }
+        }
+        return paths;
+    }
+
+    // Paths assembled from the pieces of the binding paths, with the odd invalid character or dot element.
+    std::string makeRandomPath(std::mt19937& random) {
+        static const std::vector<std::string> pieces = [] {
+            std::vector<std::string> pieces = {"/",       "/user",  "/hand",  "/left",  "/right",   "/head",  "/x",
+                                               "/input",  "/output", "/click", "/value", "/.",       "/..",    ".",
+                                               "a",       "Z",      "//",     "-",      "_",        "/menu",  "/a"};
+            pieces.insert(pieces.end(), k_componentPaths.cbegin(), k_componentPaths.cend());
+            pieces.insert(pieces.end(), k_userPaths.cbegin(), k_userPaths.cend());
+            return pieces;
+        }();
+        constexpr std::string_view k_mutations = "abz/._-A \x80";
+
+        std::string path;
+        const size_t count = random() % 5;
+        for (size_t i = 0; i < count; i++) {
+            path += pieces[random() % pieces.size()];
+        }
+        if (random() % 10 == 0 && !path.empty()) {
+            path[random() % path.size()] = k_mutations[random() % k_mutations.size()];
+        }
+        return path;
+    }
+
+    bool isSameMatch(const PathMatch& a, const PathMatch& b) {
+        return a.isWellFormed == b.isWellFormed && a.user == b.user && a.component == b.component;
+    }
+
+} // namespace
+
+TEST_CASE(PathAutomaton_BindingPaths) {
+    const PathAutomaton& automaton = getPathAutomaton();
+    for (size_t user = 0; user < k_userPaths.size(); user++) {
+        for (size_t i = 0; i < k_componentCount; i++) {
+            const std::string path = std::string(k_userPaths[user]) + std::string(k_componentPaths[i]);
+            const PathMatch match = automaton.match(path);
+            CHECK(match.isWellFormed);
+            CHECK(match.user == static_cast<UserPath>(user));
+            CHECK(match.component == static_cast<Component>(i));
+
+            // Neither a longer nor a truncated path is a binding path.
+            CHECK(automaton.match(path + "x").component == Component::Count);
+            CHECK(isSameMatch(automaton.match(path.substr(0, path.size() - 1)),
+                              matchByComparison(path.substr(0, path.size() - 1))));
+        }
+
+        // A top-level user path alone.
+        const PathMatch match = automaton.match(k_userPaths[user]);
+        CHECK(match.isWellFormed);
+        CHECK(match.component == Component::Count);
+    }
+}
+
+TEST_CASE(PathAutomaton_Fuzz) {
+    const PathAutomaton& automaton = getPathAutomaton();
+    std::mt19937 random(42);
+    size_t bindingPaths = 0;
+    for (int i = 0; i < 500000; i++) {
+        const std::string path = makeRandomPath(random);
+        const PathMatch match = automaton.match(path);
+        const PathMatch expected = matchByComparison(path);
+        if (!isSameMatch(match, expected) || isWellFormedPath(path) != expected.isWellFormed) {
+            throw test::Failure{fmt::format("Mismatch for '{}'", path)};
+        }
+        if (match.component != Component::Count) {
+            bindingPaths++;
+        }
+    }
+
+    // The fuzzer must reach the binding paths, not only the syntax errors.
+    CHECK(bindingPaths > 1000);
+}
+
+BENCHMARK(PathAutomaton_Match) {
+    const PathAutomaton& automaton = getPathAutomaton();
+    const std::vector<std::string> bindingPaths = getBindingPaths();
+    std::mt19937 random(42);
+    std::vector<std::string> randomPaths;
+    for (int i = 0; i < 10000; i++) {
+        randomPaths.push_back(makeRandomPath(random));
+    }
+
+    // The matches are summed up, so that they cannot be optimized out.
+    const auto getChecksum = [](const PathMatch& match) {
+        return static_cast<size_t>(match.isWellFormed) + static_cast<size_t>(match.user) +
+               static_cast<size_t>(match.component);
+    };
+    const auto compare = [&](const char* name, const std::vector<std::string>& paths) {
+        const size_t iterations = 20 * paths.size();
+        size_t automatonChecksum = 0;
+        const double automatonTime = test::measure(iterations, [&](size_t i) {
+            automatonChecksum += getChecksum(automaton.match(paths[i % paths.size()]));
+        });
+        size_t comparisonChecksum = 0;
+        const double comparisonTime = test::measure(iterations, [&](size_t i) {
+            comparisonChecksum += getChecksum(matchByComparison(paths[i % paths.size()]));
+        });
+        CHECK(automatonChecksum == comparisonChecksum);
+        test::report(fmt::format("PathAutomaton::match(), {}", name), automatonTime, "ns");
+        test::report(fmt::format("validatePath() and comparisons, {}", name), comparisonTime, "ns");
+    };
+    compare("binding paths", bindingPaths);
+    compare("random paths", randomPaths);
+}
@@ -0,0 +1,211 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <pose_extrapolation.h>
+
+namespace {
+
+    using namespace pimax_openxr::extrapolation;
+
+    constexpr XrDuration k_millisecond = 1'000'000;
+
+    // The controllers give up extrapolating after this long, see OpenXrRuntime::k_controllerMaxDropout.
+    constexpr XrDuration k_controllerMaxDropout = 250 * k_millisecond;
+
+    XrQuaternionf axisAngle(const XrVector3f& axis, float angle) {
+        const float s = std::sin(angle / 2);
+        return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle / 2)};
+    }
+
+    Sample makeSample(XrTime time,
+                      const XrPosef& pose,
+                      const XrVector3f& angularVelocity,
+                      const XrVector3f& linearVelocity) {
+        Sample sample;
+        sample.time = time;
+        sample.pose = pose;
+        sample.angularVelocity = angularVelocity;
+        sample.linearVelocity = linearVelocity;
+        sample.hasOrientation = sample.hasPosition = true;
+        sample.hasAngularVelocity = sample.hasLinearVelocity = true;
+        return sample;
+    }
+
+    void checkPosition(const XrVector3f& actual, const XrVector3f& expected) {
+        CHECK_NEAR(actual.x, expected.x, 1e-5);
+        CHECK_NEAR(actual.y, expected.y, 1e-5);
+        CHECK_NEAR(actual.z, expected.z, 1e-5);
+    }
+
+} // namespace
+
+TEST_CASE(PoseExtrapolation_ConstantVelocityIntegration) {
+    const XrPosef pose{axisAngle({1, 0, 0}, 0.3f), {1, 2, 3}};
+    const XrVector3f angularVelocity{0, 2, 0};
+    const XrVector3f linearVelocity{0.5f, -1, 0.25f};
+
+    // The rotation is applied in the reference space, on top of the initial orientation.
+    const XrPosef result = integrate(pose, angularVelocity, linearVelocity, 0.25);
+    const XrQuaternionf delta = axisAngle({0, 1, 0}, 0.5f);
+    const XrQuaternionf& q = pose.orientation;
+    const XrQuaternionf expected{delta.w * q.x + delta.x * q.w + delta.y * q.z - delta.z * q.y,
+                                 delta.w * q.y - delta.x * q.z + delta.y * q.w + delta.z * q.x,
+                                 delta.w * q.z + delta.x * q.y - delta.y * q.x + delta.z * q.w,
+                                 delta.w * q.w - delta.x * q.x - delta.y * q.y - delta.z * q.z};
+    CHECK_NEAR(angleBetween(result.orientation, expected), 0, 1e-3);
+    checkPosition(result.position, {1.125f, 1.75f, 3.0625f});
+
+    // Integrating twice over half the duration is the same as integrating once.
+    const XrPosef half = integrate(pose, angularVelocity, linearVelocity, 0.125);
+    const XrPosef twice = integrate(half, angularVelocity, linearVelocity, 0.125);
+    CHECK_NEAR(angleBetween(twice.orientation, result.orientation), 0, 1e-3);
+    checkPosition(twice.position, result.position);
+
+    // The extrapolator integrates the velocities reported with the latest sample.
+    DeviceExtrapolator extrapolator;
+    extrapolator.addSample(makeSample(1000 * k_millisecond, pose, angularVelocity, linearVelocity));
+    XrQuaternionf orientation;
+    XrVector3f position;
+    CHECK(extrapolator.extrapolateOrientation(1020 * k_millisecond, orientation));
+    CHECK(extrapolator.extrapolatePosition(1020 * k_millisecond, position));
+    const XrPosef integrated = integrate(pose, angularVelocity, linearVelocity, 0.02);
+    CHECK_NEAR(angleBetween(orientation, integrated.orientation), 0, 1e-3);
+    checkPosition(position, integrated.position);
+}
+
+TEST_CASE(PoseExtrapolation_EstimatedVelocities) {
+    // Without reported velocities, they are estimated from the two latest samples.
+    DeviceExtrapolator extrapolator;
+    Sample sample;
+    sample.hasOrientation = sample.hasPosition = true;
+    sample.time = 1000 * k_millisecond;
+    sample.pose = {axisAngle({0, 0, 1}, 0.f), {0, 0, 0}};
+    extrapolator.addSample(sample);
+    sample.time = 1010 * k_millisecond;
+    sample.pose = {axisAngle({0, 0, 1}, 0.01f), {0.01f, 0, 0}};
+    extrapolator.addSample(sample);
+
+    XrQuaternionf orientation;
+    XrVector3f position;
+    CHECK(extrapolator.extrapolateOrientation(1030 * k_millisecond, orientation));
+    CHECK(extrapolator.extrapolatePosition(1030 * k_millisecond, position));
+    CHECK_NEAR(angleBetween(orientation, axisAngle({0, 0, 1}, 0.03f)), 0, 1e-3);
+    checkPosition(position, {0.03f, 0, 0});
+}
+
+TEST_CASE(PoseExtrapolation_ShortestPathDelta) {
+    // q and -q are the same orientation: the velocity must not go the long way around.
+    const XrQuaternionf from = axisAngle({1, 0, 0}, 0.f);
+    const XrQuaternionf to = axisAngle({1, 0, 0}, 0.1f);
+    const XrQuaternionf negatedTo{-to.x, -to.y, -to.z, -to.w};
+    for (const XrQuaternionf& target : {to, negatedTo}) {
+        const XrVector3f velocity = angularVelocityBetween(from, target, 0.1);
+        CHECK_NEAR(velocity.x, 1, 1e-3);
+        CHECK_NEAR(velocity.y, 0, 1e-5);
+        CHECK_NEAR(velocity.z, 0, 1e-5);
+    }
+
+    // Crossing the half-turn: from 170 to -170 degrees is a 20 degree rotation, in the positive direction.
+    const XrVector3f velocity = angularVelocityBetween(
+        axisAngle({0, 0, 1}, PVR::DegreeToRad(170.f)), axisAngle({0, 0, 1}, PVR::DegreeToRad(-170.f)), 1);
+    CHECK_NEAR(velocity.x, 0, 1e-5);
+    CHECK_NEAR(velocity.y, 0, 1e-5);
+    CHECK_NEAR(velocity.z, PVR::DegreeToRad(20.f), 1e-3);
+
+    CHECK_NEAR(angleBetween(to, negatedTo), 0, 1e-3);
+}
+
+TEST_CASE(PoseExtrapolation_HorizonClamping) {
+    const XrPosef pose{axisAngle({0, 1, 0}, 0.f), {0, 1.5f, 0}};
+    const XrVector3f angularVelocity{0, 1, 0};
+    const XrVector3f linearVelocity{1, 0, 0};
+    const XrTime sampleTime = 1000 * k_millisecond;
+
+    DeviceExtrapolator extrapolator;
+    extrapolator.addSample(makeSample(sampleTime, pose, angularVelocity, linearVelocity));
+
+    const double horizon = DeviceExtrapolator::k_maxHorizon / 1e9;
+    const XrPosef atHorizon = integrate(pose, angularVelocity, linearVelocity, horizon);
+    const XrPosef beforeHorizon = integrate(pose, angularVelocity, linearVelocity, -horizon);
+
+    XrQuaternionf orientation;
+    XrVector3f position;
+
+    // Within the horizon, the velocities are integrated.
+    CHECK(extrapolator.extrapolatePosition(sampleTime + DeviceExtrapolator::k_maxHorizon / 2, position));
+    checkPosition(position, {static_cast<float>(horizon / 2), 1.5f, 0});
+    CHECK(extrapolator.getStatistics().clampedExtrapolations == 0);
+
+    // Beyond the horizon (in both directions), the pose is held.
+    for (const XrDuration offset : {DeviceExtrapolator::k_maxHorizon * 4, XrDuration{1'000'000'000}}) {
+        CHECK(extrapolator.extrapolateOrientation(sampleTime + offset, orientation));
+        CHECK(extrapolator.extrapolatePosition(sampleTime + offset, position));
+        CHECK_NEAR(angleBetween(orientation, atHorizon.orientation), 0, 1e-3);
+        checkPosition(position, atHorizon.position);
+    }
+    CHECK(extrapolator.extrapolatePosition(sampleTime - DeviceExtrapolator::k_maxHorizon * 4, position));
+    checkPosition(position, beforeHorizon.position);
+
+    CHECK(extrapolator.getStatistics().extrapolations == 6);
+    CHECK(extrapolator.getStatistics().clampedExtrapolations == 5);
+}
+
+TEST_CASE(PoseExtrapolation_ControllerDropout) {
+    const XrPosef pose{axisAngle({0, 1, 0}, 0.f), {0, 1, 0}};
+    const XrTime sampleTime = 1000 * k_millisecond;
+
+    // The headset never gives up, the controllers do after a while.
+    DeviceExtrapolator hmd(0);
+    DeviceExtrapolator controller(k_controllerMaxDropout);
+    hmd.addSample(makeSample(sampleTime, pose, {0, 1, 0}, {0, 0, 1}));
+    controller.addSample(makeSample(sampleTime, pose, {0, 1, 0}, {0, 0, 1}));
+
+    XrQuaternionf orientation;
+    XrVector3f position;
+    for (const XrTime time : {sampleTime + 10 * k_millisecond, sampleTime + k_controllerMaxDropout}) {
+        CHECK(hmd.extrapolateOrientation(time, orientation));
+        CHECK(hmd.extrapolatePosition(time, position));
+        CHECK(controller.extrapolateOrientation(time, orientation));
+        CHECK(controller.extrapolatePosition(time, position));
+    }
+
+    for (const XrTime time : {sampleTime + k_controllerMaxDropout + 1, sampleTime + 10'000 * k_millisecond}) {
+        CHECK(hmd.extrapolateOrientation(time, orientation));
+        CHECK(hmd.extrapolatePosition(time, position));
+        CHECK(!controller.extrapolateOrientation(time, orientation));
+        CHECK(!controller.extrapolatePosition(time, position));
+    }
+
+    // A new tracked sample resumes the extrapolation.
+    const XrTime resumeTime = sampleTime + 10'000 * k_millisecond;
+    controller.addSample(makeSample(resumeTime, pose, {0, 0, 0}, {0, 0, 0}));
+    CHECK(controller.extrapolatePosition(resumeTime + 10 * k_millisecond, position));
+    checkPosition(position, pose.position);
+
+    // Without any sample, there is nothing to extrapolate from.
+    controller.clearHistory();
+    CHECK(!controller.extrapolatePosition(resumeTime, position));
+}
@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+#include "runtime_instance.h"
+
+namespace {
+
+    using namespace pimax_openxr;
+
+    // Create action sets and actions like the ones of a game manifest: a mix of types, for both hands.
+    class ManifestBuilder {
+      public:
+        ManifestBuilder(const test::RuntimeInstance& runtime) : m_instance(runtime.getInstance()) {
+            m_xrCreateActionSet = runtime.getFunction<PFN_xrCreateActionSet>("xrCreateActionSet");
+            m_xrCreateAction = runtime.getFunction<PFN_xrCreateAction>("xrCreateAction");
+
+            const auto xrStringToPath = runtime.getFunction<PFN_xrStringToPath>("xrStringToPath");
+            CHECK_XRCMD(xrStringToPath(m_instance, "/user/hand/left", &m_subactionPaths[0]));
+            CHECK_XRCMD(xrStringToPath(m_instance, "/user/hand/right", &m_subactionPaths[1]));
+        }
+
+        XrActionSet createActionSet(size_t index) const {
+            XrActionSetCreateInfo createInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+            fmt::format_to_n(createInfo.actionSetName, sizeof(createInfo.actionSetName) - 1, "set_{}", index);
+            fmt::format_to_n(
+                createInfo.localizedActionSetName, sizeof(createInfo.localizedActionSetName) - 1, "Set {}", index);
+            XrActionSet actionSet = XR_NULL_HANDLE;
+            CHECK_XRCMD(m_xrCreateActionSet(m_instance, &createInfo, &actionSet));
+            return actionSet;
+        }
+
+        XrAction createAction(XrActionSet actionSet, size_t index) const {
+            static const XrActionType types[] = {XR_ACTION_TYPE_BOOLEAN_INPUT,
+                                                 XR_ACTION_TYPE_FLOAT_INPUT,
+                                                 XR_ACTION_TYPE_VECTOR2F_INPUT,
+                                                 XR_ACTION_TYPE_POSE_INPUT,
+                                                 XR_ACTION_TYPE_VIBRATION_OUTPUT};
+
+            XrActionCreateInfo createInfo{XR_TYPE_ACTION_CREATE_INFO};
+            fmt::format_to_n(createInfo.actionName, sizeof(createInfo.actionName) - 1, "action_{}", index);
+            fmt::format_to_n(
+                createInfo.localizedActionName, sizeof(createInfo.localizedActionName) - 1, "Action {}", index);
+            createInfo.actionType = types[index % std::size(types)];
+            createInfo.countSubactionPaths = static_cast<uint32_t>(std::size(m_subactionPaths));
+            createInfo.subactionPaths = m_subactionPaths;
+            XrAction action = XR_NULL_HANDLE;
+            CHECK_XRCMD(m_xrCreateAction(actionSet, &createInfo, &action));
+            return action;
+        }
+
+      private:
+        const XrInstance m_instance;
+        PFN_xrCreateActionSet m_xrCreateActionSet{nullptr};
+        PFN_xrCreateAction m_xrCreateAction{nullptr};
+        XrPath m_subactionPaths[2]{XR_NULL_PATH, XR_NULL_PATH};
+    };
+
+} // namespace
+
+BENCHMARK(Runtime_StringToPath) {
+    test::RuntimeInstance runtime;
+    const auto xrStringToPath = runtime.getFunction<PFN_xrStringToPath>("xrStringToPath");
+    const auto xrPathToString = runtime.getFunction<PFN_xrPathToString>("xrPathToString");
+
+    constexpr size_t PathCount = 10000;
+    constexpr size_t BatchSize = 1000;
+    std::vector<std::string> pathStrings;
+    for (size_t i = 0; i < PathCount; i++) {
+        pathStrings.push_back(fmt::format("/user/benchmark/set_{}/input/component_{}/value", i / 100, i));
+    }
+
+    // Intern the paths by batches, to see whether the cost of a new path grows with the size of the table.
+    std::vector<XrPath> paths(PathCount, XR_NULL_PATH);
+    for (size_t batch = 0; batch < PathCount / BatchSize; batch++) {
+        const double time = test::measure(BatchSize, [&](size_t i) {
+            const size_t index = batch * BatchSize + i;
+            CHECK_XRCMD(xrStringToPath(runtime.getInstance(), pathStrings[index].c_str(), &paths[index]));
+        });
+        if (batch == 0 || batch == PathCount / BatchSize - 1) {
+            test::report(
+                fmt::format("xrStringToPath(), new paths {}-{}", batch * BatchSize, (batch + 1) * BatchSize - 1),
+                time,
+                "ns");
+        }
+    }
+
+    // Look up the paths that are already interned.
+    size_t mismatches = 0;
+    const double lookupTime = test::measure(PathCount, [&](size_t i) {
+        XrPath path = XR_NULL_PATH;
+        CHECK_XRCMD(xrStringToPath(runtime.getInstance(), pathStrings[i].c_str(), &path));
+        mismatches += path != paths[i];
+    });
+    CHECK(mismatches == 0);
+    test::report(fmt::format("xrStringToPath(), existing path of {}", PathCount), lookupTime, "ns");
+
+    const double reverseTime = test::measure(PathCount, [&](size_t i) {
+        char buffer[XR_MAX_PATH_LENGTH];
+        uint32_t count = 0;
+        CHECK_XRCMD(xrPathToString(runtime.getInstance(), paths[i], sizeof(buffer), &count, buffer));
+        mismatches += pathStrings[i] != buffer;
+    });
+    CHECK(mismatches == 0);
+    test::report(fmt::format("xrPathToString(), path of {}", PathCount), reverseTime, "ns");
+}
+
+BENCHMARK(Runtime_CreateManifest) {
+    test::RuntimeInstance runtime;
+    const auto xrDestroyAction = runtime.getFunction<PFN_xrDestroyAction>("xrDestroyAction");
+    const auto xrDestroyActionSet = runtime.getFunction<PFN_xrDestroyActionSet>("xrDestroyActionSet");
+
+    // A single action set with many actions, created by batches, to see whether the cost of the duplicate names
+    // detection grows with the number of actions in the set.
+    constexpr size_t ActionCount = 2048;
+    constexpr size_t BatchSize = 256;
+    const ManifestBuilder manifest(runtime);
+    const XrActionSet largeActionSet = manifest.createActionSet(0);
+    std::vector<XrAction> actions(ActionCount, XR_NULL_HANDLE);
+    for (size_t batch = 0; batch < ActionCount / BatchSize; batch++) {
+        const double time = test::measure(BatchSize, [&](size_t i) {
+            const size_t index = batch * BatchSize + i;
+            actions[index] = manifest.createAction(largeActionSet, index);
+        });
+        if (batch == 0 || batch == ActionCount / BatchSize - 1) {
+            test::report(
+                fmt::format("xrCreateAction(), actions {}-{} of a set", batch * BatchSize, (batch + 1) * BatchSize - 1),
+                time,
+                "ns");
+        }
+    }
+
+    const double destroyTime =
+        test::measure(ActionCount, [&](size_t i) { CHECK_XRCMD(xrDestroyAction(actions[i])); });
+    test::report(fmt::format("xrDestroyAction(), {} actions", ActionCount), destroyTime, "ns");
+    CHECK_XRCMD(xrDestroyActionSet(largeActionSet));
+
+    // A typical large manifest: many action sets, with a few dozen actions each.
+    constexpr size_t ActionSetCount = 64;
+    constexpr size_t ActionsPerSet = 32;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ActionSetCount; i++) {
+        const XrActionSet actionSet = manifest.createActionSet(1 + i);
+        for (size_t j = 0; j < ActionsPerSet; j++) {
+            manifest.createAction(actionSet, j);
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    test::report(fmt::format("Manifest of {} sets of {} actions", ActionSetCount, ActionsPerSet),
+                 std::chrono::duration<double, std::micro>(elapsed).count(),
+                 "us");
+}
@@ -0,0 +1,101 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+#include "runtime_instance.h"
+
+namespace {
+
+    using namespace pimax_openxr;
+
+    PFN_xrGetInstanceProcAddr loadRuntime() {
+        // The runtime only supports one instance at a time, but it recreates its state upon xrDestroyInstance(), so
+        // the DLL is loaded once for all the benchmarks.
+        static PFN_xrGetInstanceProcAddr xrGetInstanceProcAddr = []() -> PFN_xrGetInstanceProcAddr {
+            const HMODULE module = LoadLibraryW((test::getDataDirectory() / L"pimax-openxr.dll").c_str());
+            if (!module) {
+                return nullptr;
+            }
+
+            const auto xrNegotiateLoaderRuntimeInterface = reinterpret_cast<PFN_xrNegotiateLoaderRuntimeInterface>(
+                GetProcAddress(module, "xrNegotiateLoaderRuntimeInterface"));
+            if (!xrNegotiateLoaderRuntimeInterface) {
+                return nullptr;
+            }
+
+            XrNegotiateLoaderInfo loaderInfo{};
+            loaderInfo.structType = XR_LOADER_INTERFACE_STRUCT_LOADER_INFO;
+            loaderInfo.structVersion = XR_LOADER_INFO_STRUCT_VERSION;
+            loaderInfo.structSize = sizeof(XrNegotiateLoaderInfo);
+            loaderInfo.minInterfaceVersion = XR_CURRENT_LOADER_API_LAYER_VERSION;
+            loaderInfo.maxInterfaceVersion = XR_CURRENT_LOADER_API_LAYER_VERSION;
+            loaderInfo.minApiVersion = XR_CURRENT_API_VERSION;
+            loaderInfo.maxApiVersion = XR_CURRENT_API_VERSION;
+            XrNegotiateRuntimeRequest runtimeRequest{};
+            runtimeRequest.structType = XR_LOADER_INTERFACE_STRUCT_RUNTIME_REQUEST;
+            runtimeRequest.structVersion = XR_RUNTIME_INFO_STRUCT_VERSION;
+            runtimeRequest.structSize = sizeof(XrNegotiateRuntimeRequest);
+            if (XR_FAILED(xrNegotiateLoaderRuntimeInterface(&loaderInfo, &runtimeRequest))) {
+                return nullptr;
+            }
+
+            return runtimeRequest.getInstanceProcAddr;
+        }();
+
+        return xrGetInstanceProcAddr;
+    }
+
+} // namespace
+
+namespace pimax_openxr::test {
+
+    RuntimeInstance::RuntimeInstance(const std::vector<const char*>& extensions) {
+        m_xrGetInstanceProcAddr = loadRuntime();
+        if (!m_xrGetInstanceProcAddr) {
+            SKIP("Cannot load pimax-openxr.dll");
+        }
+
+        PFN_xrCreateInstance xrCreateInstance = nullptr;
+        CHECK_XRCMD(m_xrGetInstanceProcAddr(
+            XR_NULL_HANDLE, "xrCreateInstance", reinterpret_cast<PFN_xrVoidFunction*>(&xrCreateInstance)));
+
+        XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+        strcpy_s(createInfo.applicationInfo.applicationName, "pimax-openxr-tests");
+        createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+        createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        createInfo.enabledExtensionNames = extensions.data();
+
+        // The instance cannot be created without the Pimax software (pvr_initialise() fails).
+        const XrResult result = xrCreateInstance(&createInfo, &m_instance);
+        if (XR_FAILED(result)) {
+            SKIP(fmt::format("Cannot create an instance: {}", xr::ToCString(result)));
+        }
+        m_xrDestroyInstance = getFunction<PFN_xrDestroyInstance>("xrDestroyInstance");
+    }
+
+    RuntimeInstance::~RuntimeInstance() {
+        m_xrDestroyInstance(m_instance);
+    }
+
+} // namespace pimax_openxr::test
@@ -0,0 +1,55 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+namespace pimax_openxr::test {
+
+    // An instance of the runtime, loaded from the DLL deployed next to the test executable and negotiated the same way
+    // as the OpenXR loader does. The benchmarks of the entry points use it, and they are skipped when the runtime
+    // cannot be loaded or when the Pimax software is not installed.
+    class RuntimeInstance {
+      public:
+        explicit RuntimeInstance(const std::vector<const char*>& extensions = {});
+        ~RuntimeInstance();
+
+        RuntimeInstance(const RuntimeInstance&) = delete;
+        RuntimeInstance& operator=(const RuntimeInstance&) = delete;
+
+        XrInstance getInstance() const {
+            return m_instance;
+        }
+
+        template <typename T>
+        T getFunction(const char* name) const {
+            PFN_xrVoidFunction function = nullptr;
+            CHECK_XRCMD(m_xrGetInstanceProcAddr(m_instance, name, &function));
+            return reinterpret_cast<T>(function);
+        }
+
+      private:
+        PFN_xrGetInstanceProcAddr m_xrGetInstanceProcAddr{nullptr};
+        PFN_xrDestroyInstance m_xrDestroyInstance{nullptr};
+        XrInstance m_instance{XR_NULL_HANDLE};
+    };
+
+} // namespace pimax_openxr::test
@@ -0,0 +1,243 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "framework.h"
+
+#include <functional>
+#include <random>
+
+#include <pose_extrapolation.h>
+#include <space_motion.h>
+
+namespace {
+
+    using namespace pimax_openxr;
+    using namespace xr::math;
+
+    constexpr XrSpaceLocationFlags k_trackedFlags =
+        XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+        XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+
+    // A frame spinning at a constant rate around a fixed axis of the origin, and accelerating.
+    struct Trajectory {
+        XrQuaternionf initialOrientation;
+        XrVector3f axis;
+        float angularSpeed;
+        XrVector3f initialPosition;
+        XrVector3f initialVelocity;
+        XrVector3f acceleration;
+
+        XrPosef getPose(double time) const {
+            const float t = static_cast<float>(time);
+            return Pose::MakePose(
+                Quaternion::Multiply(initialOrientation, Quaternion::RotationAxisAngle(axis, angularSpeed * t)),
+                initialPosition + initialVelocity * t + acceleration * (t * t));
+        }
+
+        XrSpaceVelocity getVelocity(double time) const {
+            const float t = static_cast<float>(time);
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            velocity.velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+            velocity.angularVelocity = axis * angularSpeed;
+            velocity.linearVelocity = initialVelocity + acceleration * (2 * t);
+            return velocity;
+        }
+    };
+
+    Trajectory makeRandomTrajectory(std::mt19937& random) {
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+        const auto randomVector = [&](float scale) {
+            return XrVector3f{unit(random) * scale, unit(random) * scale, unit(random) * scale};
+        };
+        const auto randomAxis = [&]() {
+            const XrVector3f v = randomVector(1.f);
+            return v / std::max(std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z), 1e-3f);
+        };
+
+        Trajectory trajectory;
+        trajectory.initialOrientation = Quaternion::RotationAxisAngle(randomAxis(), unit(random) * 3.f);
+        trajectory.axis = randomAxis();
+        trajectory.angularSpeed = unit(random) * 4.f;
+        trajectory.initialPosition = randomVector(2.f);
+        trajectory.initialVelocity = randomVector(1.f);
+        trajectory.acceleration = randomVector(0.5f);
+        return trajectory;
+    }
+
+    // The velocities of the relative pose, from central finite differences.
+    XrSpaceVelocity differentiate(const std::function<XrPosef(double)>& getPose, double time) {
+        constexpr double h = 1e-3;
+        const XrPosef before = getPose(time - h);
+        const XrPosef after = getPose(time + h);
+
+        XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+        velocity.angularVelocity =
+            extrapolation::angularVelocityBetween(before.orientation, after.orientation, 2 * h);
+        velocity.linearVelocity = (after.position - before.position) / static_cast<float>(2 * h);
+        return velocity;
+    }
+
+    void checkVector(const XrVector3f& actual, const XrVector3f& expected, double tolerance) {
+        CHECK_NEAR(actual.x, expected.x, tolerance);
+        CHECK_NEAR(actual.y, expected.y, tolerance);
+        CHECK_NEAR(actual.z, expected.z, tolerance);
+    }
+
+    void checkPose(const XrPosef& actual, const XrPosef& expected) {
+        // Compare the orientations through their dot product, since the angle suffers from the precision of acos().
+        const XrQuaternionf& a = actual.orientation;
+        const XrQuaternionf& b = expected.orientation;
+        const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        CHECK_NEAR(std::abs(dot), 1, 1e-5);
+        checkVector(actual.position, expected.position, 1e-4);
+    }
+
+} // namespace
+
+TEST_CASE(SpaceMotion_ComposeLocation) {
+    std::mt19937 random(1234);
+    for (int i = 0; i < 100; i++) {
+        // Locate a space against a base space, both rotating and translating relative to the origin.
+        const Trajectory space = makeRandomTrajectory(random);
+        const Trajectory baseSpace = makeRandomTrajectory(random);
+        const auto getRelativePose = [&](double time) {
+            return Pose::Multiply(space.getPose(time), Pose::Invert(baseSpace.getPose(time)));
+        };
+
+        for (const double time : {0.0, 0.25, 1.0}) {
+            XrPosef pose;
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            const XrSpaceLocationFlags flags = motion::composeLocation(k_trackedFlags,
+                                                                       space.getPose(time),
+                                                                       space.getVelocity(time),
+                                                                       k_trackedFlags,
+                                                                       Pose::Invert(baseSpace.getPose(time)),
+                                                                       baseSpace.getVelocity(time),
+                                                                       pose,
+                                                                       &velocity);
+            CHECK(flags == k_trackedFlags);
+            CHECK(velocity.velocityFlags ==
+                  (XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT));
+            checkPose(pose, getRelativePose(time));
+
+            // The velocities must match the motion of the relative pose.
+            const XrSpaceVelocity expected = differentiate(getRelativePose, time);
+            checkVector(velocity.angularVelocity, expected.angularVelocity, 2e-3);
+            checkVector(velocity.linearVelocity, expected.linearVelocity, 2e-3);
+        }
+    }
+}
+
+TEST_CASE(SpaceMotion_OffsetTangentialVelocity) {
+    std::mt19937 random(5678);
+    for (int i = 0; i < 100; i++) {
+        // An action space (a device with an offset transform) located against a moving base space (also a device
+        // with an offset transform).
+        const Trajectory device = makeRandomTrajectory(random);
+        const Trajectory baseDevice = makeRandomTrajectory(random);
+        const XrPosef offset = makeRandomTrajectory(random).getPose(0);
+        const XrPosef baseOffset = makeRandomTrajectory(random).getPose(0);
+        const auto getSpacePose = [&](double time) { return Pose::Multiply(offset, device.getPose(time)); };
+        const auto getBaseSpacePose = [&](double time) { return Pose::Multiply(baseOffset, baseDevice.getPose(time)); };
+        const auto getRelativePose = [&](double time) {
+            return Pose::Multiply(getSpacePose(time), Pose::Invert(getBaseSpacePose(time)));
+        };
+
+        for (const double time : {0.0, 0.5}) {
+            XrPosef spaceToVirtual = device.getPose(time);
+            XrSpaceVelocity spaceToVirtualVelocity = device.getVelocity(time);
+            motion::applyOffset(offset, spaceToVirtual, &spaceToVirtualVelocity);
+            checkPose(spaceToVirtual, getSpacePose(time));
+
+            // The origin of the space moves with the device, plus the tangential velocity of the offset.
+            const XrSpaceVelocity expectedSpaceVelocity = differentiate(getSpacePose, time);
+            checkVector(spaceToVirtualVelocity.angularVelocity, expectedSpaceVelocity.angularVelocity, 2e-3);
+            checkVector(spaceToVirtualVelocity.linearVelocity, expectedSpaceVelocity.linearVelocity, 2e-3);
+
+            XrPosef baseSpaceToVirtual = baseDevice.getPose(time);
+            XrSpaceVelocity baseSpaceToVirtualVelocity = baseDevice.getVelocity(time);
+            motion::applyOffset(baseOffset, baseSpaceToVirtual, &baseSpaceToVirtualVelocity);
+
+            XrPosef pose;
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            motion::composeLocation(k_trackedFlags,
+                                    spaceToVirtual,
+                                    spaceToVirtualVelocity,
+                                    k_trackedFlags,
+                                    Pose::Invert(baseSpaceToVirtual),
+                                    baseSpaceToVirtualVelocity,
+                                    pose,
+                                    &velocity);
+            checkPose(pose, getRelativePose(time));
+
+            const XrSpaceVelocity expected = differentiate(getRelativePose, time);
+            checkVector(velocity.angularVelocity, expected.angularVelocity, 2e-3);
+            checkVector(velocity.linearVelocity, expected.linearVelocity, 2e-3);
+        }
+    }
+}
+
+TEST_CASE(SpaceMotion_PartialVelocities) {
+    std::mt19937 random(42);
+    const Trajectory space = makeRandomTrajectory(random);
+    const Trajectory baseSpace = makeRandomTrajectory(random);
+
+    // Without the angular velocity of the base space, the tangential velocity is unknown.
+    XrSpaceVelocity baseSpaceVelocity = baseSpace.getVelocity(0);
+    baseSpaceVelocity.velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+    XrPosef pose;
+    XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+    motion::composeLocation(k_trackedFlags,
+                            space.getPose(0),
+                            space.getVelocity(0),
+                            k_trackedFlags,
+                            Pose::Invert(baseSpace.getPose(0)),
+                            baseSpaceVelocity,
+                            pose,
+                            &velocity);
+    CHECK(velocity.velocityFlags == 0);
+
+    // An invalid pose cannot be located.
+    const XrSpaceLocationFlags flags = motion::composeLocation(0,
+                                                               space.getPose(0),
+                                                               space.getVelocity(0),
+                                                               k_trackedFlags,
+                                                               Pose::Invert(baseSpace.getPose(0)),
+                                                               baseSpace.getVelocity(0),
+                                                               pose,
+                                                               &velocity);
+    CHECK(flags == 0);
+
+    // An untracked pose yields a valid but untracked location.
+    const XrSpaceLocationFlags untrackedFlags =
+        motion::composeLocation(XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT,
+                                space.getPose(0),
+                                space.getVelocity(0),
+                                k_trackedFlags,
+                                Pose::Invert(baseSpace.getPose(0)),
+                                baseSpace.getVelocity(0),
+                                pose,
+                                nullptr);
+    CHECK(untrackedFlags == (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT));
+}
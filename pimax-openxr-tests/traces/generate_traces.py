@@ -0,0 +1,123 @@
+# MIT License
+#
+# Copyright(c) 2022-2023 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Synthesizes the gaze traces replayed through the FocusStabilizer by the tests.
+#
+# Each row is one call to FocusStabilizer::update(), with the same fields as the FocusStabilizer trace event: the
+# display time, the time of the tracker sample and the gaze, plus the phase of the eye motion that the row belongs to.
+# Captures of the trace event can be converted to the same format and replayed.
+#
+# The eye tracker delivers samples at 120Hz with 10ms of latency and Gaussian jitter, and the application locates
+# the views at 90Hz, 20ms ahead of the frame. The saccade follows a minimum-jerk profile, with the duration of the main
+# sequence for its amplitude.
+
+import math
+import random
+
+TRACKER_RATE = 120
+TRACKER_LATENCY = 0.010
+FRAME_RATE = 90
+PREDICTION = 0.020
+JITTER_DEGREES = 0.3
+
+
+def direction(yaw, pitch):
+    yaw = math.radians(yaw)
+    pitch = math.radians(pitch)
+    return (math.sin(yaw) * math.cos(pitch), math.sin(pitch), -math.cos(yaw) * math.cos(pitch))
+
+
+class Trace:
+    def __init__(self, seed, duration):
+        self.random = random.Random(seed)
+        self.duration = duration
+        self.fixations = []  # (start, yaw, pitch)
+        self.saccades = []  # (start, duration, from, to)
+        self.dropouts = []  # (start, end)
+
+    def fixate(self, start, yaw, pitch):
+        self.fixations.append((start, yaw, pitch))
+
+    def saccade(self, start, source, target):
+        amplitude = math.hypot(target[0] - source[0], target[1] - source[1])
+        duration = 0.021 + 0.0022 * amplitude
+        self.saccades.append((start, duration, source, target))
+        return start + duration
+
+    def dropout(self, start, end):
+        self.dropouts.append((start, end))
+
+    # The true gaze angles, and the phase of the motion.
+    def angles(self, time):
+        for start, duration, source, target in self.saccades:
+            if start <= time < start + duration:
+                s = (time - start) / duration
+                s = s * s * s * (10 - 15 * s + 6 * s * s)
+                return (source[0] + (target[0] - source[0]) * s, source[1] + (target[1] - source[1]) * s), 'saccade'
+        current = None
+        for start, yaw, pitch in self.fixations:
+            if start <= time:
+                current = (yaw, pitch)
+        return current, 'fixation'
+
+    def generate(self, path, description):
+        samples = []
+        for i in range(int(self.duration * TRACKER_RATE) + 1):
+            time = i / TRACKER_RATE
+            if any(start <= time < end for start, end in self.dropouts):
+                continue
+            (yaw, pitch), _ = self.angles(time)
+            yaw += self.random.gauss(0, JITTER_DEGREES)
+            pitch += self.random.gauss(0, JITTER_DEGREES)
+            samples.append((time, direction(yaw, pitch)))
+
+        with open(path, 'w', newline='\n') as f:
+            f.write(f'# {description}\n')
+            f.write('# Synthesized by generate_traces.py.\n')
+            f.write('time,sampleTime,x,y,z,phase\n')
+            for i in range(int(self.duration * FRAME_RATE)):
+                frameTime = i / FRAME_RATE
+                arrived = [s for s in samples if s[0] + TRACKER_LATENCY <= frameTime]
+                if not arrived:
+                    continue
+                sampleTime, gaze = arrived[-1]
+                _, phase = self.angles(sampleTime)
+                if any(start <= frameTime < end + TRACKER_LATENCY for start, end in self.dropouts):
+                    phase = 'stale'
+                f.write(f'{frameTime + PREDICTION:.6f},{sampleTime:.6f},{gaze[0]:.6f},{gaze[1]:.6f},{gaze[2]:.6f},'
+                        f'{phase}\n')
+
+
+trace = Trace(seed=1, duration=2.0)
+trace.fixate(0, 5, 3)
+trace.generate('fixation_jitter.csv', 'A 2s fixation, with the jitter of the tracker.')
+
+trace = Trace(seed=2, duration=1.2)
+trace.fixate(0, -8, 2)
+end = trace.saccade(0.5, (-8, 2), (12, -4))
+trace.fixate(end, 12, -4)
+trace.generate('saccade.csv', 'A fixation, a 21 degrees saccade, and a fixation where it landed.')
+
+trace = Trace(seed=3, duration=1.5)
+trace.fixate(0, 2, -6)
+trace.dropout(0.6, 0.8)
+trace.generate('stale_sample.csv', 'A fixation, during which the tracker stops delivering samples for 200ms.')
@@ -34,40 +34,19 @@ namespace pimax_openxr {
 
     namespace {
 
-        // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#well-formed-path-strings
-        bool validateString(const std::string_view& str) {
-            for (const auto c : str) {
-                if (!islower(c) && !isdigit(c) && c != '-' && c != '_' && c != '.') {
-                    return false;
-                }
-            }
-            return true;
+        // Compute the offset of the value for one side within an input state.
+        template <typename T>
+        uint16_t getInputStateOffset(T pvrInputState::*member, int side) {
+            static const pvrInputState layout{};
+            const auto& field = layout.*member;
+            return (uint16_t)(reinterpret_cast<const uint8_t*>(&field[side]) -
+                              reinterpret_cast<const uint8_t*>(&layout));
         }
-        bool validatePath(std::string path) {
-            if (path.size() < 2 || path[0] != '/' || path[path.size() - 1] == '/') {
-                return false;
-            }
 
-            path.erase(0, 1);
-            size_t pos = 0;
-            while (!path.empty()) {
-                pos = path.find('/');
-                const auto token = pos != std::string::npos ? path.substr(0, pos) : path;
-                if (token.empty() || !validateString(token)) {
-                    return false;
-                }
-                bool notADot = false;
-                for (const auto c : token) {
-                    if (c != '.') {
-                        notADot = true;
-                    }
-                }
-                if (!notADot) {
-                    return false;
-                }
-                path.erase(0, std::min(token.size() + 1, path.size()));
-            }
-            return true;
+        // Read a value from the input state at the offset recorded in a CompiledActionSource.
+        template <typename T>
+        const T& readInputState(const pvrInputState& state, uint16_t offset) {
+            return *reinterpret_cast<const T*>(reinterpret_cast<const uint8_t*>(&state) + offset);
         }
 
     } // namespace
@@ -80,8 +59,6 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
         *path = stringToPath(pathString, true /* validate */);
         if (*path == XR_NULL_PATH) {
             return XR_ERROR_PATH_FORMAT_INVALID;
@@ -105,14 +82,11 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
+        if (!isKnownPath(path)) {
             return XR_ERROR_PATH_INVALID;
         }
 
-        const auto& str = it->second;
+        const auto& str = getXrPath(path);
         if (bufferCapacityInput && bufferCapacityInput < str.length()) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
@@ -152,7 +126,7 @@ namespace pimax_openxr {
             return XR_ERROR_NAME_INVALID;
         }
 
-        if (!validateString(name)) {
+        if (!mappings::isWellFormedName(name)) {
             return XR_ERROR_PATH_FORMAT_INVALID;
         }
 
@@ -161,30 +135,26 @@ namespace pimax_openxr {
             return XR_ERROR_LOCALIZED_NAME_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
-        for (const auto& entry : m_actionSets) {
-            const ActionSet& xrActionSet = *(ActionSet*)entry;
-
-            if (xrActionSet.name == name) {
-                return XR_ERROR_NAME_DUPLICATED;
-            }
-            if (xrActionSet.localizedName == localizedName) {
-                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
-            }
+        if (m_actionSetNames.count(name)) {
+            return XR_ERROR_NAME_DUPLICATED;
+        }
+        if (m_actionSetLocalizedNames.count(localizedName)) {
+            return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
         }
 
         // CONFORMANCE: We do not support the notion of priority. TODO: Sort actionSources by priority.
 
-        // Create the internal struct.
-        ActionSet& xrActionSet = *new ActionSet;
+        // Create the internal struct. The table also maintains the list of known actionsets for validation and
+        // cleanup.
+        auto [newActionSet, xrActionSet] = m_actionSets.emplace();
         xrActionSet.name = name;
         xrActionSet.localizedName = localizedName;
+        m_actionSetNames.insert(xrActionSet.name);
+        m_actionSetLocalizedNames.insert(xrActionSet.localizedName);
 
-        *actionSet = (XrActionSet)&xrActionSet;
-
-        // Maintain a list of known actionsets for validation.
-        m_actionSets.insert(*actionSet);
+        *actionSet = newActionSet;
 
         TraceLoggingWrite(g_traceProvider, "xrCreateActionSet", TLXArg(*actionSet, "ActionSet"));
 
@@ -195,15 +165,15 @@ namespace pimax_openxr {
     XrResult OpenXrRuntime::xrDestroyActionSet(XrActionSet actionSet) {
         TraceLoggingWrite(g_traceProvider, "xrDestroyActionSet", TLXArg(actionSet, "ActionSet"));
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
-        if (!m_actionSets.count(actionSet)) {
+        const ActionSet* xrActionSet = m_actionSets.get(actionSet);
+        if (!xrActionSet) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        ActionSet* xrActionSet = (ActionSet*)actionSet;
-
-        delete xrActionSet;
+        m_actionSetNames.erase(xrActionSet->name);
+        m_actionSetLocalizedNames.erase(xrActionSet->localizedName);
         m_actionSets.erase(actionSet);
         m_activeActionSets.erase(actionSet);
 
@@ -238,9 +208,10 @@ namespace pimax_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
-        if (!m_actionSets.count(actionSet)) {
+        ActionSet* const xrActionSetPtr = m_actionSets.get(actionSet);
+        if (!xrActionSetPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -253,7 +224,7 @@ namespace pimax_openxr {
             return XR_ERROR_NAME_INVALID;
         }
 
-        if (!validateString(name)) {
+        if (!mappings::isWellFormedName(name)) {
             return XR_ERROR_PATH_FORMAT_INVALID;
         }
 
@@ -262,19 +233,12 @@ namespace pimax_openxr {
             return XR_ERROR_LOCALIZED_NAME_INVALID;
         }
 
-        for (const auto& entry : m_actions) {
-            const Action& xrAction = *(Action*)entry;
-
-            if (xrAction.actionSet != actionSet) {
-                continue;
-            }
-
-            if (xrAction.name == name) {
-                return XR_ERROR_NAME_DUPLICATED;
-            }
-            if (xrAction.localizedName == localizedName) {
-                return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
-            }
+        ActionSet& xrActionSet = *xrActionSetPtr;
+        if (xrActionSet.actionNames.count(name)) {
+            return XR_ERROR_NAME_DUPLICATED;
+        }
+        if (xrActionSet.actionLocalizedNames.count(localizedName)) {
+            return XR_ERROR_LOCALIZED_NAME_DUPLICATED;
         }
 
         for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
@@ -285,8 +249,8 @@ namespace pimax_openxr {
             }
         }
 
-        // Create the internal struct.
-        Action& xrAction = *new Action;
+        // Create the internal struct. The table also maintains the list of known actions for validation and cleanup.
+        auto [newAction, xrAction] = m_actions.emplace();
         xrAction.type = createInfo->actionType;
         xrAction.name = name;
         xrAction.localizedName = localizedName;
@@ -294,12 +258,10 @@ namespace pimax_openxr {
         for (uint32_t i = 0; i < createInfo->countSubactionPaths; i++) {
             xrAction.subactionPaths.insert(createInfo->subactionPaths[i]);
         }
+        xrActionSet.actionNames.insert(xrAction.name);
+        xrActionSet.actionLocalizedNames.insert(xrAction.localizedName);
 
-        *action = (XrAction)&xrAction;
-
-        // Maintain a list of known actions for validation.
-        m_actions.insert(*action);
-        m_actionsForCleanup.insert(*action);
+        *action = newAction;
 
         TraceLoggingWrite(g_traceProvider, "xrCreateAction", TLXArg(*action, "Action"));
 
@@ -310,15 +272,22 @@ namespace pimax_openxr {
     XrResult OpenXrRuntime::xrDestroyAction(XrAction action) {
         TraceLoggingWrite(g_traceProvider, "xrDestroyAction", TLXArg(action, "Action"));
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(action)) {
+        const Action* xrAction = m_actions.get(action);
+        if (!xrAction) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        // We do not delete the action as it might still be used internally (eg: referenced by action spaces).
+        // Release the names, unless the actionset was destroyed first. The handle is generation-checked, so an
+        // actionset created since in the same slot is left alone.
+        if (ActionSet* const xrActionSet = m_actionSets.get(xrAction->actionSet)) {
+            xrActionSet->actionNames.erase(xrAction->name);
+            xrActionSet->actionLocalizedNames.erase(xrAction->localizedName);
+        }
 
-        m_actions.erase(action);
+        // We do not delete the action as it might still be used internally (eg: referenced by action spaces).
+        m_actions.retire(action);
 
         return XR_SUCCESS;
     }
@@ -350,7 +319,7 @@ namespace pimax_openxr {
                               TLArg(getXrPath(suggestedBindings->suggestedBindings[i].binding).c_str(), "Path"));
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
         if (m_activeActionSets.size()) {
             return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
@@ -359,19 +328,24 @@ namespace pimax_openxr {
         const std::string& interactionProfile = getXrPath(suggestedBindings->interactionProfile);
         if (interactionProfile != "/interaction_profiles/ext/eye_gaze_interaction") {
             // Set up to use the controller mappings when a controller is rebinding.
-            const auto checkValidPathIt = m_controllerValidPathsTable.find(interactionProfile);
-            if (checkValidPathIt == m_controllerValidPathsTable.cend()) {
+            const auto profile = mappings::findProfile(interactionProfile);
+            if (!profile) {
                 return XR_ERROR_PATH_UNSUPPORTED;
             }
 
-            std::vector<XrActionSuggestedBinding> bindings;
+            const mappings::PathAutomaton& pathAutomaton = mappings::getPathAutomaton();
+            std::vector<SuggestedBinding> bindings;
+            bindings.reserve(suggestedBindings->countSuggestedBindings);
             for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
                 const std::string& path = getXrPath(suggestedBindings->suggestedBindings[i].binding);
-                if (getActionSide(path, true) < 0 || !checkValidPathIt->second(path)) {
+                const mappings::PathMatch match = pathAutomaton.match(path);
+                // Bindings for the other top-level user paths (eg: /user/head) are accepted, but they are skipped
+                // when resolving the bindings for a controller.
+                if (!mappings::isValidComponent(profile.value(), match.user, match.component)) {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
 
-                bindings.push_back(suggestedBindings->suggestedBindings[i]);
+                bindings.push_back({suggestedBindings->suggestedBindings[i], match.user, match.component});
             }
 
             m_suggestedBindings.insert_or_assign(getXrPath(suggestedBindings->interactionProfile), bindings);
@@ -390,11 +364,15 @@ namespace pimax_openxr {
                     return XR_ERROR_PATH_UNSUPPORTED;
                 }
 
-                Action& xrAction = *(Action*)suggestedBindings->suggestedBindings[i].action;
+                Action* xrAction = m_actions.get(suggestedBindings->suggestedBindings[i].action);
+                if (!xrAction) {
+                    return XR_ERROR_HANDLE_INVALID;
+                }
 
                 ActionSource source{};
                 source.realPath = path;
-                xrAction.actionSources.insert_or_assign(path, source);
+                xrAction->actionSources.insert_or_assign(path, source);
+                compileActionSources(*xrAction);
             }
         }
 
@@ -422,14 +400,14 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_actionsMutex);
 
         if (m_activeActionSets.size()) {
             return XR_ERROR_ACTIONSETS_ALREADY_ATTACHED;
         }
 
         for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
-            if (!m_actionSets.count(attachInfo->actionSets[i])) {
+            if (!m_actionSets.contains(attachInfo->actionSets[i])) {
                 return XR_ERROR_HANDLE_INVALID;
             }
         }
@@ -437,14 +415,12 @@ namespace pimax_openxr {
         for (uint32_t i = 0; i < attachInfo->countActionSets; i++) {
             m_activeActionSets.insert(attachInfo->actionSets[i]);
 
-            ActionSet& xrActionSet = *(ActionSet*)attachInfo->actionSets[i];
+            ActionSet& xrActionSet = *m_actionSets.get(attachInfo->actionSets[i]);
 
             // Identify all valid subaction paths for the actionset.
-            for (const auto& entry : m_actions) {
-                const Action& xrAction = *(Action*)entry;
-
+            m_actions.forEach([&](XrAction entry, const Action& xrAction) {
                 xrActionSet.subactionPaths.insert(xrAction.subactionPaths.begin(), xrAction.subactionPaths.end());
-            }
+            });
         }
 
         return XR_SUCCESS;
@@ -467,7 +443,7 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
         if (m_activeActionSets.empty()) {
             return XR_ERROR_ACTIONSET_NOT_ATTACHED;
@@ -513,77 +489,25 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(getInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(getInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)getInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_BOOLEAN_INPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
         }
 
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
-        }
-
-        std::optional<bool> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.buttonMap != nullptr || value.floatValue != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateBoolean",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the OR of all values.
-                    if (value.buttonMap) {
-                        combinedState = combinedState.value_or(false) || value.buttonMap[side] & value.buttonType;
-                    } else if (value.floatValue) {
-                        combinedState = combinedState.value_or(false) || value.floatValue[side] > 0.95f;
-                    }
-                }
-            }
-        }
-
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-            state->changedSinceLastSync = !!state->currentState != xrAction.lastBoolValue[subActionSide];
-
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? pvrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastBoolValueChangedTime[subActionSide];
-        } else {
-            state->currentState = state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
+        const XrResult result = checkActionStateQuery(xrAction, getInfo->subactionPath);
+        if (XR_FAILED(result)) {
+            return result;
         }
 
-        xrAction.lastBoolValue[subActionSide] = state->currentState;
-        xrAction.lastBoolValueChangedTime[subActionSide] = state->lastChangeTime;
+        getActionStateBoolean(xrAction, getInfo->subactionPath, *state);
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetActionStateBoolean",
@@ -613,87 +537,25 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(getInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(getInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)getInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_FLOAT_INPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
         }
 
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-        }
-
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
+        const XrResult result = checkActionStateQuery(xrAction, getInfo->subactionPath);
+        if (XR_FAILED(result)) {
+            return result;
         }
 
-        std::optional<float> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.floatValue != nullptr ||
-                                 (value.vector2fValue != nullptr && value.vector2fIndex >= 0) ||
-                                 value.buttonMap != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateFloat",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side]) {
-                    // Per spec, the combined state is the absolute maximum of all values.
-                    if (value.floatValue) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.floatValue[side]);
-                    } else if (value.buttonMap) {
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.buttonMap[side] & value.buttonType ? 1.f : 0.f);
-                    } else if (value.vector2fValue) {
-                        const XrVector2f vector2fValue = handleJoystickDeadzone(value.vector2fValue[side]);
-
-                        combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()),
-                                                 value.vector2fIndex == 0 ? vector2fValue.x : vector2fValue.y);
-                    }
-                }
-            }
-        }
-
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-            state->changedSinceLastSync = state->currentState != xrAction.lastFloatValue[subActionSide];
-
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? pvrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastFloatValueChangedTime[subActionSide];
-        } else {
-            state->currentState = 0.0f;
-            state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
-        }
-
-        xrAction.lastFloatValue[subActionSide] = state->currentState;
-        xrAction.lastFloatValueChangedTime[subActionSide] = state->lastChangeTime;
+        getActionStateFloat(xrAction, getInfo->subactionPath, *state);
 
         TraceLoggingWrite(g_traceProvider,
                           "xrGetActionStateFloat",
@@ -723,84 +585,25 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(getInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(getInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)getInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_VECTOR2F_INPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
         }
 
-        if (!m_activeActionSets.count(xrAction.actionSet)) {
-            return XR_ERROR_ACTIONSET_NOT_ATTACHED;
+        const XrResult result = checkActionStateQuery(xrAction, getInfo->subactionPath);
+        if (XR_FAILED(result)) {
+            return result;
         }
 
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
-                return XR_ERROR_PATH_INVALID;
-            }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
-                return XR_ERROR_PATH_UNSUPPORTED;
-            }
-        }
-
-        std::optional<XrVector2f> combinedState;
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        const int subActionSide = std::max(0, getActionSide(subActionPath));
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
-                continue;
-            }
-
-            const std::string& fullPath = source.first;
-            const auto& value = source.second;
-            const bool isBound = value.vector2fValue != nullptr;
-            TraceLoggingWrite(g_traceProvider,
-                              "xrGetActionStateVector2f",
-                              TLArg(fullPath.c_str(), "ActionSourcePath"),
-                              TLArg(isBound, "Bound"));
-
-            // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isBound && side >= 0) {
-                if (m_isControllerActive[side] && value.vector2fValue) {
-                    const XrVector2f vector2fValue = handleJoystickDeadzone(value.vector2fValue[side]);
-
-                    // Per spec, the combined state if the one of the vector with the longest length.
-                    const float l1 = combinedState ? sqrt(combinedState.value().x * combinedState.value().x +
-                                                          combinedState.value().y * combinedState.value().y)
-                                                   : 0.f;
-                    const float l2 = sqrt(vector2fValue.x * vector2fValue.x + vector2fValue.y * vector2fValue.y);
-                    if (l2 >= l1) {
-                        combinedState = vector2fValue;
-                    }
-                }
-            }
-        }
-
-        state->isActive = combinedState ? XR_TRUE : XR_FALSE;
-        if (combinedState) {
-            state->currentState = combinedState.value();
-
-            state->changedSinceLastSync = state->currentState.x != xrAction.lastVector2fValue[subActionSide].x ||
-                                          state->currentState.y != xrAction.lastVector2fValue[subActionSide].y;
-
-            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-            state->lastChangeTime = state->changedSinceLastSync
-                                        ? pvrTimeToXrTime(xrActionSet.cachedInputState.TimeInSeconds)
-                                        : xrAction.lastVector2fValueChangedTime[subActionSide];
-        } else {
-            state->currentState = {0.0f, 0.0f};
-            state->changedSinceLastSync = XR_FALSE;
-            state->lastChangeTime = 0;
-        }
-
-        xrAction.lastVector2fValue[subActionSide] = state->currentState;
-        xrAction.lastVector2fValueChangedTime[subActionSide] = state->lastChangeTime;
+        getActionStateVector2f(xrAction, getInfo->subactionPath, *state);
 
         TraceLoggingWrite(
             g_traceProvider,
@@ -831,60 +634,364 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(getInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(getInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)getInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_POSE_INPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
         }
 
+        const XrResult result = checkActionStateQuery(xrAction, getInfo->subactionPath);
+        if (XR_FAILED(result)) {
+            return result;
+        }
+
+        getActionStatePose(xrAction, getInfo->subactionPath, *state);
+
+        TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(!!state->isActive, "Active"));
+
+        return XR_SUCCESS;
+    }
+
+    // XR_PIMAX_action_state_batch
+    XrResult OpenXrRuntime::xrGetActionStatesPIMAX(XrSession session,
+                                                   const XrActionStatesGetInfoPIMAX* getInfo,
+                                                   XrActionStatesPIMAX* states) {
+        if (getInfo->type != XR_TYPE_ACTION_STATES_GET_INFO_PIMAX || states->type != XR_TYPE_ACTION_STATES_PIMAX) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "xrGetActionStatesPIMAX",
+                          TLXArg(session, "Session"),
+                          TLArg(getInfo->actionCount, "ActionCount"));
+
+        if (!has_XR_PIMAX_action_state_batch) {
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        if (getInfo->actionCount && (!getInfo->actions || !states->results || !states->isActive)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        // Take the lock once for the entire batch.
+        std::shared_lock lock(m_actionsMutex);
+
+        for (uint32_t i = 0; i < getInfo->actionCount; i++) {
+            const XrPath subactionPath = getInfo->subactionPaths ? getInfo->subactionPaths[i] : XR_NULL_PATH;
+
+            Action* const xrAction = m_actions.get(getInfo->actions[i]);
+            if (!xrAction) {
+                states->results[i] = XR_ERROR_HANDLE_INVALID;
+                continue;
+            }
+
+            states->results[i] = checkActionStateQuery(*xrAction, subactionPath);
+            if (XR_FAILED(states->results[i])) {
+                continue;
+            }
+
+            XrBool32 isActive = XR_FALSE;
+            XrBool32 changedSinceLastSync = XR_FALSE;
+            XrTime lastChangeTime = 0;
+            switch (xrAction->type) {
+            case XR_ACTION_TYPE_BOOLEAN_INPUT:
+                if (states->booleanValues) {
+                    XrActionStateBoolean state{XR_TYPE_ACTION_STATE_BOOLEAN};
+                    getActionStateBoolean(*xrAction, subactionPath, state);
+                    states->booleanValues[i] = state.currentState;
+                    isActive = state.isActive;
+                    changedSinceLastSync = state.changedSinceLastSync;
+                    lastChangeTime = state.lastChangeTime;
+                } else {
+                    states->results[i] = XR_ERROR_VALIDATION_FAILURE;
+                }
+                break;
+
+            case XR_ACTION_TYPE_FLOAT_INPUT:
+                if (states->floatValues) {
+                    XrActionStateFloat state{XR_TYPE_ACTION_STATE_FLOAT};
+                    getActionStateFloat(*xrAction, subactionPath, state);
+                    states->floatValues[i] = state.currentState;
+                    isActive = state.isActive;
+                    changedSinceLastSync = state.changedSinceLastSync;
+                    lastChangeTime = state.lastChangeTime;
+                } else {
+                    states->results[i] = XR_ERROR_VALIDATION_FAILURE;
+                }
+                break;
+
+            case XR_ACTION_TYPE_VECTOR2F_INPUT:
+                if (states->vector2fValues) {
+                    XrActionStateVector2f state{XR_TYPE_ACTION_STATE_VECTOR2F};
+                    getActionStateVector2f(*xrAction, subactionPath, state);
+                    states->vector2fValues[i] = state.currentState;
+                    isActive = state.isActive;
+                    changedSinceLastSync = state.changedSinceLastSync;
+                    lastChangeTime = state.lastChangeTime;
+                } else {
+                    states->results[i] = XR_ERROR_VALIDATION_FAILURE;
+                }
+                break;
+
+            case XR_ACTION_TYPE_POSE_INPUT: {
+                XrActionStatePose state{XR_TYPE_ACTION_STATE_POSE};
+                getActionStatePose(*xrAction, subactionPath, state);
+                isActive = state.isActive;
+                break;
+            }
+
+            default:
+                states->results[i] = XR_ERROR_ACTION_TYPE_MISMATCH;
+                break;
+            }
+
+            if (XR_FAILED(states->results[i])) {
+                continue;
+            }
+
+            states->isActive[i] = isActive;
+            if (states->changedSinceLastSync) {
+                states->changedSinceLastSync[i] = changedSinceLastSync;
+            }
+            if (states->lastChangeTimes) {
+                states->lastChangeTimes[i] = lastChangeTime;
+            }
+        }
+
+        return XR_SUCCESS;
+    }
+
+    // Common validation of the action state queries. Must be called with the action lock held.
+    XrResult OpenXrRuntime::checkActionStateQuery(const Action& xrAction, XrPath subactionPath) const {
         if (!m_activeActionSets.count(xrAction.actionSet)) {
             return XR_ERROR_ACTIONSET_NOT_ATTACHED;
         }
 
-        if (getInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(getInfo->subactionPath) == m_strings.cend()) {
+        if (subactionPath != XR_NULL_PATH) {
+            if (!isKnownPath(subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
-            if (!xrAction.subactionPaths.count(getInfo->subactionPath)) {
+            if (!xrAction.subactionPaths.count(subactionPath)) {
                 return XR_ERROR_PATH_UNSUPPORTED;
             }
         }
 
-        const std::string& subActionPath = getXrPath(getInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        return XR_SUCCESS;
+    }
+
+    void OpenXrRuntime::getActionStateBoolean(Action& xrAction, XrPath subactionPath, XrActionStateBoolean& state) {
+        // Hold a reference to the snapshot, in case the actionset is synced concurrently.
+        const ActionSet& xrActionSet = *m_actionSets.get(xrAction.actionSet);
+        const std::shared_ptr<const InputSnapshot> snapshot = xrActionSet.inputSnapshot;
+
+        std::optional<bool> combinedState;
+        double changeTime = 0;
+        const int subActionSide = getSubactionSide(subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(fullPath.c_str(), "ActionSourcePath"));
+            const bool isBound = source.kind == CompiledActionSource::Kind::Button ||
+                                 source.kind == CompiledActionSource::Kind::Float;
+            TraceLoggingWrite(g_traceProvider,
+                              "xrGetActionStateBoolean",
+                              TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"),
+                              TLArg(isBound, "Bound"));
 
-            // We only support hands paths and eye tracker, not gamepad etc.
-            if (!isActionEyeTracker(fullPath)) {
-                const int side = getActionSide(fullPath);
-                if (side >= 0) {
-                    state->isActive = m_isControllerActive[side] ? XR_TRUE : XR_FALSE;
+            // We only support hands paths, not gamepad etc.
+            if (isBound && snapshot && m_isControllerActive[source.side]) {
+                changeTime = std::max(changeTime, getInputChangeTime(*snapshot, source));
+
+                // Per spec, the combined state is the OR of all values.
+                if (source.kind == CompiledActionSource::Kind::Button) {
+                    combinedState =
+                        combinedState.value_or(false) ||
+                        readInputState<uint32_t>(snapshot->state, source.offset) & source.buttonMask;
+                } else {
+                    combinedState = combinedState.value_or(false) ||
+                                    readInputState<float>(snapshot->state, source.offset) > 0.95f;
+                }
+            }
+        }
 
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
+        const int lastValueIndex = subActionSide == 1 ? 1 : 0;
+        std::unique_lock valueLock(xrAction.lastValueMutex);
+        state.isActive = combinedState ? XR_TRUE : XR_FALSE;
+        if (combinedState) {
+            state.currentState = combinedState.value();
+            state.changedSinceLastSync = !!state.currentState != xrAction.lastBoolValue[lastValueIndex];
+
+            state.lastChangeTime = state.changedSinceLastSync
+                                       ? pvrTimeToXrTime(changeTime)
+                                       : xrAction.lastBoolValueChangedTime[lastValueIndex];
+        } else {
+            state.currentState = state.changedSinceLastSync = XR_FALSE;
+            state.lastChangeTime = 0;
+        }
+
+        xrAction.lastBoolValue[lastValueIndex] = state.currentState;
+        xrAction.lastBoolValueChangedTime[lastValueIndex] = state.lastChangeTime;
+    }
+
+    void OpenXrRuntime::getActionStateFloat(Action& xrAction, XrPath subactionPath, XrActionStateFloat& state) {
+        // Hold a reference to the snapshot, in case the actionset is synced concurrently.
+        const ActionSet& xrActionSet = *m_actionSets.get(xrAction.actionSet);
+        const std::shared_ptr<const InputSnapshot> snapshot = xrActionSet.inputSnapshot;
+
+        std::optional<float> combinedState;
+        double changeTime = 0;
+        const int subActionSide = getSubactionSide(subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
+                continue;
+            }
+
+            const bool isBound =
+                source.kind == CompiledActionSource::Kind::Float || source.kind == CompiledActionSource::Kind::Button ||
+                (source.kind == CompiledActionSource::Kind::Vector2f && source.vector2fIndex >= 0);
+            TraceLoggingWrite(g_traceProvider,
+                              "xrGetActionStateFloat",
+                              TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"),
+                              TLArg(isBound, "Bound"));
+
+            // We only support hands paths, not gamepad etc.
+            if (isBound && snapshot && m_isControllerActive[source.side]) {
+                changeTime = std::max(changeTime, getInputChangeTime(*snapshot, source));
+
+                // Per spec, the combined state is the absolute maximum of all values.
+                float value;
+                if (source.kind == CompiledActionSource::Kind::Float) {
+                    value = readInputState<float>(snapshot->state, source.offset);
+                } else if (source.kind == CompiledActionSource::Kind::Button) {
+                    value = readInputState<uint32_t>(snapshot->state, source.offset) & source.buttonMask
+                                ? 1.f
+                                : 0.f;
+                } else {
+                    const XrVector2f vector2fValue =
+                        handleJoystickDeadzone(readInputState<pvrVector2f>(snapshot->state, source.offset));
+                    value = source.vector2fIndex == 0 ? vector2fValue.x : vector2fValue.y;
+                }
+                combinedState = std::max(combinedState.value_or(-std::numeric_limits<float>::infinity()), value);
+            }
+        }
+
+        const int lastValueIndex = subActionSide == 1 ? 1 : 0;
+        std::unique_lock valueLock(xrAction.lastValueMutex);
+        state.isActive = combinedState ? XR_TRUE : XR_FALSE;
+        if (combinedState) {
+            state.currentState = combinedState.value();
+            state.changedSinceLastSync = state.currentState != xrAction.lastFloatValue[lastValueIndex];
+
+            state.lastChangeTime = state.changedSinceLastSync
+                                       ? pvrTimeToXrTime(changeTime)
+                                       : xrAction.lastFloatValueChangedTime[lastValueIndex];
+        } else {
+            state.currentState = 0.0f;
+            state.changedSinceLastSync = XR_FALSE;
+            state.lastChangeTime = 0;
+        }
+
+        xrAction.lastFloatValue[lastValueIndex] = state.currentState;
+        xrAction.lastFloatValueChangedTime[lastValueIndex] = state.lastChangeTime;
+    }
+
+    void OpenXrRuntime::getActionStateVector2f(Action& xrAction, XrPath subactionPath, XrActionStateVector2f& state) {
+        // Hold a reference to the snapshot, in case the actionset is synced concurrently.
+        const ActionSet& xrActionSet = *m_actionSets.get(xrAction.actionSet);
+        const std::shared_ptr<const InputSnapshot> snapshot = xrActionSet.inputSnapshot;
+
+        std::optional<XrVector2f> combinedState;
+        double changeTime = 0;
+        const int subActionSide = getSubactionSide(subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
+                continue;
+            }
+
+            const bool isBound = source.kind == CompiledActionSource::Kind::Vector2f;
+            TraceLoggingWrite(g_traceProvider,
+                              "xrGetActionStateVector2f",
+                              TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"),
+                              TLArg(isBound, "Bound"));
+
+            // We only support hands paths, not gamepad etc.
+            if (isBound && snapshot && m_isControllerActive[source.side]) {
+                changeTime = std::max(changeTime, getInputChangeTime(*snapshot, source));
+
+                const XrVector2f vector2fValue =
+                    handleJoystickDeadzone(readInputState<pvrVector2f>(snapshot->state, source.offset));
+
+                // Per spec, the combined state if the one of the vector with the longest length.
+                const float l1 = combinedState ? sqrt(combinedState.value().x * combinedState.value().x +
+                                                      combinedState.value().y * combinedState.value().y)
+                                               : 0.f;
+                const float l2 = sqrt(vector2fValue.x * vector2fValue.x + vector2fValue.y * vector2fValue.y);
+                if (l2 >= l1) {
+                    combinedState = vector2fValue;
                 }
+            }
+        }
+
+        const int lastValueIndex = subActionSide == 1 ? 1 : 0;
+        std::unique_lock valueLock(xrAction.lastValueMutex);
+        state.isActive = combinedState ? XR_TRUE : XR_FALSE;
+        if (combinedState) {
+            state.currentState = combinedState.value();
+
+            state.changedSinceLastSync = state.currentState.x != xrAction.lastVector2fValue[lastValueIndex].x ||
+                                         state.currentState.y != xrAction.lastVector2fValue[lastValueIndex].y;
+
+            state.lastChangeTime = state.changedSinceLastSync
+                                       ? pvrTimeToXrTime(changeTime)
+                                       : xrAction.lastVector2fValueChangedTime[lastValueIndex];
+        } else {
+            state.currentState = {0.0f, 0.0f};
+            state.changedSinceLastSync = XR_FALSE;
+            state.lastChangeTime = 0;
+        }
+
+        xrAction.lastVector2fValue[lastValueIndex] = state.currentState;
+        xrAction.lastVector2fValueChangedTime[lastValueIndex] = state.lastChangeTime;
+    }
+
+    void OpenXrRuntime::getActionStatePose(const Action& xrAction,
+                                           XrPath subactionPath,
+                                           XrActionStatePose& state) const {
+        state.isActive = XR_FALSE;
+        const int subActionSide = getSubactionSide(subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
+                continue;
+            }
+
+            TraceLoggingWrite(
+                g_traceProvider, "xrGetActionStatePose", TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"));
+
+            // We only support hands paths and eye tracker, not gamepad etc.
+            if (source.kind != CompiledActionSource::Kind::EyeTrackerPose) {
+                state.isActive = m_isControllerActive[source.side] ? XR_TRUE : XR_FALSE;
+
+                // Per spec we must consistently pick one source. We pick the first one.
+                break;
             } else {
-                state->isActive = m_isEyeTrackingAvailable ? XR_TRUE : XR_FALSE;
+                state.isActive = m_isEyeTrackingAvailable ? XR_TRUE : XR_FALSE;
 
                 // Per spec we must consistently pick one source. We pick the first one.
                 break;
             }
         }
-
-        TraceLoggingWrite(g_traceProvider, "xrGetActionStatePose", TLArg(!!state->isActive, "Active"));
-
-        return XR_SUCCESS;
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrSyncActions
@@ -905,27 +1012,28 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        // TODO: Try to reduce contention here.
-        std::unique_lock lock(m_actionsAndSpacesMutex);
-
         bool doSide[2] = {false, false};
-        for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-            if (!m_activeActionSets.count(syncInfo->activeActionSets[i].actionSet)) {
-                return XR_ERROR_ACTIONSET_NOT_ATTACHED;
-            }
-
-            if (syncInfo->activeActionSets[i].subactionPath == XR_NULL_PATH) {
-                doSide[0] = doSide[1] = true;
-            } else {
-                const ActionSet& xrActionSet = *(ActionSet*)syncInfo->activeActionSets[i].actionSet;
+        {
+            std::shared_lock lock(m_actionsMutex);
 
-                if (!xrActionSet.subactionPaths.count(syncInfo->activeActionSets[i].subactionPath)) {
-                    return XR_ERROR_PATH_UNSUPPORTED;
+            for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
+                if (!m_activeActionSets.count(syncInfo->activeActionSets[i].actionSet)) {
+                    return XR_ERROR_ACTIONSET_NOT_ATTACHED;
                 }
 
-                const int side = getActionSide(getXrPath(syncInfo->activeActionSets[i].subactionPath));
-                if (side >= 0) {
-                    doSide[side] = true;
+                if (syncInfo->activeActionSets[i].subactionPath == XR_NULL_PATH) {
+                    doSide[0] = doSide[1] = true;
+                } else {
+                    const ActionSet& xrActionSet = *m_actionSets.get(syncInfo->activeActionSets[i].actionSet);
+
+                    if (!xrActionSet.subactionPaths.count(syncInfo->activeActionSets[i].subactionPath)) {
+                        return XR_ERROR_PATH_UNSUPPORTED;
+                    }
+
+                    const int side = getActionSide(getXrPath(syncInfo->activeActionSets[i].subactionPath));
+                    if (side >= 0) {
+                        doSide[side] = true;
+                    }
                 }
             }
         }
@@ -934,8 +1042,19 @@ namespace pimax_openxr {
             return XR_SESSION_NOT_FOCUSED;
         }
 
-        // Latch the state of all inputs, and we will let the further calls to xrGetActionState*() do the triage.
-        CHECK_PVRCMD(pvr_getInputState(m_pvrSession, &m_cachedInputState));
+        // Latch the state of all inputs, and we will let the further calls to xrGetActionState*() do the triage. The
+        // snapshot is built without holding m_actionsMutex, so that the getters on other threads are not blocked by the
+        // PVR call.
+        auto snapshot = std::make_shared<InputSnapshot>();
+        pvrInputState& inputState = snapshot->state;
+        {
+            std::unique_lock latchLock(m_inputLatchMutex);
+
+            snapshot->version = ++m_inputSnapshotVersion;
+            if (!m_inputSamplingThread.joinable() || !latchSampledInputState(*snapshot)) {
+                CHECK_PVRCMD(pvr_getInputState(m_pvrSession, &inputState));
+            }
+        }
         bool wasRecenteringPressed = false;
         bool wasSystemPressed = false;
         for (uint32_t side = 0; side < 2; side++) {
@@ -947,53 +1066,71 @@ namespace pimax_openxr {
                 g_traceProvider,
                 "PVR_InputState",
                 TLArg(side == 0 ? "Left" : "Right", "Side"),
-                TLArg(m_cachedInputState.TimeInSeconds, "TimeInSeconds"),
-                TLArg(m_cachedInputState.HandButtons[side], "ButtonPress"),
-                TLArg(m_cachedInputState.HandTouches[side], "ButtonTouches"),
-                TLArg(m_cachedInputState.Trigger[side], "Trigger"),
-                TLArg(m_cachedInputState.Grip[side], "Grip"),
-                TLArg(m_cachedInputState.GripForce[side], "GripForce"),
-                TLArg(fmt::format("{}, {}", m_cachedInputState.JoyStick[side].x, m_cachedInputState.JoyStick[side].y)
+                TLArg(inputState.TimeInSeconds, "TimeInSeconds"),
+                TLArg(inputState.HandButtons[side], "ButtonPress"),
+                TLArg(inputState.HandTouches[side], "ButtonTouches"),
+                TLArg(inputState.Trigger[side], "Trigger"),
+                TLArg(inputState.Grip[side], "Grip"),
+                TLArg(inputState.GripForce[side], "GripForce"),
+                TLArg(fmt::format("{}, {}", inputState.JoyStick[side].x, inputState.JoyStick[side].y)
                           .c_str(),
                       "Joystick"),
-                TLArg(fmt::format("{}, {}", m_cachedInputState.TouchPad[side].x, m_cachedInputState.TouchPad[side].y)
+                TLArg(fmt::format("{}, {}", inputState.TouchPad[side].x, inputState.TouchPad[side].y)
                           .c_str(),
                       "Touchpad"),
-                TLArg(m_cachedInputState.TouchPadForce[side], "TouchpadForce"),
-                TLArg(m_cachedInputState.fingerIndex[side], "IndexFinger"),
-                TLArg(m_cachedInputState.fingerMiddle[side], "MiddleFinger"),
-                TLArg(m_cachedInputState.fingerRing[side], "RingFinger"),
-                TLArg(m_cachedInputState.fingerPinky[side], "PinkyFinger"));
-
-            // Look for changes in controller/interaction profiles.
-            const auto lastControllerType = m_cachedControllerType[side];
-            const int size = pvr_getTrackedDeviceStringProperty(m_pvrSession,
-                                                                side == 0 ? pvrTrackedDevice_LeftController
-                                                                          : pvrTrackedDevice_RightController,
-                                                                pvrTrackedDeviceProp_ControllerType_String,
-                                                                nullptr,
-                                                                0);
-            m_isControllerActive[side] = size > 0;
-            if (m_isControllerActive[side]) {
-                if (m_debugControllerType.empty()) {
-                    m_cachedControllerType[side].resize(size, 0);
-                    pvr_getTrackedDeviceStringProperty(m_pvrSession,
-                                                       side == 0 ? pvrTrackedDevice_LeftController
-                                                                 : pvrTrackedDevice_RightController,
-                                                       pvrTrackedDeviceProp_ControllerType_String,
-                                                       m_cachedControllerType[side].data(),
-                                                       (int)m_cachedControllerType[side].size() + 1);
-                    // Remove trailing 0.
-                    m_cachedControllerType[side].resize(size - 1, 0);
-                } else {
-                    m_cachedControllerType[side] = m_debugControllerType;
+                TLArg(inputState.TouchPadForce[side], "TouchpadForce"),
+                TLArg(inputState.fingerIndex[side], "IndexFinger"),
+                TLArg(inputState.fingerMiddle[side], "MiddleFinger"),
+                TLArg(inputState.fingerRing[side], "RingFinger"),
+                TLArg(inputState.fingerPinky[side], "PinkyFinger"));
+
+            // Check for built-in actions.
+            wasRecenteringPressed =
+                wasRecenteringPressed || (((inputState.HandButtons[side] & pvrButton_System) ||
+                                           (inputState.HandButtons[side] & pvrButton_ApplicationMenu)) &&
+                                          (inputState.HandButtons[side] & pvrButton_Trigger));
+            wasSystemPressed = wasSystemPressed || (inputState.HandButtons[side] & pvrButton_System);
+
+            // When any built-in action is requested, block the unwanted input for the app.
+            if (wasRecenteringPressed || wasSystemPressed) {
+                inputState.HandButtons[side] &= ~(pvrButton_ApplicationMenu | pvrButton_Trigger);
+                inputState.HandTouches[side] &= ~(pvrButton_ApplicationMenu | pvrButton_Trigger);
+            }
+        }
+
+        // Only swapping in the bindings and the snapshot requires exclusive access.
+        std::unique_lock lock(m_actionsMutex);
+
+        // Swap in the bindings for any controller that was detected by a previous sync.
+        applyPendingRebindPlans();
+
+        for (uint32_t side = 0; side < 2; side++) {
+            if (!doSide[side]) {
+                continue;
+            }
+
+            // Look for changes in controller/interaction profiles. The controller types are refreshed in the
+            // background, and we only need to check the generation counter of the poller here.
+            bool controllerTypeChanged = false;
+            const uint64_t controllerTypeGeneration = m_controllerTypeGeneration.load(std::memory_order_acquire);
+            if (controllerTypeGeneration != m_lastControllerTypeGeneration[side]) {
+                m_lastControllerTypeGeneration[side] = controllerTypeGeneration;
+
+                std::string controllerType;
+                {
+                    std::unique_lock pollingLock(m_controllerPollingMutex);
+                    m_isControllerActive[side] = m_polledControllerActive[side];
+                    controllerType = m_polledControllerType[side];
                 }
-            } else {
-                m_cachedControllerType[side].clear();
+                if (m_isControllerActive[side] && !m_debugControllerType.empty()) {
+                    controllerType = m_debugControllerType;
+                }
+
+                controllerTypeChanged = controllerType != m_cachedControllerType[side];
+                m_cachedControllerType[side] = std::move(controllerType);
             }
 
-            if (lastControllerType != m_cachedControllerType[side] ||
-                m_forcedInteractionProfile != m_lastForcedInteractionProfile) {
+            if (controllerTypeChanged || m_forcedInteractionProfile != m_lastForcedInteractionProfile) {
                 if (!m_cachedControllerType[side].empty()) {
                     Log("Detected controller: %s (%s)\n",
                         m_cachedControllerType[side].c_str(),
@@ -1003,27 +1140,27 @@ namespace pimax_openxr {
                                   "PVR_ControllerType",
                                   TLArg(side == 0 ? "Left" : "Right", "Side"),
                                   TLArg(m_cachedControllerType[side].c_str(), "Type"));
-                rebindControllerActions(side);
+                requestRebindControllerActions(side);
             }
+        }
 
-            // Check for built-in actions.
-            wasRecenteringPressed =
-                wasRecenteringPressed || (((m_cachedInputState.HandButtons[side] & pvrButton_System) ||
-                                           (m_cachedInputState.HandButtons[side] & pvrButton_ApplicationMenu)) &&
-                                          (m_cachedInputState.HandButtons[side] & pvrButton_Trigger));
-            wasSystemPressed = wasSystemPressed || (m_cachedInputState.HandButtons[side] & pvrButton_System);
-
-            // When any built-in action is requested, block the unwanted input for the app.
-            if (wasRecenteringPressed || wasSystemPressed) {
-                m_cachedInputState.HandButtons[side] &= ~(pvrButton_ApplicationMenu | pvrButton_Trigger);
-                m_cachedInputState.HandTouches[side] &= ~(pvrButton_ApplicationMenu | pvrButton_Trigger);
-            }
+        // Propagate the input state to the entire action state. The snapshot is immutable from this point, and it is
+        // shared by all the actionsets that were synced together.
+        if (doSide[0] || doSide[1]) {
+            TraceLoggingWrite(g_traceProvider, "xrSyncActions", TLArg(snapshot->version, "InputSnapshotVersion"));
 
-            // Propagate the input state to the entire action state.
+            const std::shared_ptr<const InputSnapshot> publishedSnapshot = std::move(snapshot);
             for (uint32_t i = 0; i < syncInfo->countActiveActionSets; i++) {
-                ActionSet& xrActionSet = *(ActionSet*)syncInfo->activeActionSets[i].actionSet;
+                // The actionset might have been destroyed while the lock was released.
+                if (!m_activeActionSets.count(syncInfo->activeActionSets[i].actionSet)) {
+                    continue;
+                }
+                ActionSet& xrActionSet = *m_actionSets.get(syncInfo->activeActionSets[i].actionSet);
 
-                xrActionSet.cachedInputState = m_cachedInputState;
+                // A concurrent sync may have published a more recent snapshot already.
+                if (!xrActionSet.inputSnapshot || xrActionSet.inputSnapshot->version < publishedSnapshot->version) {
+                    xrActionSet.inputSnapshot = publishedSnapshot;
+                }
             }
         }
         m_lastForcedInteractionProfile = m_forcedInteractionProfile;
@@ -1055,35 +1192,31 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(enumerateInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(enumerateInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)enumerateInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (!m_activeActionSets.count(xrAction.actionSet)) {
             return XR_ERROR_ACTIONSET_NOT_ATTACHED;
         }
 
-        if (sourceCapacityInput && sourceCapacityInput < xrAction.actionSources.size()) {
+        if (sourceCapacityInput && sourceCapacityInput < xrAction.boundSources.size()) {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        *sourceCountOutput = (uint32_t)xrAction.actionSources.size();
+        *sourceCountOutput = (uint32_t)xrAction.boundSources.size();
         TraceLoggingWrite(
             g_traceProvider, "xrEnumerateBoundSourcesForAction", TLArg(*sourceCountOutput, "SourceCountOutput"));
 
         if (sourceCapacityInput && sources) {
-            uint32_t i = 0;
-            for (const auto& source : xrAction.actionSources) {
-                sources[i] = stringToPath(source.second.realPath.c_str());
-                TraceLoggingWrite(g_traceProvider,
-                                  "xrEnumerateBoundSourcesForAction",
-                                  TLArg(source.first.c_str(), "Source"),
-                                  TLArg(sources[i], "Path"));
-                i++;
+            for (uint32_t i = 0; i < xrAction.boundSources.size(); i++) {
+                sources[i] = xrAction.boundSources[i];
+                TraceLoggingWrite(g_traceProvider, "xrEnumerateBoundSourcesForAction", TLArg(sources[i], "Path"));
             }
         }
 
@@ -1113,7 +1246,7 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
         if (m_activeActionSets.empty()) {
             return XR_ERROR_ACTIONSET_NOT_ATTACHED;
@@ -1123,24 +1256,66 @@ namespace pimax_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        const std::string path = getXrPath(getInfo->sourcePath);
+        const std::string& path = getXrPath(getInfo->sourcePath);
         if (path.empty() || path == "<unknown>") {
             return XR_ERROR_PATH_INVALID;
         }
 
-        // Build the string.
+        // The names only change upon rebinding, so we build them once per rebind. Lookups only need the shared side of
+        // the lock.
+        const uint64_t key = (getInfo->sourcePath << 3) | (getInfo->whichComponents & 7);
+        std::string localizedName;
+        bool isCached = false;
+        {
+            std::shared_lock cacheLock(m_localizedNamesCacheMutex);
+            const auto it = m_localizedNamesCache.find(key);
+            if (it != m_localizedNamesCache.end() &&
+                (it->second.side < 0 || it->second.generation == m_appliedRebindGeneration[it->second.side])) {
+                localizedName = it->second.name;
+                isCached = true;
+            }
+        }
+        if (!isCached) {
+            LocalizedNameCacheEntry entry;
+            entry.side = isActionEyeTracker(path) ? -1 : getActionSide(path);
+            entry.generation = entry.side >= 0 ? m_appliedRebindGeneration[entry.side] : 0;
+            entry.name = buildInputSourceLocalizedName(path, entry.side, getInfo->whichComponents);
+            localizedName = entry.name;
+
+            std::unique_lock cacheLock(m_localizedNamesCacheMutex);
+            m_localizedNamesCache.insert_or_assign(key, std::move(entry));
+        }
+
+        if (bufferCapacityInput && bufferCapacityInput < localizedName.length()) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+
+        *bufferCountOutput = (uint32_t)localizedName.length() + 1;
+        TraceLoggingWrite(
+            g_traceProvider, "xrGetInputSourceLocalizedName", TLArg(*bufferCountOutput, "BufferCountOutput"));
+
+        if (bufferCapacityInput && buffer) {
+            sprintf_s(buffer, bufferCapacityInput, "%s", localizedName.c_str());
+            TraceLoggingWrite(g_traceProvider, "xrGetInputSourceLocalizedName", TLArg(buffer, "String"));
+        }
+
+        return XR_SUCCESS;
+    }
+
+    std::string OpenXrRuntime::buildInputSourceLocalizedName(const std::string& path,
+                                                             int side,
+                                                             XrInputSourceLocalizedNameFlags whichComponents) const {
         std::string localizedName;
         if (!isActionEyeTracker(path)) {
-            const int side = getActionSide(path);
             if (side >= 0) {
                 bool needSpace = false;
 
-                if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_USER_PATH_BIT)) {
+                if ((whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_USER_PATH_BIT)) {
                     localizedName += side == 0 ? "Left Hand" : "Right Hand";
                     needSpace = true;
                 }
 
-                if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT)) {
+                if ((whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT)) {
                     if (needSpace) {
                         localizedName += " ";
                     }
@@ -1148,18 +1323,19 @@ namespace pimax_openxr {
                     needSpace = true;
                 }
 
-                if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) {
+                if ((whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) {
                     if (needSpace) {
                         localizedName += " ";
                     }
                     if (m_cachedControllerType[side] == "vive_controller") {
-                        localizedName += getViveControllerLocalizedSourceName(path);
+                        localizedName += getControllerLocalizedSourceName(mappings::Profile::ViveController, path);
                     } else if (m_cachedControllerType[side] == "knuckles") {
-                        localizedName += getIndexControllerLocalizedSourceName(path);
+                        localizedName += getControllerLocalizedSourceName(mappings::Profile::IndexController, path);
                     } else if (m_cachedControllerType[side] == "pimax_crystal") {
-                        localizedName += getCrystalControllerLocalizedSourceName(path);
+                        localizedName +=
+                            getControllerLocalizedSourceName(mappings::Profile::OculusTouchController, path);
                     } else {
-                        localizedName += getSimpleControllerLocalizedSourceName(path);
+                        localizedName += getControllerLocalizedSourceName(mappings::Profile::SimpleController, path);
                     }
                     needSpace = true;
                 }
@@ -1167,12 +1343,12 @@ namespace pimax_openxr {
         } else {
             bool needSpace = false;
 
-            if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT)) {
+            if ((whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT)) {
                 localizedName += "Eye Gaze Interaction";
                 needSpace = true;
             }
 
-            if ((getInfo->whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) {
+            if ((whichComponents & XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) {
                 if (needSpace) {
                     localizedName += " ";
                 }
@@ -1181,20 +1357,7 @@ namespace pimax_openxr {
             }
         }
 
-        if (bufferCapacityInput && bufferCapacityInput < localizedName.length()) {
-            return XR_ERROR_SIZE_INSUFFICIENT;
-        }
-
-        *bufferCountOutput = (uint32_t)localizedName.length() + 1;
-        TraceLoggingWrite(
-            g_traceProvider, "xrGetInputSourceLocalizedName", TLArg(*bufferCountOutput, "BufferCountOutput"));
-
-        if (bufferCapacityInput && buffer) {
-            sprintf_s(buffer, bufferCapacityInput, "%s", localizedName.c_str());
-            TraceLoggingWrite(g_traceProvider, "xrGetInputSourceLocalizedName", TLArg(buffer, "String"));
-        }
-
-        return XR_SUCCESS;
+        return localizedName;
     }
 
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrApplyHapticFeedback
@@ -1215,13 +1378,14 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(hapticActionInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(hapticActionInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)hapticActionInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
@@ -1236,7 +1400,7 @@ namespace pimax_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!isKnownPath(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1244,19 +1408,18 @@ namespace pimax_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        const int subActionSide = getSubactionSide(hapticActionInfo->subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            const bool isOutput = endsWith(fullPath, "/output/haptic");
-            TraceLoggingWrite(g_traceProvider, "xrApplyHapticFeedback", TLArg(fullPath.c_str(), "ActionSourcePath"));
+            TraceLoggingWrite(
+                g_traceProvider, "xrApplyHapticFeedback", TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"));
 
             // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isOutput && side >= 0) {
+            if (source.kind == CompiledActionSource::Kind::Haptic) {
+                const int side = source.side;
                 const XrHapticBaseHeader* entry = reinterpret_cast<const XrHapticBaseHeader*>(hapticFeedback);
                 while (entry) {
                     if (entry->type == XR_TYPE_HAPTIC_VIBRATION) {
@@ -1268,14 +1431,10 @@ namespace pimax_openxr {
                                           TLArg(vibration->frequency, "Frequency"),
                                           TLArg(vibration->duration, "Duration"));
 
-                        // NOTE: PVR only supports pulses, so there is nothing we can do with the
-                        // frequency/duration? OpenComposite seems to pass an amplitude of 0 sometimes, which is not
-                        // supported.
-                        if (vibration->amplitude > 0) {
-                            CHECK_PVRCMD(pvr_triggerHapticPulse(m_pvrSession,
-                                                                side == 0 ? pvrTrackedDevice_LeftController
-                                                                          : pvrTrackedDevice_RightController,
-                                                                vibration->amplitude));
+                        // PVR only supports pulses, so the scheduler renders the vibration as a pulse train.
+                        if (m_hapticsScheduler) {
+                            m_hapticsScheduler->apply(
+                                side, vibration->amplitude, vibration->duration, vibration->frequency);
                         }
                         break;
                     }
@@ -1304,13 +1463,14 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock lock(m_actionsMutex);
 
-        if (!m_actions.count(hapticActionInfo->action)) {
+        Action* const xrActionPtr = m_actions.get(hapticActionInfo->action);
+        if (!xrActionPtr) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Action& xrAction = *(Action*)hapticActionInfo->action;
+        Action& xrAction = *xrActionPtr;
 
         if (xrAction.type != XR_ACTION_TYPE_VIBRATION_OUTPUT) {
             return XR_ERROR_ACTION_TYPE_MISMATCH;
@@ -1321,7 +1481,7 @@ namespace pimax_openxr {
         }
 
         if (hapticActionInfo->subactionPath != XR_NULL_PATH) {
-            if (m_strings.find(hapticActionInfo->subactionPath) == m_strings.cend()) {
+            if (!isKnownPath(hapticActionInfo->subactionPath)) {
                 return XR_ERROR_PATH_INVALID;
             }
             if (!xrAction.subactionPaths.count(hapticActionInfo->subactionPath)) {
@@ -1329,20 +1489,18 @@ namespace pimax_openxr {
             }
         }
 
-        const std::string& subActionPath = getXrPath(hapticActionInfo->subactionPath);
-        for (const auto& source : xrAction.actionSources) {
-            if (!startsWith(source.first, subActionPath)) {
+        const int subActionSide = getSubactionSide(hapticActionInfo->subactionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
                 continue;
             }
 
-            const std::string& fullPath = source.first;
-            const bool isOutput = endsWith(fullPath, "/output/haptic");
-            TraceLoggingWrite(g_traceProvider, "xrStopHapticFeedback", TLArg(fullPath.c_str(), "ActionSourcePath"));
+            TraceLoggingWrite(
+                g_traceProvider, "xrStopHapticFeedback", TLArg(getXrPath(source.path).c_str(), "ActionSourcePath"));
 
             // We only support hands paths, not gamepad etc.
-            const int side = getActionSide(fullPath);
-            if (isOutput && side >= 0) {
-                // Nothing to do here.
+            if (source.kind == CompiledActionSource::Kind::Haptic && m_hapticsScheduler) {
+                m_hapticsScheduler->stop(source.side);
             }
         }
 
@@ -1356,174 +1514,217 @@ namespace pimax_openxr {
 
     // Update all actions with the appropriate bindings for the controller.
     void OpenXrRuntime::rebindControllerActions(int side) {
-        std::string preferredInteractionProfile;
-        std::string actualInteractionProfile;
-        XrPosef gripPose = Pose::Identity();
-        XrPosef aimPose = Pose::Identity();
-
-        // Remove all old bindings for this controller.
-        for (const auto& action : m_actions) {
-            Action& xrAction = *(Action*)action;
+        applyRebindPlan(buildRebindPlan(makeRebindRequest(side)));
+    }
 
-            for (auto it = xrAction.actionSources.begin(); it != xrAction.actionSources.end();) {
-                if (getActionSide(it->first) == side) {
-                    it = xrAction.actionSources.erase(it);
-                } else {
-                    it++;
+    OpenXrRuntime::RebindRequest OpenXrRuntime::makeRebindRequest(int side) {
+        RebindRequest request{};
+        request.side = side;
+        request.generation = ++m_rebindGeneration[side];
+        request.controllerType = m_cachedControllerType[side];
+        request.forcedInteractionProfile = m_forcedInteractionProfile;
+
+        // Actions are never deleted while the instance is alive (only retired), and their type does not change, so
+        // the plan can safely refer to them without the action lock.
+        for (const auto& [interactionProfile, bindings] : m_suggestedBindings) {
+            auto& resolvedBindings = request.suggestedBindings[interactionProfile];
+            for (const auto& suggested : bindings) {
+                const Action* xrAction = m_actions.get(suggested.binding.action);
+                if (xrAction) {
+                    resolvedBindings.push_back(std::make_pair(suggested, xrAction));
                 }
             }
         }
 
-        if (!m_cachedControllerType[side].empty()) {
-            // Identify the physical controller type.
-            if (m_cachedControllerType[side] == "vive_controller") {
-                preferredInteractionProfile = "/interaction_profiles/htc/vive_controller";
-                m_localizedControllerType[side] = "Vive Controller";
-                gripPose = Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(8.f), 0, 0}),
-                                          XrVector3f{0, 0, 0});
-                aimPose = Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(5.f), 0, 0}),
-                                         XrVector3f{0, 0, -0.05f});
-            } else if (m_cachedControllerType[side] == "knuckles") {
-                preferredInteractionProfile = "/interaction_profiles/valve/index_controller";
-                m_localizedControllerType[side] = "Index Controller";
-                gripPose =
-                    Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(20.f), 0, PVR::DegreeToRad(2.f)}),
-                                   XrVector3f{0, 0, 0});
-                aimPose = Pose::MakePose(
-                    Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(-40.f), PVR::DegreeToRad(-15.f), 0}),
-                    XrVector3f{0, 0, -0.05f});
-            } else if (m_cachedControllerType[side] == "pimax_crystal") {
-                preferredInteractionProfile = "/interaction_profiles/oculus/touch_controller";
-                m_localizedControllerType[side] = "Crystal Controller";
-                gripPose = Pose::MakePose(Quaternion::RotationRollPitchYaw(
-                                              {PVR::DegreeToRad(40.f), PVR::DegreeToRad(5.f), PVR::DegreeToRad(10.f)}),
-                                          XrVector3f{0, 0, 0});
-                aimPose = Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(-5.f), 0, 0}),
-                                         XrVector3f{0, 0.03f, -0.06f});
-            } else {
-                // Fallback to simple controller.
-                preferredInteractionProfile = "/interaction_profiles/khr/simple_controller";
-                m_localizedControllerType[side] = "Controller";
-            }
+        return request;
+    }
+
+    // Compute the bindings for the controller. This does not modify any state and can run on any thread.
+    OpenXrRuntime::RebindPlan OpenXrRuntime::buildRebindPlan(const RebindRequest& request) {
+        const int side = request.side;
+
+        RebindPlan plan{};
+        plan.side = side;
+        plan.generation = request.generation;
+        plan.gripPose = Pose::Identity();
+        plan.aimPose = Pose::Identity();
 
-            // Try to map with the preferred bindings.
-            auto bindings = m_suggestedBindings.find(preferredInteractionProfile);
-            if (bindings != m_suggestedBindings.cend()) {
-                actualInteractionProfile = preferredInteractionProfile;
+        if (request.controllerType.empty()) {
+            return plan;
+        }
+
+        std::string preferredInteractionProfile;
+        std::string& actualInteractionProfile = plan.interactionProfile;
+
+        // Identify the physical controller type.
+        if (request.controllerType == "vive_controller") {
+            preferredInteractionProfile = "/interaction_profiles/htc/vive_controller";
+            plan.localizedControllerType = "Vive Controller";
+            plan.gripPose =
+                Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(8.f), 0, 0}), XrVector3f{0, 0, 0});
+            plan.aimPose = Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(5.f), 0, 0}),
+                                          XrVector3f{0, 0, -0.05f});
+        } else if (request.controllerType == "knuckles") {
+            preferredInteractionProfile = "/interaction_profiles/valve/index_controller";
+            plan.localizedControllerType = "Index Controller";
+            plan.gripPose =
+                Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(20.f), 0, PVR::DegreeToRad(2.f)}),
+                               XrVector3f{0, 0, 0});
+            plan.aimPose =
+                Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(-40.f), PVR::DegreeToRad(-15.f), 0}),
+                               XrVector3f{0, 0, -0.05f});
+        } else if (request.controllerType == "pimax_crystal") {
+            preferredInteractionProfile = "/interaction_profiles/oculus/touch_controller";
+            plan.localizedControllerType = "Crystal Controller";
+            plan.gripPose = Pose::MakePose(Quaternion::RotationRollPitchYaw(
+                                               {PVR::DegreeToRad(40.f), PVR::DegreeToRad(5.f), PVR::DegreeToRad(10.f)}),
+                                           XrVector3f{0, 0, 0});
+            plan.aimPose = Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(-5.f), 0, 0}),
+                                          XrVector3f{0, 0.03f, -0.06f});
+        } else {
+            // Fallback to simple controller.
+            preferredInteractionProfile = "/interaction_profiles/khr/simple_controller";
+            plan.localizedControllerType = "Controller";
+        }
+
+        // Try to map with the preferred bindings.
+        const auto& suggestedBindings = request.suggestedBindings;
+        const auto& forcedInteractionProfile = request.forcedInteractionProfile;
+        auto bindings = suggestedBindings.find(preferredInteractionProfile);
+        if (bindings != suggestedBindings.cend()) {
+            actualInteractionProfile = preferredInteractionProfile;
+        }
+        if (bindings == suggestedBindings.cend() || forcedInteractionProfile) {
+            const bool hasOculusTouchControllerProfile =
+                suggestedBindings.find("/interaction_profiles/oculus/touch_controller") != suggestedBindings.cend();
+            const bool hasMicrosoftMotionControllerProfile =
+                suggestedBindings.find("/interaction_profiles/microsoft/motion_controller") != suggestedBindings.cend();
+
+            // In order of preference.
+            if (forcedInteractionProfile &&
+                forcedInteractionProfile.value() == ForcedInteractionProfile::OculusTouchController &&
+                hasOculusTouchControllerProfile) {
+                actualInteractionProfile = "/interaction_profiles/oculus/touch_controller";
+            } else if (forcedInteractionProfile &&
+                       forcedInteractionProfile.value() == ForcedInteractionProfile::MicrosoftMotionController &&
+                       hasMicrosoftMotionControllerProfile) {
+                actualInteractionProfile = "/interaction_profiles/microsoft/motion_controller";
+            } else if (hasOculusTouchControllerProfile) {
+                actualInteractionProfile = "/interaction_profiles/oculus/touch_controller";
+            } else if (hasMicrosoftMotionControllerProfile) {
+                actualInteractionProfile = "/interaction_profiles/microsoft/motion_controller";
+            } else if (suggestedBindings.find("/interaction_profiles/valve/index_controller") !=
+                       suggestedBindings.cend()) {
+                actualInteractionProfile = "/interaction_profiles/valve/index_controller";
+            } else if (suggestedBindings.find("/interaction_profiles/htc/vive_controller") !=
+                       suggestedBindings.cend()) {
+                actualInteractionProfile = "/interaction_profiles/htc/vive_controller";
+            } else if (suggestedBindings.find("/interaction_profiles/khr/simple_controller") !=
+                       suggestedBindings.cend()) {
+                actualInteractionProfile = "/interaction_profiles/khr/simple_controller";
             }
-            if (bindings == m_suggestedBindings.cend() || m_forcedInteractionProfile) {
-                const bool hasOculusTouchControllerProfile =
-                    m_suggestedBindings.find("/interaction_profiles/oculus/touch_controller") !=
-                    m_suggestedBindings.cend();
-                const bool hasMicrosoftMotionControllerProfile =
-                    m_suggestedBindings.find("/interaction_profiles/microsoft/motion_controller") !=
-                    m_suggestedBindings.cend();
-
-                // In order of preference.
-                if (m_forcedInteractionProfile &&
-                    m_forcedInteractionProfile.value() == ForcedInteractionProfile::OculusTouchController &&
-                    hasOculusTouchControllerProfile) {
-                    actualInteractionProfile = "/interaction_profiles/oculus/touch_controller";
-                } else if (m_forcedInteractionProfile &&
-                           m_forcedInteractionProfile.value() == ForcedInteractionProfile::MicrosoftMotionController &&
-                           hasMicrosoftMotionControllerProfile) {
-                    actualInteractionProfile = "/interaction_profiles/microsoft/motion_controller";
-                } else if (hasOculusTouchControllerProfile) {
-                    actualInteractionProfile = "/interaction_profiles/oculus/touch_controller";
-                } else if (hasMicrosoftMotionControllerProfile) {
-                    actualInteractionProfile = "/interaction_profiles/microsoft/motion_controller";
-                } else if (m_suggestedBindings.find("/interaction_profiles/valve/index_controller") !=
-                           m_suggestedBindings.cend()) {
-                    actualInteractionProfile = "/interaction_profiles/valve/index_controller";
-                } else if (m_suggestedBindings.find("/interaction_profiles/htc/vive_controller") !=
-                           m_suggestedBindings.cend()) {
-                    actualInteractionProfile = "/interaction_profiles/htc/vive_controller";
-                } else if (m_suggestedBindings.find("/interaction_profiles/khr/simple_controller") !=
-                           m_suggestedBindings.cend()) {
-                    actualInteractionProfile = "/interaction_profiles/khr/simple_controller";
-                }
-                if (!actualInteractionProfile.empty()) {
-                    bindings = m_suggestedBindings.find(actualInteractionProfile);
-                }
+            if (!actualInteractionProfile.empty()) {
+                bindings = suggestedBindings.find(actualInteractionProfile);
             }
+        }
 
-            // Map all possible actions sources for this controller.
-            if (bindings != m_suggestedBindings.cend()) {
-                const auto& mapping = m_controllerMappingTable
-                                          .find(std::make_pair(actualInteractionProfile, preferredInteractionProfile))
-                                          ->second;
-                for (const auto& binding : bindings->second) {
-                    if (!m_actions.count(binding.action)) {
-                        continue;
+        // Map all possible actions sources for this controller.
+        if (bindings != suggestedBindings.cend()) {
+            const mappings::Profile suggestedProfile = mappings::findProfile(actualInteractionProfile).value();
+            const mappings::Profile controllerProfile = mappings::findProfile(preferredInteractionProfile).value();
+            const mappings::UserPath user = side == 0 ? mappings::UserPath::HandLeft : mappings::UserPath::HandRight;
+            for (const auto& [suggested, xrAction] : bindings->second) {
+                if (suggested.user != user) {
+                    continue;
+                }
+
+                // Map to the PVR input state.
+                const XrActionSuggestedBinding& binding = suggested.binding;
+                const auto& sourcePath = getXrPath(binding.binding);
+                ActionSource newSource{};
+                if (mapComponentToControllerInputState(
+                        suggestedProfile, controllerProfile, *xrAction, user, suggested.component, newSource)) {
+                    // Avoid duplicates.
+                    bool duplicated = false;
+                    for (const auto& planned : plan.bindings) {
+                        if (planned.action == binding.action && planned.source.realPath == newSource.realPath) {
+                            duplicated = true;
+                            break;
+                        }
                     }
 
-                    const auto& sourcePath = getXrPath(binding.binding);
-                    if (getActionSide(sourcePath) != side) {
-                        continue;
+                    if (!duplicated) {
+                        TraceLoggingWrite(g_traceProvider,
+                                          "xrSyncActions_MapActionSource",
+                                          TLXArg(binding.action, "Action"),
+                                          TLXArg(xrAction->actionSet, "ActionSet"),
+                                          TLArg(sourcePath.c_str(), "ActionPath"),
+                                          TLArg(newSource.realPath.c_str(), "SourcePath"),
+                                          TLArg(!!newSource.buttonMap, "IsButton"),
+                                          TLArg(!!newSource.floatValue, "IsFloat"),
+                                          TLArg(!!newSource.vector2fValue, "IsVector2"));
+
+                        plan.bindings.push_back({binding.action, sourcePath, newSource});
                     }
+                }
+            }
+        }
 
-                    Action& xrAction = *(Action*)binding.action;
-
-                    // Map to the PVR input state.
-                    ActionSource newSource{};
-                    if (mapping(xrAction, binding.binding, newSource)) {
-                        // Avoid duplicates.
-                        bool duplicated = false;
-                        for (const auto& source : xrAction.actionSources) {
-                            if (source.second.realPath == newSource.realPath) {
-                                duplicated = true;
-                                break;
-                            }
-                        }
+        return plan;
+    }
 
-                        if (!duplicated) {
-                            TraceLoggingWrite(g_traceProvider,
-                                              "xrSyncActions_MapActionSource",
-                                              TLXArg(binding.action, "Action"),
-                                              TLXArg(xrAction.actionSet, "ActionSet"),
-                                              TLArg(sourcePath.c_str(), "ActionPath"),
-                                              TLArg(newSource.realPath.c_str(), "SourcePath"),
-                                              TLArg(!!newSource.buttonMap, "IsButton"),
-                                              TLArg(!!newSource.floatValue, "IsFloat"),
-                                              TLArg(!!newSource.vector2fValue, "IsVector2"));
-
-                            // Relocate the pointers to the copy of the input state within the actionset.
-                            const ActionSet& xrActionSet = *(ActionSet*)xrAction.actionSet;
-                            const auto relocatePointer = [&](void* pointer) {
-                                if (!pointer) {
-                                    return (uint8_t*)nullptr;
-                                }
-
-                                uint8_t* p = (uint8_t*)pointer;
-                                uint8_t* oldBase = (uint8_t*)&m_cachedInputState;
-                                uint8_t* newBase = (uint8_t*)&xrActionSet.cachedInputState;
-
-                                return newBase + (p - oldBase);
-                            };
-                            newSource.buttonMap = (uint32_t*)relocatePointer((void*)newSource.buttonMap);
-                            newSource.floatValue = (float*)relocatePointer((void*)newSource.floatValue);
-                            newSource.vector2fValue = (pvrVector2f*)relocatePointer((void*)newSource.vector2fValue);
-
-                            xrAction.actionSources.insert_or_assign(sourcePath, newSource);
-                        }
-                    }
+    // Swap in the bindings for the controller. Must be called with the action lock held exclusively.
+    void OpenXrRuntime::applyRebindPlan(const RebindPlan& plan) {
+        const int side = plan.side;
+
+        // Remove all old bindings for this controller.
+        std::set<Action*> dirtyActions;
+        m_actions.forEach([&](XrAction action, Action& xrAction) {
+            for (auto it = xrAction.actionSources.begin(); it != xrAction.actionSources.end();) {
+                if (getActionSide(it->first) == side) {
+                    it = xrAction.actionSources.erase(it);
+                    dirtyActions.insert(&xrAction);
+                } else {
+                    it++;
                 }
             }
+        });
+
+        for (const auto& binding : plan.bindings) {
+            // The action might have been destroyed while the plan was being built.
+            Action* xrAction = m_actions.get(binding.action);
+            if (!xrAction) {
+                continue;
+            }
+
+            xrAction->actionSources.insert_or_assign(binding.fullPath, binding.source);
+            dirtyActions.insert(xrAction);
+        }
+
+        for (Action* xrAction : dirtyActions) {
+            compileActionSources(*xrAction);
         }
 
+        if (!plan.localizedControllerType.empty()) {
+            m_localizedControllerType[side] = plan.localizedControllerType;
+        }
+
+        // Invalidate the localized names for this controller.
+        m_appliedRebindGeneration[side] = plan.generation;
+
         TraceLoggingWrite(g_traceProvider,
                           "xrSyncActions",
                           TLArg(side == 0 ? "Left" : "Right", "Side"),
-                          TLArg(actualInteractionProfile.c_str(), "InteractionProfile"));
+                          TLArg(plan.interactionProfile.c_str(), "InteractionProfile"));
 
         const auto prevInterationProfile = m_currentInteractionProfile[side];
-        if (!actualInteractionProfile.empty()) {
-            Log("Using interaction profile: %s (%s)\n", actualInteractionProfile.c_str(), side == 0 ? "Left" : "Right");
+        if (!plan.interactionProfile.empty()) {
+            Log("Using interaction profile: %s (%s)\n", plan.interactionProfile.c_str(), side == 0 ? "Left" : "Right");
 
-            m_currentInteractionProfile[side] = stringToPath(actualInteractionProfile.c_str());
+            m_currentInteractionProfile[side] = stringToPath(plan.interactionProfile);
 
-            auto adjustedGripPose = Pose::Multiply(m_controllerGripOffset, gripPose);
-            auto adjustedAimPose = Pose::Multiply(m_controllerAimOffset, aimPose);
+            auto adjustedGripPose = Pose::Multiply(m_controllerGripOffset, plan.gripPose);
+            auto adjustedAimPose = Pose::Multiply(m_controllerAimOffset, plan.aimPose);
             if (side == 1) {
                 const auto flipHandedness = [&](XrPosef& pose) {
                     // Mirror pose along the X axis.
@@ -1543,38 +1744,243 @@ namespace pimax_openxr {
             m_controllerGripPose[side] = m_controllerAimPose[side] = Pose::Identity();
         }
 
+        // Recompose the action spaces with the new pose offsets.
+        {
+            std::unique_lock lock(m_spacesMutex);
+            m_spaces.forEach([&](XrSpace space, Space& xrSpace) {
+                if (xrSpace.action != XR_NULL_HANDLE) {
+                    updateSpaceGraph(xrSpace);
+                }
+            });
+        }
+
         m_currentInteractionProfileDirty =
             m_currentInteractionProfileDirty ||
             (m_currentInteractionProfile[side] != prevInterationProfile && !m_activeActionSets.empty());
     }
 
-    std::string OpenXrRuntime::getXrPath(XrPath path) const {
+    // Queue a rebind for the controller. The plan is built on the rebinding thread and applied by a later
+    // xrSyncActions(), so that the string remapping does not stall the application. Must be called with the action lock
+    // held exclusively.
+    void OpenXrRuntime::requestRebindControllerActions(int side) {
+        RebindRequest request = makeRebindRequest(side);
+
+        std::unique_lock lock(m_rebindingMutex);
+
+        if (!m_rebindingThread.joinable()) {
+            m_terminateRebindingThread = false;
+            m_rebindingThread = std::thread([&]() { rebindingThread(); });
+        }
+
+        // Only the latest request for each side matters.
+        m_pendingRebindRequest[side] = std::move(request);
+        m_rebindingCondVar.notify_one();
+    }
+
+    // Swap in the plans completed since the last sync. Must be called with the action lock held exclusively.
+    void OpenXrRuntime::applyPendingRebindPlans() {
+        std::optional<RebindPlan> plans[2];
+        {
+            std::unique_lock lock(m_rebindingMutex);
+
+            for (uint32_t side = 0; side < 2; side++) {
+                plans[side] = std::move(m_completedRebindPlan[side]);
+                m_completedRebindPlan[side].reset();
+            }
+        }
+
+        for (uint32_t side = 0; side < 2; side++) {
+            // Discard plans made obsolete by a newer request.
+            if (plans[side] && plans[side]->generation == m_rebindGeneration[side]) {
+                applyRebindPlan(plans[side].value());
+            }
+        }
+    }
+
+    void OpenXrRuntime::stopRebindingThread() {
+        if (m_rebindingThread.joinable()) {
+            {
+                std::unique_lock lock(m_rebindingMutex);
+                m_terminateRebindingThread = true;
+                m_rebindingCondVar.notify_one();
+            }
+            m_rebindingThread.join();
+        }
+
+        for (uint32_t side = 0; side < 2; side++) {
+            m_pendingRebindRequest[side].reset();
+            m_completedRebindPlan[side].reset();
+        }
+    }
+
+    void OpenXrRuntime::rebindingThread() {
+        TraceLoggingWrite(g_traceProvider, "RebindingThread", TLArg("Started", "Status"));
+
+        std::unique_lock lock(m_rebindingMutex);
+
+        while (true) {
+            m_rebindingCondVar.wait(lock, [&] {
+                return m_terminateRebindingThread || m_pendingRebindRequest[0] || m_pendingRebindRequest[1];
+            });
+            if (m_terminateRebindingThread) {
+                break;
+            }
+
+            for (uint32_t side = 0; side < 2; side++) {
+                if (!m_pendingRebindRequest[side]) {
+                    continue;
+                }
+
+                const RebindRequest request = std::move(m_pendingRebindRequest[side].value());
+                m_pendingRebindRequest[side].reset();
+
+                lock.unlock();
+                RebindPlan plan = buildRebindPlan(request);
+                TraceLoggingWrite(g_traceProvider,
+                                  "RebindingThread",
+                                  TLArg(side == 0 ? "Left" : "Right", "Side"),
+                                  TLArg(plan.generation, "Generation"),
+                                  TLArg(plan.bindings.size(), "Bindings"));
+                lock.lock();
+
+                m_completedRebindPlan[side] = std::move(plan);
+            }
+        }
+
+        TraceLoggingWrite(g_traceProvider, "RebindingThread", TLArg("Stopped", "Status"));
+    }
+
+    const std::string& OpenXrRuntime::getXrPath(XrPath path) const {
+        static const std::string nullPath;
+        static const std::string unknownPath("<unknown>");
+
         if (path == XR_NULL_PATH) {
-            return "";
+            return nullPath;
         }
 
-        const auto it = m_strings.find(path);
-        if (it == m_strings.cend()) {
-            return "<unknown>";
+        // Strings are never removed from the store, and the deque does not move its elements upon insertion, so the
+        // reference remains valid after releasing the lock.
+        std::shared_lock lock(m_pathsMutex);
+        if (path > m_strings.size()) {
+            return unknownPath;
         }
 
-        return it->second;
+        return m_strings[path - 1];
     }
 
     XrPath OpenXrRuntime::stringToPath(const std::string& path, bool validate) {
-        for (auto entry : m_strings) {
-            if (entry.second == path) {
-                return entry.first;
+        {
+            std::shared_lock lock(m_pathsMutex);
+            const auto it = m_pathIndex.find(path);
+            if (it != m_pathIndex.cend()) {
+                return it->second;
             }
         }
 
-        if (path.length() >= XR_MAX_PATH_LENGTH || !validatePath(path)) {
+        if (path.length() >= XR_MAX_PATH_LENGTH || !mappings::isWellFormedPath(path)) {
             return XR_NULL_PATH;
         }
 
-        m_stringIndex++;
-        m_strings.insert_or_assign(m_stringIndex, path);
-        return (XrPath)m_stringIndex;
+        std::unique_lock lock(m_pathsMutex);
+
+        // Another thread might have inserted the same path while we were not holding the lock.
+        const auto it = m_pathIndex.find(path);
+        if (it != m_pathIndex.cend()) {
+            return it->second;
+        }
+
+        // Paths are handed out sequentially starting from 1, so that the path value is also the index (+1) of the
+        // string in the store. The store is a deque to guarantee that the views used as keys in the index remain valid.
+        const auto& str = m_strings.emplace_back(path);
+        const XrPath newPath = (XrPath)m_strings.size();
+        m_pathIndex.insert_or_assign(std::string_view(str), newPath);
+        return newPath;
+    }
+
+    bool OpenXrRuntime::isKnownPath(XrPath path) const {
+        std::shared_lock lock(m_pathsMutex);
+        return path != XR_NULL_PATH && path <= m_strings.size();
+    }
+
+    void OpenXrRuntime::compileActionSources(Action& xrAction) {
+        xrAction.compiledSources.clear();
+        xrAction.boundSources.clear();
+        for (const auto& [fullPath, source] : xrAction.actionSources) {
+            xrAction.boundSources.push_back(stringToPath(source.realPath));
+
+            CompiledActionSource compiled{};
+            compiled.path = stringToPath(fullPath);
+
+            if (isActionEyeTracker(fullPath)) {
+                compiled.kind = CompiledActionSource::Kind::EyeTrackerPose;
+                compiled.side = 2;
+            } else {
+                // We only support hands paths, not gamepad etc.
+                const int side = getActionSide(fullPath);
+                if (side < 0) {
+                    continue;
+                }
+                compiled.side = (uint8_t)side;
+
+                if (source.buttonMap) {
+                    compiled.kind = CompiledActionSource::Kind::Button;
+                    compiled.offset = getInputStateOffset(source.buttonMap, side);
+                    compiled.buttonMask = source.buttonType;
+                    compiled.buttonWord = (int8_t)((source.buttonMap == &pvrInputState::HandTouches ? 2 : 0) + side);
+                    unsigned long bit = 0;
+                    _BitScanForward(&bit, compiled.buttonMask);
+                    compiled.buttonBit = (uint8_t)bit;
+                } else if (source.floatValue) {
+                    compiled.kind = CompiledActionSource::Kind::Float;
+                    compiled.offset = getInputStateOffset(source.floatValue, side);
+                } else if (source.vector2fValue) {
+                    compiled.kind = CompiledActionSource::Kind::Vector2f;
+                    compiled.offset = getInputStateOffset(source.vector2fValue, side);
+                    compiled.vector2fIndex = (int8_t)source.vector2fIndex;
+                } else if (endsWith(fullPath, "/input/grip/pose")) {
+                    compiled.kind = CompiledActionSource::Kind::GripPose;
+                } else if (endsWith(fullPath, "/input/aim/pose")) {
+                    compiled.kind = CompiledActionSource::Kind::AimPose;
+                } else if (endsWith(fullPath, "/output/haptic")) {
+                    compiled.kind = CompiledActionSource::Kind::Haptic;
+                }
+            }
+
+            xrAction.compiledSources.push_back(compiled);
+        }
+    }
+
+    double OpenXrRuntime::getInputChangeTime(const InputSnapshot& snapshot,
+                                             const CompiledActionSource& source) const {
+        if (!snapshot.hasChangeTimes) {
+            return snapshot.state.TimeInSeconds;
+        }
+
+        double changeTime;
+        if (source.buttonWord >= 0) {
+            changeTime = snapshot.changeTimes.button[source.buttonWord][source.buttonBit];
+        } else {
+            const size_t word = source.offset / sizeof(uint32_t);
+            changeTime = snapshot.changeTimes.field[word];
+            if (source.kind == CompiledActionSource::Kind::Vector2f) {
+                changeTime = std::max(changeTime, snapshot.changeTimes.field[word + 1]);
+            }
+        }
+
+        // No transition was observed since the sampling started.
+        return changeTime > 0 ? changeTime : snapshot.state.TimeInSeconds;
+    }
+
+    int OpenXrRuntime::getSubactionSide(XrPath subactionPath) const {
+        if (subactionPath == m_leftHandPath) {
+            return 0;
+        } else if (subactionPath == m_rightHandPath) {
+            return 1;
+        } else if (subactionPath == m_eyesPath) {
+            return 2;
+        }
+
+        return -1;
     }
 
     int OpenXrRuntime::getActionSide(const std::string& fullPath, bool allowExtraPaths) const {
@@ -1620,6 +2026,7 @@ namespace pimax_openxr {
                     // Recenter view.
                     TraceLoggingWrite(g_traceProvider, "PVR_RecenterTrackingOrigin");
                     CHECK_PVRCMD(pvr_recenterTrackingOrigin(m_pvrSession));
+                    invalidatePoseCache();
                     m_isRecenteringPressed.reset();
                     m_isSystemPressed.reset();
                 }
@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+// Implements a background thread polling the type of the motion controllers. Querying the controller type is a
+// round-trip to the Pimax service, which we do not want to pay for upon every xrSyncActions().
+
+namespace pimax_openxr {
+
+    using namespace pimax_openxr::log;
+    using namespace pimax_openxr::utils;
+
+    namespace {
+
+        constexpr auto k_controllerPollingPeriod = 250ms;
+
+    } // namespace
+
+    void OpenXrRuntime::startControllerPollingThread() {
+        if (m_controllerPollingThread.joinable()) {
+            return;
+        }
+
+        // Poll once synchronously, so that the controllers are known upon the first xrSyncActions().
+        m_lastControllerTypeGeneration[0] = m_lastControllerTypeGeneration[1] = 0;
+        pollControllerTypes();
+
+        m_controllerPollingTerminateEvent.create(wil::EventOptions::ManualReset);
+        m_controllerPollingThread = std::thread([&]() { controllerPollingThread(); });
+    }
+
+    void OpenXrRuntime::stopControllerPollingThread() {
+        if (!m_controllerPollingThread.joinable()) {
+            return;
+        }
+
+        m_controllerPollingTerminateEvent.SetEvent();
+        m_controllerPollingThread.join();
+        m_controllerPollingThread = {};
+        m_controllerPollingTerminateEvent.reset();
+    }
+
+    void OpenXrRuntime::controllerPollingThread() {
+        TraceLoggingWrite(g_traceProvider, "ControllerPollingThread", TLArg("Start", "State"));
+
+        while (!m_controllerPollingTerminateEvent.wait(
+            (DWORD)std::chrono::duration_cast<std::chrono::milliseconds>(k_controllerPollingPeriod).count())) {
+            pollControllerTypes();
+        }
+
+        TraceLoggingWrite(g_traceProvider, "ControllerPollingThread", TLArg("Stop", "State"));
+    }
+
+    void OpenXrRuntime::pollControllerTypes() {
+        bool isActive[2];
+        std::string controllerType[2];
+        for (uint32_t side = 0; side < 2; side++) {
+            const auto device = side == 0 ? pvrTrackedDevice_LeftController : pvrTrackedDevice_RightController;
+            const int size = pvr_getTrackedDeviceStringProperty(
+                m_pvrSession, device, pvrTrackedDeviceProp_ControllerType_String, nullptr, 0);
+            isActive[side] = size > 0;
+            if (isActive[side]) {
+                controllerType[side].resize(size, 0);
+                pvr_getTrackedDeviceStringProperty(m_pvrSession,
+                                                   device,
+                                                   pvrTrackedDeviceProp_ControllerType_String,
+                                                   controllerType[side].data(),
+                                                   (int)controllerType[side].size() + 1);
+                // Remove trailing 0.
+                controllerType[side].resize(size - 1, 0);
+            }
+        }
+
+        std::unique_lock lock(m_controllerPollingMutex);
+
+        bool changed = false;
+        for (uint32_t side = 0; side < 2; side++) {
+            if (isActive[side] != m_polledControllerActive[side] ||
+                controllerType[side] != m_polledControllerType[side]) {
+                m_polledControllerActive[side] = isActive[side];
+                m_polledControllerType[side] = std::move(controllerType[side]);
+                changed = true;
+            }
+        }
+
+        // Always publish the first poll, so that xrSyncActions() picks up the initial state.
+        if (changed || m_controllerTypeGeneration.load(std::memory_order_relaxed) == 0) {
+            TraceLoggingWrite(g_traceProvider,
+                              "PVR_ControllerTypePoll",
+                              TLArg(m_polledControllerType[0].c_str(), "Left"),
+                              TLArg(m_polledControllerType[1].c_str(), "Right"));
+            m_controllerTypeGeneration.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+} // namespace pimax_openxr
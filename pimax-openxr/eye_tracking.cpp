@@ -34,6 +34,15 @@ namespace pimax_openxr {
     using namespace pimax_openxr::utils;
     using namespace xr::math;
 
+    namespace {
+
+        // Experimentally determined that Z should be 0.35m in front for Droolon.
+        XrVector3f pointToUnitVector(const XrVector2f& point, float projectionDistance) {
+            return Normalize({point.x - 0.5f, 0.5f - point.y, -projectionDistance});
+        }
+
+    } // namespace
+
     bool OpenXrRuntime::getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector, double& sampleTime) const {
         if (!m_isEyeTrackingAvailable) {
             return false;
@@ -61,32 +70,35 @@ namespace pimax_openxr {
                 atan((state.GazeTan[xr::StereoView::Left].y + state.GazeTan[xr::StereoView::Right].y) / 2.f);
 
             // Use polar coordinates to create a unit vector.
-            unitVector = {
+            const XrVector3f gazeUnitVector = {
                 sin(angleHorizontal) * cos(angleVertical),
                 -sin(angleVertical),
                 -cos(angleHorizontal) * cos(angleVertical),
             };
 
-            sampleTime = state.TimeInSeconds;
+            // The same sample is returned until the tracker produces a new one.
+            gaze::Sample latest;
+            if (!m_gazeHistory.getLatest(latest) || latest.time != state.TimeInSeconds) {
+                m_gazeHistory.push({state.TimeInSeconds, gazeUnitVector});
+            }
 
         } else if (m_eyeTrackingType == EyeTracking::aSeeVR || m_eyeTrackingType == EyeTracking::Simulated) {
-            XrVector2f point{0.5f, 0.5f};
 #ifndef NOASEEVRCLIENT
             if (m_eyeTrackingType == EyeTracking::aSeeVR) {
-                std::unique_lock lock(m_droolonMutex);
-
+                // The tracker thread publishes its state without locking, so that we never wait on it here.
+                const bool isReady = m_isDroolonReady.load(std::memory_order_acquire);
+                gaze::Sample latest{};
+                m_gazeHistory.getLatest(latest);
                 TraceLoggingWrite(g_traceProvider,
                                   "aSeeVR_EyeTrackerState",
-                                  TLArg(m_isDroolonReady, "Ready"),
-                                  TLArg(xr::ToString(m_droolonGaze).c_str(), "Gaze"),
-                                  TLArg(m_droolonTimestamp, "Timestamp"));
+                                  TLArg(isReady, "Ready"),
+                                  TLArg(xr::ToString(latest.unitVector).c_str(), "Gaze"),
+                                  TLArg(latest.time, "Timestamp"));
 
-                if (!m_isDroolonReady) {
+                // The samples are recorded by aSeeVReyeDataCallback().
+                if (!isReady) {
                     return false;
                 }
-
-                point = m_droolonGaze;
-                sampleTime = m_droolonTimestamp;
             } else
 #endif
             {
@@ -101,23 +113,32 @@ namespace pimax_openxr {
                 POINT pt{};
                 GetCursorPos(&pt);
 
-                point = {(float)pt.x / 1000.f, (1000.f - pt.y) / 1000.f};
-                sampleTime = pvr_getTimeSeconds(m_pvr);
+                const XrVector2f point{(float)pt.x / 1000.f, (1000.f - pt.y) / 1000.f};
+                m_gazeHistory.push({pvr_getTimeSeconds(m_pvr), pointToUnitVector(point, m_droolonProjectionDistance)});
             }
 
-            // Experimentally determined that Z should be 0.35m in front for Droolon.
-            unitVector = Normalize({point.x - 0.5f, 0.5f - point.y, -m_droolonProjectionDistance});
-
         } else {
             return false;
         }
 
+        // Bring the gaze to the requested time, so that it matches where the eyes will be upon display.
+        gaze::Sample sample;
+        if (!m_gazeHistory.sample(xrTimeToPvrTime(time), sample)) {
+            return false;
+        }
+
+        unitVector = sample.unitVector;
+        sampleTime = sample.time;
+
         return true;
     }
 
 #ifndef NOASEEVRCLIENT
     bool OpenXrRuntime::initializeDroolon() {
-        m_isDroolonReady = false;
+        m_isDroolonReady.store(false, std::memory_order_release);
+        // The timestamps of a restarted tracker are not comparable with the previous ones.
+        m_droolonClock.reset();
+        m_gazeHistory.clear();
         aSeeVRInitParam param;
         param.ports[0] = getSetting("droolon_port").value_or(5347);
         {
@@ -174,18 +195,14 @@ namespace pimax_openxr {
     }
 
     void OpenXrRuntime::setDroolonReady(bool ready) {
-        std::unique_lock lock(m_droolonMutex);
-
-        m_isDroolonReady = ready;
+        m_isDroolonReady.store(ready, std::memory_order_release);
     }
 
     void OpenXrRuntime::setDroolonData(int64_t timestamp, const XrVector2f& gaze) {
-        std::unique_lock lock(m_droolonMutex);
-
         // There is no direct translation between the timestamp from the eye tracking service and the rest of the
-        // system. We capture the "time of arrival" as a best effort.
-        m_droolonTimestamp = pvr_getTimeSeconds(m_pvr);
-        m_droolonGaze = gaze;
+        // system. We learn it from the "time of arrival" of the samples.
+        const double sampleTime = m_droolonClock.map(timestamp, pvr_getTimeSeconds(m_pvr));
+        m_gazeHistory.push({sampleTime, pointToUnitVector(gaze, m_droolonProjectionDistance)});
     }
 
     void OpenXrRuntime::aSeeVRgetCoefficientCallback(const aSeeVRCoefficient* data, void* context) {
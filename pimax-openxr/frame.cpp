@@ -207,6 +207,9 @@ namespace pimax_openxr {
                               TLArg(m_frameCompleted, "FrameCompleted"));
         }
 
+        // Warm up the pose cache for the upcoming xrLocateViews() and xrLocateSpace(), outside of the critical section.
+        prefetchDevicePoses(frameState->predictedDisplayTime);
+
         m_telemetry.tick();
 
         TraceLoggingWrite(g_traceProvider,
@@ -449,14 +452,18 @@ namespace pimax_openxr {
                 frameEndInfo->layerCount *
                     (m_primaryViewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO ? 2 : 1) +
                 1);
+
+            // Hold the spaces (and the actions referenced by action spaces) once for all the layers. Other threads may
+            // keep locating spaces meanwhile.
+            std::shared_lock actionsLock(m_actionsMutex);
+            std::shared_lock spacesLock(m_spacesMutex);
             for (uint32_t i = 0; i < frameEndInfo->layerCount; i++) {
                 if (!frameEndInfo->layers[i]) {
                     return XR_ERROR_LAYER_INVALID;
                 }
 
-                std::unique_lock lock3(m_actionsAndSpacesMutex);
-
-                if (!m_spaces.count(frameEndInfo->layers[i]->space)) {
+                Space* const layerSpace = m_spaces.get(frameEndInfo->layers[i]->space);
+                if (!layerSpace) {
                     return XR_ERROR_HANDLE_INVALID;
                 }
 
@@ -534,11 +541,12 @@ namespace pimax_openxr {
                             return XR_ERROR_POSE_INVALID;
                         }
 
-                        if (!m_swapchains.count(proj->views[viewIndex].subImage.swapchain)) {
+                        Swapchain* const viewSwapchain = m_swapchains.get(proj->views[viewIndex].subImage.swapchain);
+                        if (!viewSwapchain) {
                             return XR_ERROR_HANDLE_INVALID;
                         }
 
-                        Swapchain& xrSwapchain = *(Swapchain*)proj->views[viewIndex].subImage.swapchain;
+                        Swapchain& xrSwapchain = *viewSwapchain;
 
                         if (xrSwapchain.lastReleasedIndex == -1) {
                             return XR_ERROR_LAYER_INVALID;
@@ -576,7 +584,7 @@ namespace pimax_openxr {
 
                         // Fill out pose and FOV information.
                         XrPosef layerPose;
-                        locateSpace(*(Space*)proj->space, *m_originSpace, frameEndInfo->displayTime, layerPose);
+                        locateSpace(*layerSpace, *m_originSpace, frameEndInfo->displayTime, layerPose);
                         layer->EyeFov.RenderPose[pvrViewIndex] =
                             xrPoseToPvrPose(Pose::Multiply(proj->views[viewIndex].pose, layerPose));
 
@@ -584,6 +592,7 @@ namespace pimax_openxr {
                         if (m_needFocusFovCorrectionQuirk && viewIndex >= xr::StereoView::Count) {
                             // Quirk for DCS World: the application does not pass the correct FOV for the focus views in
                             // xrEndFrame(). We must keep track of the correct values for each frame.
+                            std::unique_lock fovLock(m_focusFovMutex);
                             const auto& cit = m_focusFovForDisplayTime.find(frameEndInfo->displayTime);
                             if (cit != m_focusFovForDisplayTime.cend()) {
                                 const XrFovf& patchedFov =
@@ -638,11 +647,12 @@ namespace pimax_openxr {
                                         TLArg(depth->maxDepth, "MaxDepth"));
                                     LOG_TELEMETRY_ONCE(logFeature("Depth"));
 
-                                    if (!m_swapchains.count(depth->subImage.swapchain)) {
+                                    Swapchain* const depthSwapchain = m_swapchains.get(depth->subImage.swapchain);
+                                    if (!depthSwapchain) {
                                         return XR_ERROR_HANDLE_INVALID;
                                     }
 
-                                    Swapchain& xrDepthSwapchain = *(Swapchain*)depth->subImage.swapchain;
+                                    Swapchain& xrDepthSwapchain = *depthSwapchain;
 
                                     if (xrDepthSwapchain.lastReleasedIndex == -1) {
                                         return XR_ERROR_LAYER_INVALID;
@@ -711,11 +721,12 @@ namespace pimax_openxr {
                         return XR_ERROR_POSE_INVALID;
                     }
 
-                    if (!m_swapchains.count(quad->subImage.swapchain)) {
+                    Swapchain* const quadSwapchain = m_swapchains.get(quad->subImage.swapchain);
+                    if (!quadSwapchain) {
                         return XR_ERROR_HANDLE_INVALID;
                     }
 
-                    Swapchain& xrSwapchain = *(Swapchain*)quad->subImage.swapchain;
+                    Swapchain& xrSwapchain = *quadSwapchain;
 
                     if (xrSwapchain.lastReleasedIndex == -1) {
                         return XR_ERROR_LAYER_INVALID;
@@ -748,19 +759,16 @@ namespace pimax_openxr {
                     layer->Quad.Viewport.width = quad->subImage.imageRect.extent.width;
                     layer->Quad.Viewport.height = quad->subImage.imageRect.extent.height;
 
-                    if (!m_spaces.count(quad->space)) {
-                        return XR_ERROR_HANDLE_INVALID;
-                    }
-                    Space& xrSpace = *(Space*)quad->space;
+                    Space& xrSpace = *layerSpace;
 
                     // Fill out pose and quad information.
                     if (xrSpace.referenceType != XR_REFERENCE_SPACE_TYPE_VIEW) {
                         XrPosef layerPose;
                         if (!m_needWorldLockedQuadLayerQuirk) {
-                            locateSpace(*(Space*)quad->space, *m_originSpace, frameEndInfo->displayTime, layerPose);
+                            locateSpace(xrSpace, *m_originSpace, frameEndInfo->displayTime, layerPose);
                         } else {
                             // Workaround: use head-locked quads, otherwise PVR seems to misplace them in space.
-                            locateSpace(*(Space*)quad->space, *m_viewSpace, frameEndInfo->displayTime, layerPose);
+                            locateSpace(xrSpace, *m_viewSpace, frameEndInfo->displayTime, layerPose);
                             layer->Header.Flags |= pvrLayerFlag_HeadLocked;
                         }
                         layer->Quad.QuadPoseCenter = xrPoseToPvrPose(Pose::Multiply(quad->pose, layerPose));
@@ -775,6 +783,8 @@ namespace pimax_openxr {
                     return XR_ERROR_LAYER_INVALID;
                 }
             }
+            spacesLock.unlock();
+            actionsLock.unlock();
 
             {
                 // Defer initialization of overlay resources until they are first needed.
@@ -976,6 +986,8 @@ namespace pimax_openxr {
             m_sessionTotalFrameCount++;
 
             if (m_needFocusFovCorrectionQuirk) {
+                std::unique_lock fovLock(m_focusFovMutex);
+
                 // Delete all entries older than 1s.
                 while (!m_focusFovForDisplayTime.empty() &&
                        m_focusFovForDisplayTime.cbegin()->first < frameEndInfo->displayTime - 1'000'000'000) {
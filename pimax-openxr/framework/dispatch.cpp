@@ -82,4 +82,29 @@ namespace RUNTIME_NAMESPACE {
         return result;
     }
 
+    // Vendor extensions are not in the registry, so their entry points cannot be generated.
+    XrResult XRAPI_CALL xrGetActionStatesPIMAX(XrSession session,
+                                               const XrActionStatesGetInfoPIMAX* getInfo,
+                                               XrActionStatesPIMAX* states) {
+        TraceLocalActivity(local);
+        TraceLoggingWriteStart(local, "xrGetActionStatesPIMAX");
+
+        XrResult result;
+        try {
+            result = static_cast<OpenXrRuntime*>(RUNTIME_NAMESPACE::GetInstance())
+                         ->xrGetActionStatesPIMAX(session, getInfo, states);
+        } catch (std::exception& exc) {
+            TraceLoggingWriteTagged(local, "xrGetActionStatesPIMAX_Error", TLArg(exc.what(), "Error"));
+            ErrorLog("xrGetActionStatesPIMAX: %s\n", exc.what());
+            result = XR_ERROR_RUNTIME_FAILURE;
+        }
+
+        TraceLoggingWriteStop(local, "xrGetActionStatesPIMAX", TLArg(xr::ToCString(result), "Result"));
+        if (XR_FAILED(result)) {
+            ErrorLog("xrGetActionStatesPIMAX failed with %s\n", xr::ToCString(result));
+        }
+
+        return result;
+    }
+
 } // namespace RUNTIME_NAMESPACE
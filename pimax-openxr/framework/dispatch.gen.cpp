@@ -1550,6 +1550,27 @@ namespace RUNTIME_NAMESPACE {
 		return result;
 	}
 
+	XrResult XRAPI_CALL xrLocateSpacesKHR(XrSession session, const XrSpacesLocateInfoKHR* locateInfo, XrSpaceLocationsKHR* spaceLocations) {
+		TraceLocalActivity(local);
+		TraceLoggingWriteStart(local, "xrLocateSpacesKHR");
+
+		XrResult result;
+		try {
+			result = RUNTIME_NAMESPACE::GetInstance()->xrLocateSpacesKHR(session, locateInfo, spaceLocations);
+		} catch (std::exception& exc) {
+			TraceLoggingWriteTagged(local, "xrLocateSpacesKHR_Error", TLArg(exc.what(), "Error"));
+			ErrorLog("xrLocateSpacesKHR: %s\n", exc.what());
+			result = XR_ERROR_RUNTIME_FAILURE;
+		}
+
+		TraceLoggingWriteStop(local, "xrLocateSpacesKHR", TLArg(xr::ToCString(result), "Result"));
+		if (XR_FAILED(result)) {
+			ErrorLog("xrLocateSpacesKHR failed with %s\n", xr::ToCString(result));
+		}
+
+		return result;
+	}
+
 
 	// Auto-generated dispatcher handler.
 	XrResult OpenXrApi::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
@@ -1777,6 +1798,9 @@ namespace RUNTIME_NAMESPACE {
 		else if (has_XR_FB_display_refresh_rate && apiName == "xrRequestDisplayRefreshRateFB") {
 			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrRequestDisplayRefreshRateFB);
 		}
+		else if (has_XR_KHR_locate_spaces && apiName == "xrLocateSpacesKHR") {
+			*function = reinterpret_cast<PFN_xrVoidFunction>(RUNTIME_NAMESPACE::xrLocateSpacesKHR);
+		}
 		else {
 			return XR_ERROR_FUNCTION_UNSUPPORTED;
 		}
@@ -1830,6 +1854,12 @@ namespace RUNTIME_NAMESPACE {
 		else if (extensionName == "XR_VARJO_foveated_rendering") {
 			has_XR_VARJO_foveated_rendering = true;
 		}
+		else if (extensionName == "XR_KHR_locate_spaces") {
+			has_XR_KHR_locate_spaces = true;
+		}
+		else if (extensionName == "XR_PIMAX_action_state_batch") {
+			has_XR_PIMAX_action_state_batch = true;
+		}
 
 	}
 
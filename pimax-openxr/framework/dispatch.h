@@ -33,4 +33,8 @@ namespace RUNTIME_NAMESPACE {
                                    const char* name,
                                    PFN_xrVoidFunction* function);
 
+    XrResult XRAPI_CALL xrGetActionStatesPIMAX(XrSession session,
+                                               const XrActionStatesGetInfoPIMAX* getInfo,
+                                               XrActionStatesPIMAX* states);
+
 } // namespace RUNTIME_NAMESPACE
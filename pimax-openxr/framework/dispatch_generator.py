@@ -40,7 +40,8 @@ from xrconventions import OpenXRConventions
 EXCLUDED_API = ['xrGetInstanceProcAddr', 'xrEnumerateApiLayerProperties']
 EXTENSIONS = ['XR_KHR_D3D11_enable', 'XR_KHR_D3D12_enable', 'XR_KHR_vulkan_enable', 'XR_KHR_vulkan_enable2', 'XR_KHR_opengl_enable',
               'XR_KHR_composition_layer_depth', 'XR_KHR_visibility_mask', 'XR_KHR_win32_convert_performance_counter_time', 'XR_FB_display_refresh_rate',
-              'XR_EXT_hand_tracking', 'XR_EXT_hand_joints_motion_range', 'XR_EXT_eye_gaze_interaction', 'XR_VARJO_quad_views', 'XR_VARJO_foveated_rendering']
+              'XR_EXT_hand_tracking', 'XR_EXT_hand_joints_motion_range', 'XR_EXT_eye_gaze_interaction', 'XR_VARJO_quad_views', 'XR_VARJO_foveated_rendering',
+              'XR_KHR_locate_spaces', 'XR_PIMAX_action_state_batch']
 
 class DispatchGenOutputGenerator(AutomaticSourceOutputGenerator):
     '''Common generator utilities and formatting.'''
@@ -0,0 +1,271 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "gaze_history.h"
+
+namespace pimax_openxr::gaze {
+
+    namespace {
+
+        XrVector3f normalize(const XrVector3f& v) {
+            const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+            if (length < 1e-6f) {
+                return {0, 0, -1};
+            }
+            return {v.x / length, v.y / length, v.z / length};
+        }
+
+        // Blend two gaze directions, with t beyond [0, 1] extrapolating. The angles are small enough for a normalized
+        // linear blend.
+        XrVector3f blend(const XrVector3f& a, const XrVector3f& b, double t) {
+            const float s = static_cast<float>(t);
+            return normalize({a.x + (b.x - a.x) * s, a.y + (b.y - a.y) * s, a.z + (b.z - a.z) * s});
+        }
+
+        float angleBetween(const XrVector3f& a, const XrVector3f& b) {
+            return std::acos(std::clamp(a.x * b.x + a.y * b.y + a.z * b.z, -1.f, 1.f));
+        }
+
+    } // namespace
+
+    void History::push(const Sample& sample) {
+        const uint64_t ticket = m_nextTicket.fetch_add(1);
+        Slot& slot = m_slots[ticket % k_historySize];
+
+        // An odd sequence number marks the slot as being written.
+        slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.time.store(sample.time, std::memory_order_relaxed);
+        slot.x.store(sample.unitVector.x, std::memory_order_relaxed);
+        slot.y.store(sample.unitVector.y, std::memory_order_relaxed);
+        slot.z.store(sample.unitVector.z, std::memory_order_relaxed);
+        slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+    }
+
+    bool History::getLatest(Sample& sample) const {
+        const uint64_t nextTicket = m_nextTicket.load(std::memory_order_acquire);
+        const uint64_t firstTicket = getFirstTicket(nextTicket);
+        for (uint64_t ticket = nextTicket; ticket > firstTicket; ticket--) {
+            // The most recent slot might still be being written.
+            if (read(ticket - 1, sample)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void History::clear() {
+        m_clearedTicket.store(m_nextTicket.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    bool History::sample(double time, Sample& sample) const {
+        std::array<Sample, k_historySize> samples;
+        const size_t count = snapshot(samples);
+        if (!count) {
+            return false;
+        }
+
+        const Sample& latest = samples[count - 1];
+        if (time >= latest.time) {
+            sample = latest;
+
+            // Extrapolate the motion since the previous sample.
+            for (size_t i = count - 1; i > 0; i--) {
+                const Sample& previous = samples[i - 1];
+                const double interval = latest.time - previous.time;
+                if (interval <= 0) {
+                    continue;
+                }
+                if (interval <= k_maxSampleInterval) {
+                    const double horizon = std::min(time - latest.time, k_maxExtrapolation);
+                    sample.unitVector = blend(previous.unitVector, latest.unitVector, 1 + horizon / interval);
+                }
+                break;
+            }
+            return true;
+        }
+
+        if (time <= samples[0].time) {
+            sample = samples[0];
+            return true;
+        }
+
+        for (size_t i = 1; i < count; i++) {
+            if (time < samples[i].time) {
+                const Sample& before = samples[i - 1];
+                const Sample& after = samples[i];
+                sample.time = time;
+                sample.unitVector =
+                    blend(before.unitVector, after.unitVector, (time - before.time) / (after.time - before.time));
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool History::read(uint64_t ticket, Sample& sample) const {
+        const Slot& slot = m_slots[ticket % k_historySize];
+
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * ticket + 2) {
+            return false;
+        }
+        sample.time = slot.time.load(std::memory_order_relaxed);
+        sample.unitVector = {slot.x.load(std::memory_order_relaxed),
+                             slot.y.load(std::memory_order_relaxed),
+                             slot.z.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        return slot.sequence.load(std::memory_order_relaxed) == sequence;
+    }
+
+    size_t History::snapshot(std::array<Sample, k_historySize>& samples) const {
+        const uint64_t nextTicket = m_nextTicket.load(std::memory_order_acquire);
+        const uint64_t firstTicket = getFirstTicket(nextTicket);
+
+        size_t count = 0;
+        for (uint64_t ticket = firstTicket; ticket < nextTicket; ticket++) {
+            if (read(ticket, samples[count])) {
+                count++;
+            }
+        }
+
+        // Concurrent producers may publish slightly out of order.
+        std::stable_sort(samples.begin(), samples.begin() + count, [](const Sample& a, const Sample& b) {
+            return a.time < b.time;
+        });
+
+        return count;
+    }
+
+    uint64_t History::getFirstTicket(uint64_t nextTicket) const {
+        const uint64_t firstTicket = nextTicket > k_historySize ? nextTicket - k_historySize : 0;
+        return std::max(firstTicket, m_clearedTicket.load(std::memory_order_acquire));
+    }
+
+    double ClockMapping::map(int64_t timestamp, double arrivalTime) {
+        if (timestamp <= 0) {
+            return arrivalTime;
+        }
+
+        // The tracker was restarted.
+        if (timestamp < m_lastTimestamp) {
+            reset();
+        }
+        m_lastTimestamp = timestamp;
+
+        if (!m_firstTimestamp) {
+            m_firstTimestamp = timestamp;
+            m_firstArrivalTime = arrivalTime;
+        }
+
+        if (!isCalibrated()) {
+            if (arrivalTime - m_firstArrivalTime < k_calibrationPeriod || timestamp == m_firstTimestamp) {
+                return arrivalTime;
+            }
+
+            // The trackers count in power-of-ten fractions of a second. Snap to the nearest one, since the arrival
+            // times are jittery.
+            const double measured = (arrivalTime - m_firstArrivalTime) / (timestamp - m_firstTimestamp);
+            m_secondsPerTick = std::pow(10.0, std::round(std::log10(measured)));
+        }
+
+        // A sample cannot arrive before it was taken, so the smallest latency observed is the best estimate of the
+        // offset between both clocks.
+        const double elapsed = (timestamp - m_firstTimestamp) * m_secondsPerTick;
+        m_offset = std::min(m_offset, arrivalTime - elapsed);
+
+        return m_offset + elapsed;
+    }
+
+    void ClockMapping::reset() {
+        m_firstTimestamp = m_lastTimestamp = 0;
+        m_firstArrivalTime = 0;
+        m_secondsPerTick = 0;
+        m_offset = INFINITY;
+    }
+
+    FocusRegion FocusStabilizer::update(double time, const XrVector3f& unitVector, double sampleTime) {
+        if (m_state != State::None && time <= m_lastTime) {
+            return m_region;
+        }
+
+        if (m_state == State::None) {
+            startFixation(time, unitVector);
+        } else {
+            // The jitter of the tracker alone can exceed the velocity threshold between two close samples, so a
+            // saccade must also leave the region.
+            const double velocity = angleBetween(m_lastGaze, unitVector) / (time - m_lastTime);
+            const float distance = angleBetween(m_region.unitVector, unitVector);
+            if (velocity > k_saccadeVelocity && distance > k_fixationRadius) {
+                m_state = State::Saccade;
+                m_lastSaccadeTime = time;
+            } else {
+                if (m_state == State::Saccade || distance > k_fixationRadius) {
+                    // The new fixation starts where the saccade landed, or follows a slow drift (or a pursuit) once it
+                    // leaves the region.
+                    startFixation(time, unitVector);
+                } else if (time - m_fixationStartTime < k_settleDuration) {
+                    m_fixationSum = {m_fixationSum.x + unitVector.x,
+                                     m_fixationSum.y + unitVector.y,
+                                     m_fixationSum.z + unitVector.z};
+                    m_region.unitVector = normalize(m_fixationSum);
+                }
+            }
+
+            if (m_state == State::Saccade) {
+                m_region.unitVector = unitVector;
+            }
+        }
+        m_lastTime = time;
+        m_lastGaze = unitVector;
+
+        double confidence =
+            m_state == State::Saccade ? 0.0 : std::min((time - m_lastSaccadeTime) / k_settleDuration, 1.0);
+        const double age = time - sampleTime;
+        if (age > k_maxSampleAge) {
+            confidence *= std::max(1.0 - (age - k_maxSampleAge) / k_maxSampleAge, 0.0);
+        }
+        m_region.confidence = static_cast<float>(confidence);
+
+        return m_region;
+    }
+
+    void FocusStabilizer::startFixation(double time, const XrVector3f& unitVector) {
+        m_state = State::Fixation;
+        m_fixationStartTime = time;
+        m_fixationSum = unitVector;
+        m_region.unitVector = unitVector;
+    }
+
+    void FocusStabilizer::reset() {
+        m_state = State::None;
+        m_lastTime = 0;
+        m_lastSaccadeTime = -INFINITY;
+        m_fixationStartTime = 0;
+        m_fixationSum = {0, 0, 0};
+        m_region = {};
+    }
+
+} // namespace pimax_openxr::gaze
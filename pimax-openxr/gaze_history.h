@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// The eye trackers deliver gaze samples at their own rate, on their own threads, while the application asks for the
+// gaze at the (future) display time. The history keeps the recent samples on the PVR clock, so that a query can
+// interpolate between them, or extrapolate the latest motion a bounded amount.
+
+namespace pimax_openxr::gaze {
+
+    struct Sample {
+        double time{0}; // PVR time, in seconds.
+        XrVector3f unitVector{0, 0, -1};
+    };
+
+    // A ring of samples that producers and consumers access without locking. Each slot is published with its own
+    // sequence number, so that a reader never uses a slot that is being overwritten.
+    class History {
+      public:
+        // About 130ms of history at 240Hz.
+        static constexpr size_t k_historySize = 32;
+
+        // How far past the latest sample the gaze motion is extrapolated. Beyond, the gaze is held.
+        static constexpr double k_maxExtrapolation = 0.02;
+
+        // Samples further apart are not used to estimate the gaze motion.
+        static constexpr double k_maxSampleInterval = 0.1;
+
+        // Can be called concurrently from any thread.
+        void push(const Sample& sample);
+
+        bool getLatest(Sample& sample) const;
+
+        // Forget the samples pushed so far (eg: when the tracker restarts with a new clock). A sample being pushed
+        // concurrently may be forgotten too.
+        void clear();
+
+        // Interpolate, or extrapolate, the gaze at the given PVR time. The time of the returned sample is the time of
+        // the gaze it describes, which is the time of the latest sample when extrapolating. Returns false when there is
+        // no sample.
+        bool sample(double time, Sample& sample) const;
+
+      private:
+        struct Slot {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<double> time{0};
+            std::atomic<float> x{0};
+            std::atomic<float> y{0};
+            std::atomic<float> z{0};
+        };
+
+        // Returns false if the slot does not (or no longer) hold the sample for that ticket.
+        bool read(uint64_t ticket, Sample& sample) const;
+
+        // Copy the readable samples in chronological order. Returns the number of samples.
+        size_t snapshot(std::array<Sample, k_historySize>& samples) const;
+
+        // The oldest ticket that can still be read, given the next ticket.
+        uint64_t getFirstTicket(uint64_t nextTicket) const;
+
+        std::array<Slot, k_historySize> m_slots;
+        std::atomic<uint64_t> m_nextTicket{0};
+        std::atomic<uint64_t> m_clearedTicket{0};
+    };
+
+    // Maps the timestamps of an external tracker (in unknown units and from an unknown epoch) onto the PVR clock.
+    // The units are calibrated from the arrival times of the samples, and the offset is the smallest observed latency.
+    // Not thread-safe: meant to be called from the thread delivering the samples.
+    class ClockMapping {
+      public:
+        // Observe the arrival of a sample, and return the time it was taken on the PVR clock. Until the mapping is
+        // calibrated, this is the arrival time.
+        double map(int64_t timestamp, double arrivalTime);
+
+        void reset();
+
+        bool isCalibrated() const {
+            return m_secondsPerTick > 0;
+        }
+
+      private:
+        // The duration over which the units are measured.
+        static constexpr double k_calibrationPeriod = 1.0;
+
+        int64_t m_firstTimestamp{0};
+        int64_t m_lastTimestamp{0};
+        double m_firstArrivalTime{0};
+        double m_secondsPerTick{0};
+        double m_offset{INFINITY};
+    };
+
+    // The focus region derived from the gaze.
+    struct FocusRegion {
+        XrVector3f unitVector{0, 0, -1};
+
+        // How much the gaze can be trusted to stay within the region, from 0 (in flight, or stale) to 1 (fixation).
+        float confidence{0};
+    };
+
+    // Stabilizes the focus region of foveated rendering. The gaze jitters during a fixation, and moving the focus
+    // region along with it makes the application re-render a shifted inset for no benefit. Each gaze is classified by
+    // its angular velocity: during a fixation the region is held, during a saccade it snaps to the gaze. The
+    // confidence drops during a saccade and for a short while after, or when the gaze is stale, so that the region
+    // can be widened only then. It only depends on its inputs, so that recorded gaze traces can be replayed through
+    // it.
+    class FocusStabilizer {
+      public:
+        // Above that angular velocity (radians per second), the eye is in a saccade.
+        static constexpr double k_saccadeVelocity = 75.0 * 3.14159265358979323846 / 180.0;
+
+        // The gaze may wander that far (in radians) from the held region during a fixation.
+        static constexpr float k_fixationRadius = 1.5f * 3.14159265358979323846f / 180.f;
+
+        // The time it takes for the confidence to recover after a saccade.
+        static constexpr double k_settleDuration = 0.1;
+
+        // Past that age (in seconds), the confidence decreases until reaching zero at twice the age.
+        static constexpr double k_maxSampleAge = 0.05;
+
+        // Feed the gaze for the given time, measured by the eye tracker at sampleTime. Times that are not newer than
+        // the previous one return the previous region, since the same frame may be located multiple times.
+        FocusRegion update(double time, const XrVector3f& unitVector, double sampleTime);
+
+        void reset();
+
+      private:
+        enum class State {
+            None,
+            Fixation,
+            Saccade,
+        };
+
+        // Start holding the region at the gaze.
+        void startFixation(double time, const XrVector3f& unitVector);
+
+        State m_state{State::None};
+        double m_lastTime{0};
+        XrVector3f m_lastGaze{0, 0, -1};
+        double m_lastSaccadeTime{-INFINITY};
+
+        // The region is the average of the gaze during the first k_settleDuration of the fixation, rather than a
+        // single (jittery) sample.
+        double m_fixationStartTime{0};
+        XrVector3f m_fixationSum{0, 0, 0};
+
+        FocusRegion m_region;
+    };
+
+} // namespace pimax_openxr::gaze
@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "hand_skeleton.h"
+
+namespace pimax_openxr::hands {
+
+    using namespace xr::math;
+
+    void getSkeletonJoints(const pvrSkeletalData& skeletalData,
+                           int side,
+                           extrapolation::SkeletonExtrapolator::Joints& joints) {
+        const DirectX::XMVECTOR fingerCorrection = LoadXrQuaternion(k_fingerCorrection[side]);
+        const DirectX::XMVECTOR wristCorrection = LoadXrQuaternion(k_wristCorrection[side]);
+
+        // We must apply the transforms in order of the bone structure:
+        // https://github.com/ValveSoftware/openvr/wiki/Hand-Skeleton#bone-structure
+        // The chain is kept in registers, rather than going through Pose::Multiply() for each bone.
+        DirectX::XMVECTOR barycenter = DirectX::XMVectorZero();
+        DirectX::XMVECTOR orientation = DirectX::XMQuaternionIdentity();
+        DirectX::XMVECTOR position = DirectX::XMVectorZero();
+        DirectX::XMVECTOR wristOrientation = orientation;
+        DirectX::XMVECTOR wristPosition = position;
+        for (uint32_t i = 0; i < XR_HAND_JOINT_COUNT_EXT; i++) {
+            const pvrPosef& bone = skeletalData.boneTransforms[i];
+            const XrVector3f bonePosition{bone.Position.x, bone.Position.y, bone.Position.z};
+            const XrQuaternionf boneOrientation{
+                bone.Orientation.x, bone.Orientation.y, bone.Orientation.z, bone.Orientation.w};
+            position = DirectX::XMVectorAdd(DirectX::XMVector3Rotate(LoadXrVector3(bonePosition), orientation),
+                                            position);
+            orientation = DirectX::XMQuaternionMultiply(LoadXrQuaternion(boneOrientation), orientation);
+
+            // Palm is estimated after this loop.
+            if (i != XR_HAND_JOINT_PALM_EXT) {
+                StoreXrQuaternion(&joints[i].orientation,
+                                  DirectX::XMQuaternionMultiply(
+                                      i != XR_HAND_JOINT_WRIST_EXT ? fingerCorrection : wristCorrection,
+                                      orientation));
+                StoreXrVector3(&joints[i].position, position);
+            }
+
+            switch (i) {
+            case XR_HAND_JOINT_WRIST_EXT:
+                wristOrientation = orientation;
+                wristPosition = position;
+                break;
+
+            case XR_HAND_JOINT_INDEX_METACARPAL_EXT:
+            case XR_HAND_JOINT_INDEX_PROXIMAL_EXT:
+            case XR_HAND_JOINT_MIDDLE_METACARPAL_EXT:
+            case XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT:
+            case XR_HAND_JOINT_RING_METACARPAL_EXT:
+            case XR_HAND_JOINT_RING_PROXIMAL_EXT:
+            case XR_HAND_JOINT_LITTLE_METACARPAL_EXT:
+            case XR_HAND_JOINT_LITTLE_PROXIMAL_EXT:
+                barycenter = DirectX::XMVectorAdd(barycenter, position);
+                break;
+
+            // Reset to the wrist base pose once we reach the tip.
+            case XR_HAND_JOINT_THUMB_TIP_EXT:
+            case XR_HAND_JOINT_INDEX_TIP_EXT:
+            case XR_HAND_JOINT_MIDDLE_TIP_EXT:
+            case XR_HAND_JOINT_RING_TIP_EXT:
+            case XR_HAND_JOINT_LITTLE_TIP_EXT:
+                orientation = wristOrientation;
+                position = wristPosition;
+                break;
+            }
+        }
+
+        // SteamVR doesn't have palm, we compute the barycenter of the metacarpal and proximal for
+        // index/middle/ring/little fingers.
+        joints[XR_HAND_JOINT_PALM_EXT].orientation = joints[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT].orientation;
+        StoreXrVector3(&joints[XR_HAND_JOINT_PALM_EXT].position, DirectX::XMVectorScale(barycenter, 1.f / 8.f));
+    }
+
+    void composeJoints(const extrapolation::SkeletonExtrapolator::Joints& joints,
+                       const XrPosef& controllerPose,
+                       extrapolation::SkeletonExtrapolator::Joints& jointsToVirtual) {
+        const DirectX::XMVECTOR controllerOrientation = LoadXrQuaternion(controllerPose.orientation);
+        const DirectX::XMVECTOR controllerPosition = LoadXrVector3(controllerPose.position);
+        for (size_t i = 0; i < joints.size(); i++) {
+            StoreXrQuaternion(
+                &jointsToVirtual[i].orientation,
+                DirectX::XMQuaternionMultiply(LoadXrQuaternion(joints[i].orientation), controllerOrientation));
+            StoreXrVector3(&jointsToVirtual[i].position,
+                           DirectX::XMVectorAdd(DirectX::XMVector3Rotate(LoadXrVector3(joints[i].position),
+                                                                         controllerOrientation),
+                                                controllerPosition));
+        }
+    }
+
+} // namespace pimax_openxr::hands
@@ -0,0 +1,53 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pose_extrapolation.h"
+
+// PVR reports the hand skeleton as the bone transforms of SteamVR, each relative to its parent bone and with the axes
+// conventions of SteamVR. These are composed into the OpenXR joints relative to the controller, then moved along with
+// the controller for each base space.
+
+namespace pimax_openxr::hands {
+
+    // The rotations converting from what SteamVR expects to what OpenXR expects, indexed by side. These are
+    // Quaternion::RotationRollPitchYaw() of {0 or 180, -90, 180} degrees for the fingers and {180, 0, -90 or 90}
+    // degrees for the wrist.
+    constexpr float k_halfSqrt2 = 0.70710678f;
+    constexpr XrQuaternionf k_fingerCorrection[2] = {{-k_halfSqrt2, 0.f, k_halfSqrt2, 0.f},
+                                                     {0.f, -k_halfSqrt2, 0.f, -k_halfSqrt2}};
+    constexpr XrQuaternionf k_wristCorrection[2] = {{k_halfSqrt2, k_halfSqrt2, 0.f, 0.f},
+                                                    {k_halfSqrt2, -k_halfSqrt2, 0.f, 0.f}};
+
+    // Compose the skeleton reported by PVR into the joints relative to the controller.
+    void getSkeletonJoints(const pvrSkeletalData& skeletalData,
+                           int side,
+                           extrapolation::SkeletonExtrapolator::Joints& joints);
+
+    // Move all the joints along with the controller, equivalent to Pose::Multiply(joint, controllerPose) with the
+    // controller pose only loaded once.
+    void composeJoints(const extrapolation::SkeletonExtrapolator::Joints& joints,
+                       const XrPosef& controllerPose,
+                       extrapolation::SkeletonExtrapolator::Joints& jointsToVirtual);
+
+} // namespace pimax_openxr::hands
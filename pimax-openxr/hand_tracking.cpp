@@ -66,13 +66,11 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_handTrackersMutex);
 
-        HandTracker& xrHandTracker = *new HandTracker;
+        // Create the internal struct. The table also maintains the list of known trackers for validation.
+        auto [newHandTracker, xrHandTracker] = m_handTrackers.emplace();
         xrHandTracker.side = createInfo->hand == XR_HAND_LEFT_EXT ? 0 : 1;
 
-        *handTracker = (XrHandTrackerEXT)&xrHandTracker;
-
-        // Maintain a list of known trackers for validation.
-        m_handTrackers.insert(*handTracker);
+        *handTracker = newHandTracker;
 
         TraceLoggingWrite(g_traceProvider, "xrCreateHandTrackerEXT", TLXArg(*handTracker, "HandTracker"));
 
@@ -89,13 +87,10 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_handTrackersMutex);
 
-        if (!m_handTrackers.count(handTracker)) {
+        if (!m_handTrackers.contains(handTracker)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        HandTracker* xrHandTracker = (HandTracker*)handTracker;
-
-        delete xrHandTracker;
         m_handTrackers.erase(handTracker);
 
         return XR_SUCCESS;
@@ -120,9 +115,11 @@ namespace pimax_openxr {
             return XR_ERROR_FUNCTION_UNSUPPORTED;
         }
 
+        std::shared_lock actionsLock(m_actionsMutex);
+        std::shared_lock spacesLock(m_spacesMutex);
         std::unique_lock lock(m_handTrackersMutex);
 
-        if (!m_handTrackers.count(handTracker) || !m_spaces.count(locateInfo->baseSpace)) {
+        if (!m_handTrackers.contains(handTracker) || !m_spaces.contains(locateInfo->baseSpace)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -150,7 +147,7 @@ namespace pimax_openxr {
             return XR_ERROR_VALIDATION_FAILURE;
         }
 
-        HandTracker& xrHandTracker = *(HandTracker*)handTracker;
+        HandTracker& xrHandTracker = *m_handTrackers.get(handTracker);
 
         pvrSkeletalMotionRange range = pvrSkeletalMotionRange_WithoutController;
         if (motionRange) {
@@ -159,83 +156,126 @@ namespace pimax_openxr {
                         : pvrSkeletalMotionRange_WithController;
         }
 
-        Space& xrBaseSpace = *(Space*)locateInfo->baseSpace;
+        Space& xrBaseSpace = *m_spaces.get(locateInfo->baseSpace);
 
         XrPosef baseSpaceToVirtual = Pose::Identity();
-        XrPosef basePose = Pose::Identity();
-        const auto flags1 = locateSpaceToOrigin(xrBaseSpace, locateInfo->time, baseSpaceToVirtual, nullptr, nullptr);
-        const auto flags2 = getControllerPose(xrHandTracker.side, locateInfo->time, basePose, nullptr);
-
-        pvrSkeletalData skeletalData{};
-        const auto result = pvr_getSkeletalData(m_pvrSession,
-                                                xrHandTracker.side == 0 ? pvrTrackedDevice_LeftController
-                                                                        : pvrTrackedDevice_RightController,
-                                                range,
-                                                &skeletalData);
-        if (result == pvr_not_support || skeletalData.boneCount == 0) {
-            TraceLoggingWrite(g_traceProvider,
-                              "PVR_SkeletalData",
-                              TLArg(xrHandTracker.side == 0 ? "Left" : "Right", "Side"),
-                              TLArg(xr::ToString(result).c_str(), "Result"),
-                              TLArg(skeletalData.boneCount, "Count"));
-
-            // This is how we detect no hands presence.
-            locations->isActive = XR_FALSE;
+        XrSpaceVelocity baseSpaceToVirtualVelocity{XR_TYPE_SPACE_VELOCITY};
+        XrPosef controllerPose = Pose::Identity();
+        XrSpaceVelocity controllerVelocity{XR_TYPE_SPACE_VELOCITY};
+        const auto flags1 = locateSpaceToOrigin(xrBaseSpace,
+                                                locateInfo->time,
+                                                baseSpaceToVirtual,
+                                                velocities ? &baseSpaceToVirtualVelocity : nullptr,
+                                                nullptr);
+        const auto flags2 = getControllerPose(
+            xrHandTracker.side, locateInfo->time, controllerPose, velocities ? &controllerVelocity : nullptr);
+
+        // The skeletons of both motion ranges do not follow each other.
+        if (range != xrHandTracker.motionRange) {
+            xrHandTracker.skeleton.clearHistory();
+            xrHandTracker.motionRange = range;
+        }
 
-        } else {
-            CHECK_PVRCMD(result);
-
-            // We rely on PVR using the same definitions as SteamVR, which turn out to be share (almost) the same first
-            // 26 joints with the OpenXr definitions. https://github.com/ValveSoftware/openvr/wiki/Hand-Skeleton
-            TraceLoggingWrite(
-                g_traceProvider,
-                "PVR_SkeletalData",
-                TLArg(xrHandTracker.side == 0 ? "Left" : "Right", "Side"),
-                TLArg(skeletalData.boneCount, "Count"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[0]).c_str(), "Root"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_WRIST_EXT]).c_str(), "Wrist"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_METACARPAL_EXT]).c_str(),
-                      "ThumbMetacarpal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_PROXIMAL_EXT]).c_str(),
-                      "ThumbProximal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_DISTAL_EXT]).c_str(), "ThumbDistal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_TIP_EXT]).c_str(), "ThumbTip"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_METACARPAL_EXT]).c_str(),
-                      "IndexMetacarpal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_PROXIMAL_EXT]).c_str(),
-                      "IndexProximal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_INTERMEDIATE_EXT]).c_str(),
-                      "IndexIntermediate"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_DISTAL_EXT]).c_str(), "IndexDistal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_TIP_EXT]).c_str(), "IndexTip"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT]).c_str(),
-                      "MiddleMetacarpal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT]).c_str(),
-                      "MiddleProximal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_INTERMEDIATE_EXT]).c_str(),
-                      "MiddleIntermediate"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_DISTAL_EXT]).c_str(),
-                      "MiddleDistal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_TIP_EXT]).c_str(), "MiddleTip"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_METACARPAL_EXT]).c_str(),
-                      "RingMetacarpal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_PROXIMAL_EXT]).c_str(),
-                      "RingProximal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_INTERMEDIATE_EXT]).c_str(),
-                      "RingIntermediate"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_DISTAL_EXT]).c_str(), "RingDistal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_TIP_EXT]).c_str(), "RingTip"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_METACARPAL_EXT]).c_str(),
-                      "LittleMetacarpal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_PROXIMAL_EXT]).c_str(),
-                      "LittleProximal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_INTERMEDIATE_EXT]).c_str(),
-                      "LittleIntermediate"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_DISTAL_EXT]).c_str(),
-                      "LittleDistal"),
-                TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_TIP_EXT]).c_str(), "LittleTip"));
+        // The skeleton does not depend on the base space, so we only query it once per frame for each hand.
+        uint64_t epoch;
+        {
+            std::unique_lock lock(m_poseCacheMutex);
+            epoch = m_poseCacheEpoch;
+        }
+        const int side = xrHandTracker.side;
+        SkeletalCacheEntry& skeleton = m_skeletalCache[side];
+        if (skeleton.epoch != epoch || skeleton.time != locateInfo->time || skeleton.motionRange != range) {
+            pvrSkeletalData skeletalData{};
+            const auto result = pvr_getSkeletalData(m_pvrSession,
+                                                    side == 0 ? pvrTrackedDevice_LeftController
+                                                              : pvrTrackedDevice_RightController,
+                                                    range,
+                                                    &skeletalData);
+            if (result == pvr_not_support || skeletalData.boneCount == 0) {
+                TraceLoggingWrite(g_traceProvider,
+                                  "PVR_SkeletalData",
+                                  TLArg(side == 0 ? "Left" : "Right", "Side"),
+                                  TLArg(xr::ToString(result).c_str(), "Result"),
+                                  TLArg(skeletalData.boneCount, "Count"));
+
+                // This is how we detect no hands presence.
+                skeleton.isActive = false;
+
+            } else {
+                CHECK_PVRCMD(result);
+
+                // We rely on PVR using the same definitions as SteamVR, which turn out to be share (almost) the same
+                // first 26 joints with the OpenXr definitions.
+                // https://github.com/ValveSoftware/openvr/wiki/Hand-Skeleton
+                TraceLoggingWrite(
+                    g_traceProvider,
+                    "PVR_SkeletalData",
+                    TLArg(side == 0 ? "Left" : "Right", "Side"),
+                    TLArg(skeletalData.boneCount, "Count"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[0]).c_str(), "Root"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_WRIST_EXT]).c_str(), "Wrist"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_METACARPAL_EXT]).c_str(),
+                          "ThumbMetacarpal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_PROXIMAL_EXT]).c_str(),
+                          "ThumbProximal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_DISTAL_EXT]).c_str(),
+                          "ThumbDistal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_THUMB_TIP_EXT]).c_str(), "ThumbTip"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_METACARPAL_EXT]).c_str(),
+                          "IndexMetacarpal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_PROXIMAL_EXT]).c_str(),
+                          "IndexProximal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_INTERMEDIATE_EXT]).c_str(),
+                          "IndexIntermediate"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_DISTAL_EXT]).c_str(),
+                          "IndexDistal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_INDEX_TIP_EXT]).c_str(), "IndexTip"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT]).c_str(),
+                          "MiddleMetacarpal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT]).c_str(),
+                          "MiddleProximal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_INTERMEDIATE_EXT]).c_str(),
+                          "MiddleIntermediate"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_DISTAL_EXT]).c_str(),
+                          "MiddleDistal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_MIDDLE_TIP_EXT]).c_str(), "MiddleTip"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_METACARPAL_EXT]).c_str(),
+                          "RingMetacarpal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_PROXIMAL_EXT]).c_str(),
+                          "RingProximal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_INTERMEDIATE_EXT]).c_str(),
+                          "RingIntermediate"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_DISTAL_EXT]).c_str(),
+                          "RingDistal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_RING_TIP_EXT]).c_str(), "RingTip"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_METACARPAL_EXT]).c_str(),
+                          "LittleMetacarpal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_PROXIMAL_EXT]).c_str(),
+                          "LittleProximal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_INTERMEDIATE_EXT]).c_str(),
+                          "LittleIntermediate"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_DISTAL_EXT]).c_str(),
+                          "LittleDistal"),
+                    TLArg(xr::ToString(skeletalData.boneTransforms[XR_HAND_JOINT_LITTLE_TIP_EXT]).c_str(),
+                          "LittleTip"));
+
+                // PVR does not tell when the skeleton was sampled, so we stamp it when we first see it.
+                hands::getSkeletonJoints(skeletalData, side, skeleton.joints);
+                skeleton.sampleTime = pvrTimeToXrTime(pvr_getTimeSeconds(m_pvr));
+                skeleton.isActive = true;
+            }
+
+            skeleton.epoch = epoch;
+            skeleton.time = locateInfo->time;
+            skeleton.motionRange = range;
+        }
 
+        if (skeleton.isActive) {
+            xrHandTracker.skeleton.addSample(skeleton.sampleTime, skeleton.joints);
             locations->isActive = XR_TRUE;
+        } else {
+            xrHandTracker.skeleton.clearHistory();
+            locations->isActive = XR_FALSE;
         }
 
         // If base space pose is not valid, we cannot locate.
@@ -255,83 +295,71 @@ namespace pimax_openxr {
             return XR_SUCCESS;
         }
 
-        // We must apply the transforms in order of the bone structure:
-        // https://github.com/ValveSoftware/openvr/wiki/Hand-Skeleton#bone-structure
-        XrVector3f barycenter{};
-        XrPosef accumulatedPose = basePose;
-        XrPosef wristPose;
+        // Bring the skeleton to the requested time, then move it along with the controller.
+        extrapolation::SkeletonExtrapolator::Joints joints;
+        extrapolation::SkeletonExtrapolator::Velocities jointAngularVelocities;
+        extrapolation::SkeletonExtrapolator::Velocities jointLinearVelocities;
+        bool hasJointVelocities = false;
+        xrHandTracker.skeleton.extrapolate(locateInfo->time,
+                                           joints,
+                                           velocities ? &jointAngularVelocities : nullptr,
+                                           velocities ? &jointLinearVelocities : nullptr,
+                                           hasJointVelocities);
+
+        extrapolation::SkeletonExtrapolator::Joints jointsToVirtual;
+        hands::composeJoints(joints, controllerPose, jointsToVirtual);
+
+        const XrPosef virtualToBaseSpace = Pose::Invert(baseSpaceToVirtual);
         for (uint32_t i = 0; i < locations->jointCount; i++) {
-            accumulatedPose = Pose::Multiply(pvrPoseToXrPose(skeletalData.boneTransforms[i]), accumulatedPose);
-
-            // Palm is estimated after this loop.
-            if (i != XR_HAND_JOINT_PALM_EXT) {
-                locations->jointLocations[i].radius = 0.005f;
-
-                // We need extra rotations to convert from what SteamVR expects to what OpenXR expects.
-                XrPosef correctedPose;
-                if (i != XR_HAND_JOINT_WRIST_EXT) {
-                    correctedPose =
-                        Pose::Multiply(Pose::MakePose(Quaternion::RotationRollPitchYaw(
-                                                          {PVR::DegreeToRad(!xrHandTracker.side ? 0.f : 180.f),
-                                                           PVR::DegreeToRad(-90.f),
-                                                           PVR::DegreeToRad(180.f)}),
-                                                      XrVector3f{0, 0, 0}),
-                                       accumulatedPose);
-                } else {
-                    correctedPose =
-                        Pose::Multiply(Pose::MakePose(Quaternion::RotationRollPitchYaw(
-                                                          {PVR::DegreeToRad(180.f),
-                                                           PVR::DegreeToRad(0.f),
-                                                           PVR::DegreeToRad(!xrHandTracker.side ? -90.f : 90.f)}),
-                                                      XrVector3f{0, 0, 0}),
-                                       accumulatedPose);
+            const XrPosef& jointToVirtual = jointsToVirtual[i];
+
+            XrSpaceVelocity jointToVirtualVelocity{XR_TYPE_SPACE_VELOCITY};
+            if (velocities && hasJointVelocities) {
+                // The joint is carried by the controller (including the tangential velocity from its rotation), and
+                // moves relative to it.
+                const DirectX::XMVECTOR toVirtual = LoadXrQuaternion(controllerPose.orientation);
+                const DirectX::XMVECTOR controllerAngularVelocity = LoadXrVector3(controllerVelocity.angularVelocity);
+                if (controllerVelocity.velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+                    StoreXrVector3(&jointToVirtualVelocity.angularVelocity,
+                                   DirectX::XMVectorAdd(controllerAngularVelocity,
+                                                        DirectX::XMVector3Rotate(
+                                                            LoadXrVector3(jointAngularVelocities[i]), toVirtual)));
+                    jointToVirtualVelocity.velocityFlags |= XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+                }
+                if ((controllerVelocity.velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) &&
+                    (controllerVelocity.velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT)) {
+                    const DirectX::XMVECTOR leverArm = DirectX::XMVectorSubtract(
+                        LoadXrVector3(jointToVirtual.position), LoadXrVector3(controllerPose.position));
+                    StoreXrVector3(
+                        &jointToVirtualVelocity.linearVelocity,
+                        DirectX::XMVectorAdd(
+                            DirectX::XMVectorAdd(LoadXrVector3(controllerVelocity.linearVelocity),
+                                                 DirectX::XMVector3Cross(controllerAngularVelocity, leverArm)),
+                            DirectX::XMVector3Rotate(LoadXrVector3(jointLinearVelocities[i]), toVirtual)));
+                    jointToVirtualVelocity.velocityFlags |= XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
                 }
-                locations->jointLocations[i].pose = Pose::Multiply(correctedPose, Pose::Invert(baseSpaceToVirtual));
             }
+
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            motion::composeLocation(flags2,
+                                    jointToVirtual,
+                                    jointToVirtualVelocity,
+                                    flags1,
+                                    virtualToBaseSpace,
+                                    baseSpaceToVirtualVelocity,
+                                    locations->jointLocations[i].pose,
+                                    velocities ? &velocity : nullptr);
+            locations->jointLocations[i].radius = i != XR_HAND_JOINT_PALM_EXT ? 0.005f : 0.04f;
             locations->jointLocations[i].locationFlags =
                 (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT) | flags2;
 
-            switch (i) {
-            case XR_HAND_JOINT_WRIST_EXT:
-                wristPose = accumulatedPose;
-                break;
-
-            case XR_HAND_JOINT_INDEX_METACARPAL_EXT:
-            case XR_HAND_JOINT_INDEX_PROXIMAL_EXT:
-            case XR_HAND_JOINT_MIDDLE_METACARPAL_EXT:
-            case XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT:
-            case XR_HAND_JOINT_RING_METACARPAL_EXT:
-            case XR_HAND_JOINT_RING_PROXIMAL_EXT:
-            case XR_HAND_JOINT_LITTLE_METACARPAL_EXT:
-            case XR_HAND_JOINT_LITTLE_PROXIMAL_EXT:
-                barycenter = barycenter + accumulatedPose.position;
-                break;
-
-            // Reset to the wrist base pose once we reach the tip.
-            case XR_HAND_JOINT_THUMB_TIP_EXT:
-            case XR_HAND_JOINT_INDEX_TIP_EXT:
-            case XR_HAND_JOINT_MIDDLE_TIP_EXT:
-            case XR_HAND_JOINT_RING_TIP_EXT:
-            case XR_HAND_JOINT_LITTLE_TIP_EXT:
-                accumulatedPose = wristPose;
-                break;
-            }
-
             if (velocities) {
-                velocities->jointVelocities[i].angularVelocity = {};
-                velocities->jointVelocities[i].linearVelocity = {};
-                velocities->jointVelocities[i].velocityFlags = 0;
+                velocities->jointVelocities[i].angularVelocity = velocity.angularVelocity;
+                velocities->jointVelocities[i].linearVelocity = velocity.linearVelocity;
+                velocities->jointVelocities[i].velocityFlags = velocity.velocityFlags;
             }
         }
 
-        // SteamVR doesn't have palm, we compute the barycenter of the metacarpal and proximal for
-        // index/middle/ring/little fingers.
-        barycenter = barycenter / 8.0f;
-        locations->jointLocations[XR_HAND_JOINT_PALM_EXT].radius = 0.04f;
-        locations->jointLocations[XR_HAND_JOINT_PALM_EXT].pose = Pose::Multiply(
-            Pose::MakePose(locations->jointLocations[XR_HAND_JOINT_MIDDLE_METACARPAL_EXT].pose.orientation, barycenter),
-            Pose::Invert(baseSpaceToVirtual));
-
         return XR_SUCCESS;
     }
 
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "haptics.h"
+#include "log.h"
+
+namespace pimax_openxr::haptics {
+
+    using namespace pimax_openxr::log;
+
+    namespace {
+
+        // The pulse rate when the application does not request a frequency.
+        constexpr auto k_defaultPulsePeriod = 10ms;
+
+        // PVR does not render pulses any closer than this, and pulses further apart no longer feel like a vibration.
+        constexpr auto k_minPulsePeriod = 5ms;
+        constexpr auto k_maxPulsePeriod = 100ms;
+
+        struct PvrPulseSink : IPulseSink {
+            PvrPulseSink(pvrSessionHandle session) : m_session(session) {
+            }
+
+            void pulse(int side, float amplitude) override {
+                // We are not on an application thread, so we only log the failures.
+                const pvrResult result = pvr_triggerHapticPulse(
+                    m_session,
+                    side == 0 ? pvrTrackedDevice_LeftController : pvrTrackedDevice_RightController,
+                    amplitude);
+                if (result != pvr_success) {
+                    TraceLoggingWrite(g_traceProvider,
+                                      "PVR_TriggerHapticPulse",
+                                      TLArg(side, "Side"),
+                                      TLArg(static_cast<int>(result), "Error"));
+                }
+            }
+
+            const pvrSessionHandle m_session;
+        };
+
+    } // namespace
+
+    std::shared_ptr<IPulseSink> createPvrPulseSink(pvrSessionHandle session) {
+        return std::make_shared<PvrPulseSink>(session);
+    }
+
+    Scheduler::Scheduler(std::shared_ptr<IPulseSink> sink, bool useThread)
+        : m_sink(std::move(sink)), m_epoch(clock::now()) {
+        if (useThread) {
+            m_thread = std::thread([&]() { schedulerThread(); });
+        }
+    }
+
+    Scheduler::~Scheduler() {
+        if (m_thread.joinable()) {
+            {
+                std::unique_lock lock(m_mutex);
+
+                m_terminate = true;
+                m_wakeUp.notify_all();
+            }
+            m_thread.join();
+        }
+    }
+
+    void Scheduler::apply(int side, float amplitude, int64_t durationNs, float frequency) {
+        std::unique_lock lock(m_mutex);
+
+        // Preempt the ongoing vibration. Its pending timer is discarded when it expires.
+        Train& train = m_trains[side];
+        train.generation++;
+
+        // OpenComposite seems to pass an amplitude of 0 sometimes, which cannot be rendered.
+        if (!(amplitude > 0.f)) {
+            return;
+        }
+
+        constexpr double tickNs = static_cast<double>(std::chrono::nanoseconds(k_tickDuration).count());
+        double periodNs = static_cast<double>(std::chrono::nanoseconds(k_defaultPulsePeriod).count());
+        if (frequency > 0.f) {
+            periodNs = std::clamp(1e9 / frequency,
+                                  static_cast<double>(std::chrono::nanoseconds(k_minPulsePeriod).count()),
+                                  static_cast<double>(std::chrono::nanoseconds(k_maxPulsePeriod).count()));
+        }
+
+        // XR_MIN_HAPTIC_DURATION yields a single pulse.
+        const uint64_t durationTicks =
+            durationNs > 0 ? static_cast<uint64_t>(std::ceil(static_cast<double>(durationNs) / tickNs)) : 0;
+
+        const uint64_t now = std::max(getTick(clock::now()), m_nextTick);
+        train.amplitude = std::min(amplitude, 1.f);
+        train.periodTicks = std::max(static_cast<uint64_t>(periodNs / tickNs), uint64_t{1});
+        train.endTick = now + std::max(durationTicks, uint64_t{1});
+
+        addTimer({now, train.generation, side});
+        m_wakeUp.notify_all();
+    }
+
+    void Scheduler::stop(int side) {
+        std::unique_lock lock(m_mutex);
+
+        // The pending timer is discarded when it expires.
+        m_trains[side].generation++;
+    }
+
+    void Scheduler::stopAll() {
+        std::unique_lock lock(m_mutex);
+
+        for (Train& train : m_trains) {
+            train.generation++;
+        }
+    }
+
+    void Scheduler::processUntil(clock::time_point now) {
+        // Late timers are coalesced below, so each side emits at most one pulse per pass.
+        std::pair<int, float> pulses[2];
+        size_t pulsesCount = 0;
+
+        {
+            std::unique_lock lock(m_mutex);
+
+            const uint64_t lastTick = getTick(now);
+            while (m_pendingTimers && m_nextTick <= lastTick) {
+                std::swap(m_wheel[m_nextTick % k_wheelSize], m_slotTimers);
+                for (const Timer& timer : m_slotTimers) {
+                    if (timer.tick > m_nextTick) {
+                        // Due on a later revolution of the wheel.
+                        m_wheel[m_nextTick % k_wheelSize].push_back(timer);
+                        continue;
+                    }
+
+                    m_pendingTimers--;
+                    const Train& train = m_trains[timer.side];
+                    if (timer.generation != train.generation) {
+                        // Preempted or stopped.
+                        continue;
+                    }
+
+                    pulses[pulsesCount++] = std::make_pair(timer.side, train.amplitude);
+
+                    // Schedule the next pulse, skipping the ones we are already late for.
+                    uint64_t nextTick = timer.tick + train.periodTicks;
+                    if (nextTick <= lastTick) {
+                        nextTick += ((lastTick - nextTick) / train.periodTicks + 1) * train.periodTicks;
+                    }
+                    if (nextTick < train.endTick) {
+                        addTimer({nextTick, timer.generation, timer.side});
+                    }
+                }
+                m_slotTimers.clear();
+                m_nextTick++;
+            }
+
+            if (!m_pendingTimers) {
+                m_nextTick = std::max(m_nextTick, lastTick + 1);
+            }
+        }
+
+        // Do not hold the lock while calling into the device.
+        for (size_t i = 0; i < pulsesCount; i++) {
+            m_sink->pulse(pulses[i].first, pulses[i].second);
+        }
+    }
+
+    uint64_t Scheduler::getTick(clock::time_point time) const {
+        return static_cast<uint64_t>((time - m_epoch) / k_tickDuration);
+    }
+
+    Scheduler::clock::time_point Scheduler::getTickTime(uint64_t tick) const {
+        return m_epoch + std::chrono::duration_cast<clock::duration>(k_tickDuration * static_cast<int64_t>(tick));
+    }
+
+    void Scheduler::addTimer(const Timer& timer) {
+        m_wheel[timer.tick % k_wheelSize].push_back(timer);
+        m_pendingTimers++;
+    }
+
+    std::optional<uint64_t> Scheduler::getNextTimerTick() const {
+        std::optional<uint64_t> nextTick;
+        if (m_pendingTimers) {
+            for (const auto& slot : m_wheel) {
+                for (const Timer& timer : slot) {
+                    nextTick = std::min(nextTick.value_or(timer.tick), timer.tick);
+                }
+            }
+        }
+        return nextTick;
+    }
+
+    void Scheduler::schedulerThread() {
+        TraceLoggingWrite(g_traceProvider, "HapticsSchedulerThread", TLArg("Start", "State"));
+
+        std::unique_lock lock(m_mutex);
+        while (!m_terminate) {
+            const auto nextTick = getNextTimerTick();
+            if (nextTick) {
+                m_wakeUp.wait_until(lock, getTickTime(nextTick.value()));
+            } else {
+                m_wakeUp.wait(lock);
+            }
+            if (m_terminate) {
+                break;
+            }
+
+            lock.unlock();
+            processUntil(clock::now());
+            lock.lock();
+        }
+
+        TraceLoggingWrite(g_traceProvider, "HapticsSchedulerThread", TLArg("Stop", "State"));
+    }
+
+} // namespace pimax_openxr::haptics
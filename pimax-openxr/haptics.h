@@ -0,0 +1,98 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// PVR can only trigger discrete haptic pulses, so a vibration is rendered as a train of pulses. The scheduler times the
+// pulses on its own thread, so that neither xrApplyHapticFeedback() nor xrStopHapticFeedback() waits on the device.
+
+namespace pimax_openxr::haptics {
+
+    // The destination of the pulses. The runtime forwards them to PVR, but any other implementation may be plugged in.
+    struct IPulseSink {
+        virtual ~IPulseSink() = default;
+
+        virtual void pulse(int side, float amplitude) = 0;
+    };
+
+    // Schedules the pulse trains for both hands with a hashed timer wheel.
+    class Scheduler {
+      public:
+        using clock = std::chrono::steady_clock;
+
+        // When useThread is false, the caller drives the scheduler through processUntil().
+        Scheduler(std::shared_ptr<IPulseSink> sink, bool useThread = true);
+        ~Scheduler();
+
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // Start a vibration, preempting any ongoing vibration on the same side. A duration of XR_MIN_HAPTIC_DURATION
+        // (or shorter than one pulse period) yields a single pulse. A null amplitude stops the vibration.
+        void apply(int side, float amplitude, int64_t durationNs, float frequency);
+        void stop(int side);
+        void stopAll();
+
+        // Emit all the pulses due by the given time.
+        void processUntil(clock::time_point now);
+
+      private:
+        struct Timer {
+            uint64_t tick;
+            uint64_t generation;
+            int side;
+        };
+
+        struct Train {
+            uint64_t generation{0};
+            float amplitude{0.f};
+            uint64_t periodTicks{1};
+            uint64_t endTick{0};
+        };
+
+        static constexpr auto k_tickDuration = 1ms;
+        static constexpr size_t k_wheelSize = 128;
+
+        uint64_t getTick(clock::time_point time) const;
+        clock::time_point getTickTime(uint64_t tick) const;
+        void addTimer(const Timer& timer);
+        std::optional<uint64_t> getNextTimerTick() const;
+        void schedulerThread();
+
+        const std::shared_ptr<IPulseSink> m_sink;
+        const clock::time_point m_epoch;
+
+        std::mutex m_mutex;
+        std::condition_variable m_wakeUp;
+        bool m_terminate{false};                             // protected by m_mutex
+        std::array<std::vector<Timer>, k_wheelSize> m_wheel; // protected by m_mutex
+        std::vector<Timer> m_slotTimers;                     // protected by m_mutex
+        size_t m_pendingTimers{0};                           // protected by m_mutex
+        uint64_t m_nextTick{0};                              // protected by m_mutex
+        Train m_trains[2];                                   // protected by m_mutex
+
+        std::thread m_thread;
+    };
+
+    std::shared_ptr<IPulseSink> createPvrPulseSink(pvrSessionHandle session);
+
+} // namespace pimax_openxr::haptics
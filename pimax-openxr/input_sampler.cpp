@@ -0,0 +1,235 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "log.h"
+#include "runtime.h"
+#include "utils.h"
+
+// Implements a background thread sampling the controller inputs at a higher rate than the application syncs actions.
+// This lets us catch button presses that are shorter than an application frame, and report accurate change times.
+
+namespace pimax_openxr {
+
+    using namespace pimax_openxr::log;
+    using namespace pimax_openxr::utils;
+
+    namespace {
+
+        constexpr size_t k_inputStateWords = sizeof(pvrInputState) / sizeof(uint32_t);
+
+        void readInputStateWords(const pvrInputState& state, uint32_t (&words)[k_inputStateWords]) {
+            memcpy(words, &state, sizeof(words));
+        }
+
+        // The button bitmasks are indexed as: 0-1 = HandButtons, 2-3 = HandTouches.
+        uint32_t& getButtonWord(pvrInputState& state, int index) {
+            return index < 2 ? state.HandButtons[index] : state.HandTouches[index - 2];
+        }
+
+    } // namespace
+
+    void OpenXrRuntime::startInputSamplingThread() {
+        if (!m_inputSamplingRate || m_inputSamplingThread.joinable()) {
+            return;
+        }
+
+        Log("Sampling inputs at %u Hz\n", m_inputSamplingRate);
+
+        m_inputSamplesWritten = 0;
+        m_inputSamplesRead = 0;
+        m_lastSampledInputState.reset();
+        m_lastReportedInputState = {};
+        m_inputChangeTimes = {};
+        m_latchedInputButtons = {};
+        m_latchedInputRevertTimes = {};
+
+        m_inputSamplingTerminateEvent.create(wil::EventOptions::ManualReset);
+        m_inputSamplingThread = std::thread([&]() { inputSamplingThread(); });
+    }
+
+    void OpenXrRuntime::stopInputSamplingThread() {
+        if (!m_inputSamplingThread.joinable()) {
+            return;
+        }
+
+        m_inputSamplingTerminateEvent.SetEvent();
+        m_inputSamplingThread.join();
+        m_inputSamplingThread = {};
+        m_inputSamplingTerminateEvent.reset();
+    }
+
+    void OpenXrRuntime::inputSamplingThread() {
+        TraceLoggingWrite(g_traceProvider, "InputSamplingThread", TLArg("Start", "State"));
+
+        // The default timer resolution on Windows is too coarse for the rates we want to achieve.
+        wil::unique_handle timer(
+            CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS));
+        if (!timer) {
+            timer.reset(CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS));
+        }
+
+        // Relative due time, in 100ns units.
+        LARGE_INTEGER period;
+        period.QuadPart = -(LONGLONG)(10'000'000 / m_inputSamplingRate);
+
+        const HANDLE handles[] = {m_inputSamplingTerminateEvent.get(), timer.get()};
+        while (true) {
+            SetWaitableTimer(timer.get(), &period, 0, nullptr, nullptr, FALSE);
+
+            pvrInputState state{};
+            if (pvr_getInputState(m_pvrSession, &state) == pvr_success) {
+                // Publish the sample. The reader uses the sequence number to detect samples overwritten while being
+                // read.
+                const uint64_t index = m_inputSamplesWritten.load(std::memory_order_relaxed);
+                InputSample& sample = m_inputSamples[index % k_inputSampleRingSize];
+                sample.sequence.store(2 * index + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                sample.state = state;
+                sample.sequence.store(2 * index + 2, std::memory_order_release);
+                m_inputSamplesWritten.store(index + 1, std::memory_order_release);
+            }
+
+            if (WaitForMultipleObjects(ARRAYSIZE(handles), handles, FALSE, INFINITE) != WAIT_OBJECT_0 + 1) {
+                break;
+            }
+        }
+
+        TraceLoggingWrite(g_traceProvider, "InputSamplingThread", TLArg("Stop", "State"));
+    }
+
+    // Merge all the samples since the last call into the snapshot. Returns false if no sample is available.
+    bool OpenXrRuntime::latchSampledInputState(InputSnapshot& snapshot) {
+        const uint64_t written = m_inputSamplesWritten.load(std::memory_order_acquire);
+
+        // Skip the samples that were already overwritten (leave some headroom for the one being written).
+        uint64_t index = std::max(m_inputSamplesRead, written > k_inputSampleRingSize - 2
+                                                          ? written - (k_inputSampleRingSize - 2)
+                                                          : 0);
+        if (index > m_inputSamplesRead) {
+            TraceLoggingWrite(g_traceProvider,
+                              "InputSamplesDropped",
+                              TLArg(index - m_inputSamplesRead, "Count"));
+        }
+
+        uint32_t rising[4]{};
+        uint32_t falling[4]{};
+        double risingTime[4][32]{};
+        double fallingTime[4][32]{};
+        uint32_t numSamples = 0;
+        for (; index < written; index++) {
+            const InputSample& sample = m_inputSamples[index % k_inputSampleRingSize];
+
+            const uint64_t sequence = sample.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * index + 2) {
+                continue;
+            }
+            pvrInputState state = sample.state;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sample.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+            numSamples++;
+
+            if (m_lastSampledInputState) {
+                pvrInputState& previous = m_lastSampledInputState.value();
+
+                // Record the time of the last change for each field.
+                uint32_t previousWords[k_inputStateWords];
+                uint32_t currentWords[k_inputStateWords];
+                readInputStateWords(previous, previousWords);
+                readInputStateWords(state, currentWords);
+                for (size_t i = 0; i < k_inputStateWords; i++) {
+                    if (previousWords[i] != currentWords[i]) {
+                        m_inputChangeTimes.field[i] = state.TimeInSeconds;
+                    }
+                }
+
+                // Record the edges for each button.
+                for (int i = 0; i < 4; i++) {
+                    const uint32_t before = getButtonWord(previous, i);
+                    const uint32_t after = getButtonWord(state, i);
+                    const uint32_t rose = ~before & after;
+                    const uint32_t fell = before & ~after;
+                    rising[i] |= rose;
+                    falling[i] |= fell;
+                    for (uint32_t bit = 0; bit < 32; bit++) {
+                        if (rose & (1u << bit)) {
+                            risingTime[i][bit] = m_inputChangeTimes.button[i][bit] = state.TimeInSeconds;
+                        } else if (fell & (1u << bit)) {
+                            fallingTime[i][bit] = m_inputChangeTimes.button[i][bit] = state.TimeInSeconds;
+                        }
+                    }
+                }
+            }
+            m_lastSampledInputState = state;
+        }
+        m_inputSamplesRead = written;
+
+        if (!m_lastSampledInputState) {
+            return false;
+        }
+
+        snapshot.state = m_lastSampledInputState.value();
+
+        // Latch the transitions that happened entirely between two syncs, so that the application gets to see them.
+        // They will be reverted upon the next sync.
+        for (int i = 0; i < 4; i++) {
+            const uint32_t reported = getButtonWord(m_lastReportedInputState, i);
+            uint32_t& current = getButtonWord(snapshot.state, i);
+
+            // Revert the transitions latched on the last sync with the time of their opposite edge, unless a newer edge
+            // was sampled since.
+            const uint32_t reverted = m_latchedInputButtons[i] & (reported ^ current) & ~(rising[i] | falling[i]);
+            for (uint32_t bit = 0; bit < 32; bit++) {
+                if (reverted & (1u << bit)) {
+                    m_inputChangeTimes.button[i][bit] = m_latchedInputRevertTimes.button[i][bit];
+                }
+            }
+
+            const uint32_t missedPress = rising[i] & ~reported & ~current;
+            const uint32_t missedRelease = falling[i] & reported & current;
+            current = (current | missedPress) & ~missedRelease;
+
+            for (uint32_t bit = 0; bit < 32; bit++) {
+                if (missedPress & (1u << bit)) {
+                    m_inputChangeTimes.button[i][bit] = risingTime[i][bit];
+                    m_latchedInputRevertTimes.button[i][bit] = fallingTime[i][bit];
+                } else if (missedRelease & (1u << bit)) {
+                    m_inputChangeTimes.button[i][bit] = fallingTime[i][bit];
+                    m_latchedInputRevertTimes.button[i][bit] = risingTime[i][bit];
+                }
+            }
+            m_latchedInputButtons[i] = missedPress | missedRelease;
+        }
+        m_lastReportedInputState = snapshot.state;
+
+        snapshot.hasChangeTimes = true;
+        snapshot.changeTimes = m_inputChangeTimes;
+
+        TraceLoggingWrite(g_traceProvider, "LatchSampledInputState", TLArg(numSamples, "NumSamples"));
+
+        return true;
+    }
+
+} // namespace pimax_openxr
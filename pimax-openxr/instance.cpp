@@ -22,6 +22,7 @@
 
 #include "pch.h"
 
+#include "framework/dispatch.h"
 #include "log.h"
 #include "runtime.h"
 #include "store.h"
@@ -288,19 +289,17 @@ namespace pimax_openxr {
         }
 
         initializeExtensionsTable();
-        initializeRemappingTables();
+
+        // Intern the top-level user paths that the action system needs to compare against.
+        m_leftHandPath = stringToPath("/user/hand/left");
+        m_rightHandPath = stringToPath("/user/hand/right");
+        m_eyesPath = stringToPath("/user/eyes_ext");
     }
 
     OpenXrRuntime::~OpenXrRuntime() {
         // Destroy actionset and actions (tied to the instance).
-        for (auto action : m_actionsForCleanup) {
-            Action* xrAction = (Action*)action;
-            delete xrAction;
-        }
-        for (auto actionSet : m_actionSets) {
-            ActionSet* xrActionSet = (ActionSet*)actionSet;
-            delete xrActionSet;
-        }
+        m_actions.clear();
+        m_actionSets.clear();
 
         if (m_sessionCreated) {
             // TODO: Ideally we do not invoke OpenXR public APIs to avoid confusing event tracing and possible
@@ -324,7 +323,16 @@ namespace pimax_openxr {
     XrResult OpenXrRuntime::xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
         TraceLoggingWrite(g_traceProvider, "xrGetInstanceProcAddr", TLXArg(instance, "Instance"), TLArg(name, "Name"));
 
-        const auto result = OpenXrApi::xrGetInstanceProcAddr(instance, name, function);
+        auto result = OpenXrApi::xrGetInstanceProcAddr(instance, name, function);
+
+        // The vendor extensions are not known to the dispatch generator.
+        if (result == XR_ERROR_FUNCTION_UNSUPPORTED) {
+            const std::string_view apiName(name);
+            if (has_XR_PIMAX_action_state_batch && apiName == "xrGetActionStatesPIMAX") {
+                *function = reinterpret_cast<PFN_xrVoidFunction>(pimax_openxr::xrGetActionStatesPIMAX);
+                result = XR_SUCCESS;
+            }
+        }
 
         TraceLoggingWrite(g_traceProvider, "xrGetInstanceProcAddr", TLPArg(function, "Function"));
 
@@ -612,6 +620,15 @@ namespace pimax_openxr {
                 {XR_VARJO_FOVEATED_RENDERING_EXTENSION_NAME, XR_VARJO_foveated_rendering_SPEC_VERSION});
         }
 
+        m_extensionsTable.push_back( // Batched space location.
+            {XR_KHR_LOCATE_SPACES_EXTENSION_NAME, XR_KHR_locate_spaces_SPEC_VERSION});
+
+        // Experimental vendor extensions, without a registered extension number yet.
+        if (getSetting("enable_experimental").value_or(false)) {
+            m_extensionsTable.push_back( // Batched action state queries.
+                {XR_PIMAX_ACTION_STATE_BATCH_EXTENSION_NAME, XR_PIMAX_action_state_batch_SPEC_VERSION});
+        }
+
         // FIXME: Add new extensions here.
     }
 
@@ -27,12 +27,29 @@
 #include "utils.h"
 
 namespace {
-    std::string rreplace(const std::string& str, const std::string& from, const std::string& to) {
-        std::string copy(str);
-        const size_t start_pos = str.rfind(from);
-        copy.replace(start_pos, from.length(), to);
-
-        return copy;
+    using pimax_openxr::mappings::Button;
+
+    pvrButton getPvrButton(Button button) {
+        switch (button) {
+        case Button::System:
+            return pvrButton_System;
+        case Button::ApplicationMenu:
+            return pvrButton_ApplicationMenu;
+        case Button::Grip:
+            return pvrButton_Grip;
+        case Button::Trigger:
+            return pvrButton_Trigger;
+        case Button::TouchPad:
+            return pvrButton_TouchPad;
+        case Button::A:
+            return pvrButton_A;
+        case Button::B:
+            return pvrButton_B;
+        case Button::JoyStick:
+            return pvrButton_JoyStick;
+        default:
+            return static_cast<pvrButton>(0);
+        }
     }
 } // namespace
 
@@ -41,1067 +58,87 @@ namespace pimax_openxr {
     using namespace pimax_openxr::log;
     using namespace pimax_openxr::utils;
 
-    void OpenXrRuntime::initializeRemappingTables() {
-        // 1:1 mappings.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/htc/vive_controller", "/interaction_profiles/htc/vive_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                return mapPathToViveControllerInputState(xrAction, getXrPath(binding), source);
-            });
-        m_controllerMappingTable.insert_or_assign(std::make_pair("/interaction_profiles/valve/index_controller",
-                                                                 "/interaction_profiles/valve/index_controller"),
-                                                  [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                                                      return mapPathToIndexControllerInputState(
-                                                          xrAction, getXrPath(binding), source);
-                                                  });
-        m_controllerMappingTable.insert_or_assign(std::make_pair("/interaction_profiles/oculus/touch_controller",
-                                                                 "/interaction_profiles/oculus/touch_controller"),
-                                                  [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                                                      return mapPathToCrystalControllerInputState(
-                                                          xrAction, getXrPath(binding), source);
-                                                  });
-        m_controllerMappingTable.insert_or_assign(std::make_pair("/interaction_profiles/khr/simple_controller",
-                                                                 "/interaction_profiles/khr/simple_controller"),
-                                                  [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                                                      return mapPathToSimpleControllerInputState(
-                                                          xrAction, getXrPath(binding), source);
-                                                  });
-
-        // Virtual mappings to Vive controller.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/oculus/touch_controller",
-                           "/interaction_profiles/htc/vive_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapOculusTouchControllerToViveController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToViveControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/microsoft/motion_controller",
-                           "/interaction_profiles/htc/vive_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToViveController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToViveControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/valve/index_controller", "/interaction_profiles/htc/vive_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapIndexControllerToViveController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToViveControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/khr/simple_controller", "/interaction_profiles/htc/vive_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapSimpleControllerToViveController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToViveControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-
-        // Virtual mappings to Index controller.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/oculus/touch_controller",
-                           "/interaction_profiles/valve/index_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapOculusTouchControllerToIndexController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToIndexControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/microsoft/motion_controller",
-                           "/interaction_profiles/valve/index_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToIndexController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToIndexControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/htc/vive_controller", "/interaction_profiles/valve/index_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapViveControllerToIndexController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToIndexControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/khr/simple_controller",
-                           "/interaction_profiles/valve/index_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapSimpleControllerToIndexController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToIndexControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-
-        // Virtual mappings to Crystal controller.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/valve/index_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapIndexControllerToCrystalController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToCrystalControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/htc/vive_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapViveControllerToCrystalController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToCrystalControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/microsoft/motion_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToCrystalController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToCrystalControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/khr/simple_controller",
-                           "/interaction_profiles/oculus/touch_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapSimpleControllerToCrystalController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToCrystalControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-
-        // Virtual mappings to Simple controller.
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/oculus/touch_controller",
-                           "/interaction_profiles/khr/simple_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapOculusTouchControllerToSimpleController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToSimpleControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/htc/vive_controller", "/interaction_profiles/khr/simple_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapViveControllerToSimpleController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToSimpleControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/valve/index_controller",
-                           "/interaction_profiles/khr/simple_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapIndexControllerToSimpleController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToSimpleControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-        m_controllerMappingTable.insert_or_assign(
-            std::make_pair("/interaction_profiles/microsoft/motion_controller",
-                           "/interaction_profiles/khr/simple_controller"),
-            [&](const Action& xrAction, XrPath binding, ActionSource& source) {
-                const auto remapped = remapMicrosoftMotionControllerToSimpleController(getXrPath(binding));
-                if (remapped.has_value()) {
-                    return mapPathToSimpleControllerInputState(xrAction, remapped.value(), source);
-                }
-                return false;
-            });
-
-        // Functions for validating paths.
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/khr/simple_controller",
-            [&](const std::string& path) { return getSimpleControllerLocalizedSourceName(path) != "<Unknown>"; });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/htc/vive_controller",
-            [&](const std::string& path) { return getViveControllerLocalizedSourceName(path) != "<Unknown>"; });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/valve/index_controller",
-            [&](const std::string& path) { return getIndexControllerLocalizedSourceName(path) != "<Unknown>"; });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/oculus/touch_controller",
-            [&](const std::string& path) { return getCrystalControllerLocalizedSourceName(path) != "<Unknown>"; });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/microsoft/motion_controller", [&](const std::string& path) {
-                if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu") ||
-                    endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                    endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                    endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                    endsWith(path, "/input/trigger") || endsWith(path, "/input/thumbstick") ||
-                    endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                    endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/force") ||
-                    endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/trackpad") ||
-                    endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                    endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                    endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/grip/pose") ||
-                    endsWith(path, "/input/grip") || endsWith(path, "/input/aim/pose") ||
-                    endsWith(path, "/input/aim") || endsWith(path, "/output/haptic")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/google/daydream_controller", [](const std::string& path) {
-                if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select") ||
-                    endsWith(path, "/input/trackpad") || endsWith(path, "/input/trackpad/x") ||
-                    endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign("/interaction_profiles/htc/vive_pro", [](const std::string& path) {
-            if (path == "/user/head/input/system/click" || path == "/user/head/input/system" ||
-                path == "/user/head/input/volume_up/click" || path == "/user/head/input/volume_up" ||
-                path == "/user/head/input/volume_down/click" || path == "/user/head/input/volume_down" ||
-                path == "/user/head/input/mute_mic/click" || path == "/user/head/input/mute_mic") {
-                return true;
-            }
-            return false;
-        });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/microsoft/xbox_controller", [](const std::string& path) {
-                if (path == "/user/gamepad/input/menu/click" || path == "/user/gamepad/input/menu" ||
-                    path == "/user/gamepad/input/view/click" || path == "/user/gamepad/input/view" ||
-                    path == "/user/gamepad/input/a/click" || path == "/user/gamepad/input/a" ||
-                    path == "/user/gamepad/input/b/click" || path == "/user/gamepad/input/b" ||
-                    path == "/user/gamepad/input/x/click" || path == "/user/gamepad/input/x" ||
-                    path == "/user/gamepad/input/y/click" || path == "/user/gamepad/input/y" ||
-                    path == "/user/gamepad/input/dpad_down/click" || path == "/user/gamepad/input/dpad_down" ||
-                    path == "/user/gamepad/input/dpad_right/click" || path == "/user/gamepad/input/dpad_right" ||
-                    path == "/user/gamepad/input/dpad_up/click" || path == "/user/gamepad/input/dpad_up" ||
-                    path == "/user/gamepad/input/dpad_left/click" || path == "/user/gamepad/input/dpad_left" ||
-                    path == "/user/gamepad/input/shoulder_left/click" || path == "/user/gamepad/input/shoulder_left" ||
-                    path == "/user/gamepad/input/shoulder_right/click" ||
-                    path == "/user/gamepad/input/shoulder_right" || path == "/user/gamepad/input/trigger_left/click" ||
-                    path == "/user/gamepad/input/trigger_left/value" ||
-                    path == "/user/gamepad/input/trigger_left/force" || path == "/user/gamepad/input/trigger_left" ||
-                    path == "/user/gamepad/input/trigger_right/click" ||
-                    path == "/user/gamepad/input/trigger_right/value" ||
-                    path == "/user/gamepad/input/trigger_right/force" || path == "/user/gamepad/input/trigger_right" ||
-                    path == "/user/gamepad/input/thumbstick_left" || path == "/user/gamepad/input/thumbstick_left/x" ||
-                    path == "/user/gamepad/input/thumbstick_left/y" ||
-                    path == "/user/gamepad/input/thumbstick_left/click" ||
-                    path == "/user/gamepad/input/thumbstick_left/force" ||
-                    path == "/user/gamepad/input/thumbstick_right" ||
-                    path == "/user/gamepad/input/thumbstick_right/x" ||
-                    path == "/user/gamepad/input/thumbstick_right/y" ||
-                    path == "/user/gamepad/input/thumbstick_right/click" ||
-                    path == "/user/gamepad/input/thumbstick_right/force" ||
-                    path == "/user/gamepad/output/haptic_left" || path == "/user/gamepad/output/haptic_right" ||
-                    path == "/user/gamepad/output/haptic_left_trigger" ||
-                    path == "/user/gamepad/output/haptic_right_trigger") {
-                    return true;
-                }
-                return false;
-            });
-        m_controllerValidPathsTable.insert_or_assign(
-            "/interaction_profiles/oculus/go_controller", [](const std::string& path) {
-                if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                    endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger") ||
-                    endsWith(path, "/input/back/click") || endsWith(path, "/input/back") ||
-                    endsWith(path, "/input/trackpad") || endsWith(path, "/input/trackpad/x") ||
-                    endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                    endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                    endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                    endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-                    return true;
-                }
-                return false;
-            });
-    }
-
-    bool OpenXrRuntime::mapPathToViveControllerInputState(const Action& xrAction,
-                                                          const std::string& path,
-                                                          ActionSource& source) const {
+    bool OpenXrRuntime::mapComponentToControllerInputState(mappings::Profile suggestedProfile,
+                                                           mappings::Profile controllerProfile,
+                                                           const Action& xrAction,
+                                                           mappings::UserPath user,
+                                                           mappings::Component component,
+                                                           ActionSource& source) const {
         source.buttonMap = nullptr;
         source.floatValue = nullptr;
         source.vector2fValue = nullptr;
 
-        if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_System;
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                   endsWith(path, "/input/squeeze")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Grip;
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_ApplicationMenu;
-        } else if (endsWith(path, "/input/trigger/click") ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && endsWith(path, "/input/trigger"))) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/trigger/value") ||
-                   (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT && endsWith(path, "/input/trigger"))) {
-            source.floatValue = m_cachedInputState.Trigger;
-        } else if (endsWith(path, "/input/trackpad")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = -1;
-        } else if (endsWith(path, "/input/trackpad/x")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = 0;
-        } else if (endsWith(path, "/input/trackpad/y")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = 1;
-        } else if (endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                   endsWith(path, "/input/trackpad")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_TouchPad;
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_TouchPad;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            // Do nothing.
-        } else {
-            // No possible binding.
-            return false;
+        mappings::ValueType valueType = mappings::ValueType::Other;
+        if (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT) {
+            valueType = mappings::ValueType::Boolean;
+        } else if (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT) {
+            valueType = mappings::ValueType::Float;
         }
 
-        source.realPath = path;
-
-        return true;
-    }
-
-    bool OpenXrRuntime::mapPathToIndexControllerInputState(const Action& xrAction,
-                                                           const std::string& path,
-                                                           ActionSource& source) const {
-        source.buttonMap = nullptr;
-        source.floatValue = nullptr;
-        source.vector2fValue = nullptr;
-
-        if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_System;
-        } else if (endsWith(path, "/input/system/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_System;
-        } else if (endsWith(path, "/input/a/click") || endsWith(path, "/input/a")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_A;
-        } else if (endsWith(path, "/input/a/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_A;
-        } else if (endsWith(path, "/input/b/click") || endsWith(path, "/input/b")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_B;
-        } else if (endsWith(path, "/input/b/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_B;
-        } else if (endsWith(path, "/input/squeeze/value") || endsWith(path, "/input/squeeze/click") ||
-                   endsWith(path, "/input/squeeze")) {
-            // We use the floatValue for squeeze/click since the threshhold for HandButtons seems too high.
-            source.floatValue = m_cachedInputState.Grip;
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            source.floatValue = m_cachedInputState.GripForce;
-        } else if (endsWith(path, "/input/trigger/click") ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && endsWith(path, "/input/trigger"))) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/trigger/value") ||
-                   (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT && endsWith(path, "/input/trigger"))) {
-            source.floatValue = m_cachedInputState.Trigger;
-        } else if (endsWith(path, "/input/trigger/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/thumbstick")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = -1;
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = 0;
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = 1;
-        } else if (endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_JoyStick;
-        } else if (endsWith(path, "/input/thumbstick/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_JoyStick;
-        } else if (endsWith(path, "/input/trackpad")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = -1;
-        } else if (endsWith(path, "/input/trackpad/x")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = 0;
-        } else if (endsWith(path, "/input/trackpad/y")) {
-            source.vector2fValue = m_cachedInputState.TouchPad;
-            source.vector2fIndex = 1;
-        } else if (endsWith(path, "/input/trackpad/force")) {
-            source.floatValue = m_cachedInputState.TouchPadForce;
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_TouchPad;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            // Do nothing.
-        } else {
+        const auto resolved = mappings::resolveBinding(suggestedProfile, controllerProfile, user, component, valueType);
+        if (!resolved) {
             // No possible binding.
             return false;
         }
 
-        source.realPath = path;
-
-        return true;
-    }
-
-    bool OpenXrRuntime::mapPathToCrystalControllerInputState(const Action& xrAction,
-                                                             const std::string& path,
-                                                             ActionSource& source) const {
-        source.buttonMap = nullptr;
-        source.floatValue = nullptr;
-        source.vector2fValue = nullptr;
-
-        if (path == "/user/hand/left/input/x/click" || path == "/user/hand/left/input/x") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_A;
-        } else if (path == "/user/hand/left/input/x/touch") {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_A;
-        } else if (path == "/user/hand/left/input/y/click" || path == "/user/hand/left/input/y") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_B;
-        } else if (path == "/user/hand/left/input/y/touch") {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_B;
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/menu") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_ApplicationMenu;
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_A;
-        } else if (path == "/user/hand/right/input/a/touch") {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_A;
-        } else if (path == "/user/hand/right/input/b/click" || path == "/user/hand/right/input/b") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_B;
-        } else if (path == "/user/hand/right/input/b/touch") {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_B;
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system") {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_System;
-        } else if (endsWith(path, "/input/squeeze/click") ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && endsWith(path, "/input/squeeze"))) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Grip;
-        } else if (endsWith(path, "/input/squeeze/value") ||
-                   (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT && endsWith(path, "/input/squeeze"))) {
+        const mappings::InputField& field = resolved->field;
+        switch (field.state) {
+        case mappings::InputState::HandButtons:
+            source.buttonMap = &pvrInputState::HandButtons;
+            source.buttonType = getPvrButton(field.button);
+            break;
+        case mappings::InputState::HandTouches:
+            source.buttonMap = &pvrInputState::HandTouches;
+            source.buttonType = getPvrButton(field.button);
+            break;
+        case mappings::InputState::Trigger:
+            source.floatValue = &pvrInputState::Trigger;
+            break;
+        case mappings::InputState::Grip:
+            source.floatValue = &pvrInputState::Grip;
+            break;
+        case mappings::InputState::GripForce:
+            source.floatValue = &pvrInputState::GripForce;
+            break;
+        case mappings::InputState::TouchPadForce:
+            source.floatValue = &pvrInputState::TouchPadForce;
+            break;
+        case mappings::InputState::JoyStick:
+            source.vector2fValue = &pvrInputState::JoyStick;
+            source.vector2fIndex = field.vector2fIndex;
+            break;
+        case mappings::InputState::TouchPad:
+            source.vector2fValue = &pvrInputState::TouchPad;
+            source.vector2fIndex = field.vector2fIndex;
+            break;
+        case mappings::InputState::AnalogGrip:
             if (m_useAnalogGrip) {
-                source.floatValue = m_cachedInputState.Grip;
+                source.floatValue = &pvrInputState::Grip;
             } else {
                 // Workaround for bogus controller firmware.
-                source.buttonMap = m_cachedInputState.HandButtons;
+                source.buttonMap = &pvrInputState::HandButtons;
                 source.buttonType = pvrButton_Grip;
             }
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            source.floatValue = m_cachedInputState.GripForce;
-        } else if (endsWith(path, "/input/trigger/click") ||
-                   (xrAction.type == XR_ACTION_TYPE_BOOLEAN_INPUT && endsWith(path, "/input/trigger"))) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/trigger/value") ||
-                   (xrAction.type == XR_ACTION_TYPE_FLOAT_INPUT && endsWith(path, "/input/trigger"))) {
-            source.floatValue = m_cachedInputState.Trigger;
-        } else if (endsWith(path, "/input/trigger/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/thumbstick")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = -1;
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = 0;
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            source.vector2fValue = m_cachedInputState.JoyStick;
-            source.vector2fIndex = 1;
-        } else if (endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_JoyStick;
-        } else if (endsWith(path, "/input/thumbstick/touch")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_JoyStick;
-        } else if (endsWith(path, "/input/thumbrest/touch") || endsWith(path, "/input/thumbrest")) {
-            source.buttonMap = m_cachedInputState.HandTouches;
-            source.buttonType = pvrButton_TouchPad;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            // Do nothing.
-        } else {
-            // No possible binding.
-            return false;
+            break;
+        default:
+            // Poses and haptics: nothing to read.
+            break;
         }
 
-        source.realPath = path;
+        source.realPath = mappings::k_userPaths[static_cast<size_t>(user)];
+        source.realPath += mappings::k_componentPaths[static_cast<size_t>(resolved->component)];
 
         return true;
     }
 
-    bool OpenXrRuntime::mapPathToSimpleControllerInputState(const Action& xrAction,
-                                                            const std::string& path,
-                                                            ActionSource& source) const {
-        source.buttonMap = nullptr;
-        source.floatValue = nullptr;
-        source.vector2fValue = nullptr;
-
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_Trigger;
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            source.buttonMap = m_cachedInputState.HandButtons;
-            source.buttonType = pvrButton_ApplicationMenu;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            // Do nothing.
-        } else {
-            // No possible binding.
-            return false;
-        }
-
-        source.realPath = path;
-
-        return true;
-    }
-
-    std::string OpenXrRuntime::getViveControllerLocalizedSourceName(const std::string& path) const {
-        if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system")) {
-            return "System Button";
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                   endsWith(path, "/input/squeeze")) {
-            return "Grip Press";
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return "Menu Button";
-        } else if (endsWith(path, "/input/trigger/click")) {
-            return "Trigger Press";
-        } else if (endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return "Trigger";
-        } else if (endsWith(path, "/input/trackpad")) {
-            return "Trackpad";
-        } else if (endsWith(path, "/input/trackpad/x")) {
-            return "Trackpad X axis";
-        } else if (endsWith(path, "/input/trackpad/y")) {
-            return "Trackpad Y axis";
-        } else if (endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                   endsWith(path, "/input/trackpad")) {
-            return "Trackpad Press";
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            return "Trackpad Touch";
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip")) {
-            return "Grip Pose";
-        } else if (endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-            return "Aim Pose";
-        } else if (endsWith(path, "/output/haptic")) {
-            return "Haptics";
-        }
-
-        return "<Unknown>";
-    }
-
-    std::string OpenXrRuntime::getIndexControllerLocalizedSourceName(const std::string& path) const {
-        if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system")) {
-            return "System Button";
-        } else if (endsWith(path, "/input/system/touch")) {
-            return "System Touch";
-        } else if (endsWith(path, "/input/a/click") || endsWith(path, "/input/a")) {
-            return "A Button";
-        } else if (endsWith(path, "/input/a/touch")) {
-            return "A Touch";
-        } else if (endsWith(path, "/input/b/click") || endsWith(path, "/input/b")) {
-            return "B Button";
-        } else if (endsWith(path, "/input/b/touch")) {
-            return "B Touch";
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze")) {
-            return "Grip";
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return "Grip Force";
-        } else if (endsWith(path, "/input/trigger/click")) {
-            return "Trigger Press";
-        } else if (endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return "Trigger";
-        } else if (endsWith(path, "/input/trigger/touch")) {
-            return "Trigger Touch";
-        } else if (endsWith(path, "/input/thumbstick")) {
-            return "Joystick";
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            return "Joystic X axis";
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            return "Joystick Y axis";
-        } else if (endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick")) {
-            return "Joystick Press";
-        } else if (endsWith(path, "/input/thumbstick/touch")) {
-            return "Joystick Touch";
-        } else if (endsWith(path, "/input/trackpad")) {
-            return "Trackpad";
-        } else if (endsWith(path, "/input/trackpad/x")) {
-            return "Trackpad X axis";
-        } else if (endsWith(path, "/input/trackpad/y")) {
-            return "Trackpad Y axis";
-        } else if (endsWith(path, "/input/trackpad/force")) {
-            return "Trackpad Force";
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            return "Trackpad Touch";
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip")) {
-            return "Grip Pose";
-        } else if (endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-            return "Aim Pose";
-        } else if (endsWith(path, "/output/haptic")) {
-            return "Haptics";
-        }
-
-        return "<Unknown>";
-    }
-
-    std::string OpenXrRuntime::getCrystalControllerLocalizedSourceName(const std::string& path) const {
-        if (path == "/user/hand/left/input/x/click" || path == "/user/hand/left/input/x") {
-            return "X Button";
-        } else if (path == "/user/hand/left/input/x/touch") {
-            return "X Touch";
-        } else if (path == "/user/hand/left/input/y/click" || path == "/user/hand/left/input/y") {
-            return "Y Button";
-        } else if (path == "/user/hand/left/input/y/touch") {
-            return "Y Touch";
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu") {
-            return "Menu Button";
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a") {
-            return "A Button";
-        } else if (path == "/user/hand/right/input/a/touch") {
-            return "A Touch";
-        } else if (path == "/user/hand/right/input/b/click" || path == "/user/hand/right/input/b") {
-            return "B Button";
-        } else if (path == "/user/hand/right/input/b/touch") {
-            return "B Touch";
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system") {
-            return "System Button";
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze")) {
-            return "Grip";
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return "Grip Force";
-        } else if (endsWith(path, "/input/trigger/click")) {
-            return "Trigger Press";
-        } else if (endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return "Trigger";
-        } else if (endsWith(path, "/input/trigger/touch")) {
-            return "Trigger Touch";
-        } else if (endsWith(path, "/input/thumbstick")) {
-            return "Joystick";
-        } else if (endsWith(path, "/input/thumbstick/x")) {
-            return "Joystic X axis";
-        } else if (endsWith(path, "/input/thumbstick/y")) {
-            return "Joystick Y axis";
-        } else if (endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick")) {
-            return "Joystick Press";
-        } else if (endsWith(path, "/input/thumbstick/touch")) {
-            return "Joystick Touch";
-        } else if (endsWith(path, "/input/thumbrest/touch") || endsWith(path, "/input/thumbrest")) {
-            return "Thumbrest Touch";
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip")) {
-            return "Grip Pose";
-        } else if (endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-            return "Aim Pose";
-        } else if (endsWith(path, "/output/haptic")) {
-            return "Haptics";
-        }
-
-        return "<Unknown>";
-    }
-
-    std::string OpenXrRuntime::getSimpleControllerLocalizedSourceName(const std::string& path) const {
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            return "Trigger Press";
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return "Menu Button";
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip")) {
-            return "Grip Pose";
-        } else if (endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim")) {
-            return "Aim Pose";
-        } else if (endsWith(path, "/output/haptic")) {
-            return "Haptics";
-        }
-
-        return "<Unknown>";
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapSimpleControllerToViveController(const std::string& path) const {
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            return rreplace(path, "/input/select", "/input/trigger");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapOculusTouchControllerToViveController(const std::string& path) const {
-        if (endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-            endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/touch") ||
-            endsWith(path, "/input/thumbstick")) {
-            return rreplace(path, "/input/thumbstick", "/input/trackpad");
-        } else if (endsWith(path, "/input/squeeze/value")) {
-            return rreplace(path, "/input/squeeze/value", "/input/squeeze/click");
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return rreplace(path, "/input/squeeze/force", "/input/squeeze/click");
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a") {
-            return "/user/hand/right/input/menu/click";
-        } else if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                   endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu") ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapMicrosoftMotionControllerToViveController(const std::string& path) const {
-        if (endsWith(path, "/input/squeeze/value")) {
-            return rreplace(path, "/input/squeeze/value", "/input/squeeze/click");
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return rreplace(path, "/input/squeeze/force", "/input/squeeze/click");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu") ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/trackpad/x") ||
-                   endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                   endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                   endsWith(path, "/input/trackpad")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapIndexControllerToViveController(const std::string& path) const {
-        if (endsWith(path, "/input/a/click") || endsWith(path, "/input/a")) {
-            return rreplace(path, "/input/a", "/input/menu");
-        } else if (endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                   endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/force") ||
-                   endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/thumbstick")) {
-            return rreplace(path, "/input/thumbstick", "/input/trackpad");
-        } else if (endsWith(path, "/input/squeeze/value")) {
-            return rreplace(path, "/input/squeeze/value", "/input/squeeze/click");
-        } else if (endsWith(path, "/input/squeeze/force")) {
-            return rreplace(path, "/input/squeeze/force", "/input/squeeze/click");
-        } else if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger/touch") || endsWith(path, "/input/trigger")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapSimpleControllerToIndexController(const std::string& path) const {
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            return rreplace(path, "/input/select", "/input/trigger");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapOculusTouchControllerToIndexController(const std::string& path) const {
-        if (path == "/user/hand/left/input/x/click" || path == "/user/hand/left/input/x/touch" ||
-            path == "/user/hand/left/input/x") {
-            return rreplace(path, "/input/x", "/input/a");
-        } else if (path == "/user/hand/left/input/y/click" || path == "/user/hand/left/input/y/touch" ||
-                   path == "/user/hand/left/input/y") {
-            return rreplace(path, "/input/y", "/input/b");
-        } else if (endsWith(path, "/input/thumbrest/touch") || endsWith(path, "/input/thumbrest")) {
-            return rreplace(path, "/input/thumbrest", "/input/trackpad");
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a/touch" ||
-                   path == "/user/hand/right/input/a" || path == "/user/hand/right/input/b/click" ||
-                   path == "/user/hand/right/input/b/touch" || path == "/user/hand/right/input/b" ||
-                   path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/thumbstick/x") ||
-                   endsWith(path, "/input/thumbstick/y") || endsWith(path, "/input/thumbstick/click") ||
-                   endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapMicrosoftMotionControllerToIndexController(const std::string& path) const {
-        if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/trackpad/x") ||
-                   endsWith(path, "/input/trackpad/y") || endsWith(path, "/input/trackpad/click") ||
-                   endsWith(path, "/input/trackpad/force") || endsWith(path, "/input/trackpad/touch") ||
-                   endsWith(path, "/input/trackpad") || endsWith(path, "/input/thumbstick/x") ||
-                   endsWith(path, "/input/thumbstick/y") || endsWith(path, "/input/thumbstick/click") ||
-                   endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapViveControllerToIndexController(const std::string& path) const {
-        if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                   endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                   endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/trackpad")) {
-            return rreplace(path, "/input/trackpad", "/input/thumbstick");
-        } else if (endsWith(path, "/input/system/click") || endsWith(path, "/input/system") ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                   endsWith(path, "/input/squeeze") || endsWith(path, "/input/trigger/click") ||
-                   endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger/touch") ||
-                   endsWith(path, "/input/trigger")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapSimpleControllerToCrystalController(const std::string& path) const {
-        if (endsWith(path, "/input/select/click") || endsWith(path, "/input/select")) {
-            return rreplace(path, "/input/select", "/input/trigger");
-        } else if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu") {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapMicrosoftMotionControllerToCrystalController(const std::string& path) const {
-        if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (path == "/user/hand/left/input/menu/click" || path == "/user/hand/left/input/menu" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/trackpad") ||
-                   endsWith(path, "/input/thumbstick/x") || endsWith(path, "/input/thumbstick/y") ||
-                   endsWith(path, "/input/thumbstick/click") || endsWith(path, "/input/thumbstick/touch") ||
-                   endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapViveControllerToCrystalController(const std::string& path) const {
-        if (path == "/user/hand/right/input/menu/click" || path == "/user/hand/right/input/menu") {
-            return rreplace(path, "/input/menu", "/input/a");
-        } else if (endsWith(path, "/input/trackpad/x") || endsWith(path, "/input/trackpad/y") ||
-                   endsWith(path, "/input/trackpad/click") || endsWith(path, "/input/trackpad/force") ||
-                   endsWith(path, "/input/trackpad/touch") || endsWith(path, "/input/trackpad")) {
-            return rreplace(path, "/input/trackpad", "/input/thumbstick");
-        } else if (path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/force") ||
-                   endsWith(path, "/input/squeeze") || path == "/user/hand/left/input/menu/click" ||
-                   path == "/user/hand/left/input/menu" || endsWith(path, "/input/trigger/click") ||
-                   endsWith(path, "/input/trigger/value") || endsWith(path, "/input/trigger")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapIndexControllerToCrystalController(const std::string& path) const {
-        if (path == "/user/hand/left/input/a/click" || path == "/user/hand/left/input/a/touch" ||
-            path == "/user/hand/left/input/a") {
-            return rreplace(path, "/input/a", "/input/x");
-        } else if (path == "/user/hand/left/input/b/click" || path == "/user/hand/left/input/b/touch" ||
-                   path == "/user/hand/left/input/b") {
-            return rreplace(path, "/input/b", "/input/y");
-        } else if (endsWith(path, "/input/trackpad/touch")) {
-            return rreplace(path, "/input/trackpad", "/input/thumbrest");
-        } else if (path == "/user/hand/right/input/a/click" || path == "/user/hand/right/input/a/touch" ||
-                   path == "/user/hand/right/input/a" || path == "/user/hand/right/input/b/click" ||
-                   path == "/user/hand/right/input/b/touch" || path == "/user/hand/right/input/b" ||
-                   path == "/user/hand/right/input/system/click" || path == "/user/hand/right/input/system" ||
-                   endsWith(path, "/input/squeeze/click") || endsWith(path, "/input/squeeze/value") ||
-                   endsWith(path, "/input/squeeze/force") || endsWith(path, "/input/squeeze") ||
-                   endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger/value") ||
-                   endsWith(path, "/input/trigger") || endsWith(path, "/input/thumbstick/x") ||
-                   endsWith(path, "/input/thumbstick/y") || endsWith(path, "/input/thumbstick/click") ||
-                   endsWith(path, "/input/thumbstick/touch") || endsWith(path, "/input/thumbstick")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapOculusTouchControllerToSimpleController(const std::string& path) const {
-        if (endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger")) {
-            return rreplace(path, "/input/trigger", "/input/select");
-        } else if (endsWith(path, "/input/trigger/value")) {
-            return rreplace(path, "/input/trigger/value", "/input/select/click");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string>
-    OpenXrRuntime::remapMicrosoftMotionControllerToSimpleController(const std::string& path) const {
-        if (endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger")) {
-            return rreplace(path, "/input/trigger", "/input/select");
-        } else if (endsWith(path, "/input/trigger/value")) {
-            return rreplace(path, "/input/trigger/value", "/input/select/click");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapViveControllerToSimpleController(const std::string& path) const {
-        if (endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger")) {
-            return rreplace(path, "/input/trigger", "/input/select");
-        } else if (endsWith(path, "/input/trigger/value")) {
-            return rreplace(path, "/input/trigger/value", "/input/select/click");
-        } else if (endsWith(path, "/input/menu/click") || endsWith(path, "/input/menu")) {
-            return path;
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
-        }
-
-        // No possible binding.
-        return {};
-    }
-
-    std::optional<std::string> OpenXrRuntime::remapIndexControllerToSimpleController(const std::string& path) const {
-        if (endsWith(path, "/input/trigger/click") || endsWith(path, "/input/trigger")) {
-            return rreplace(path, "/input/trigger", "/input/select");
-        } else if (endsWith(path, "/input/trigger/value")) {
-            return rreplace(path, "/input/trigger/value", "/input/select/click");
-        } else if (endsWith(path, "/input/a/click") || endsWith(path, "/input/a")) {
-            return rreplace(path, "/input/a", "/input/menu");
-        } else if (endsWith(path, "/input/grip/pose") || endsWith(path, "/input/grip") ||
-                   endsWith(path, "/input/aim/pose") || endsWith(path, "/input/aim") ||
-                   endsWith(path, "/output/haptic")) {
-            return path;
+    std::string OpenXrRuntime::getControllerLocalizedSourceName(mappings::Profile controllerProfile,
+                                                                const std::string& path) const {
+        const std::string_view name = mappings::getLocalizedSourceName(controllerProfile, path);
+        if (name.empty()) {
+            return "<Unknown>";
         }
 
-        // No possible binding.
-        return {};
+        return std::string(name);
     }
 
 } // namespace pimax_openxr
@@ -0,0 +1,1449 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// The remapping tables are evaluated at compile time. This header deliberately does not depend on PVR or OpenXR, so
+// that it can be compiled and exercised on its own.
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// clang-format off
+#define PIMAX_CONTROLLER_COMPONENTS(_)                          \
+    _(SystemClick,          "/input/system/click")              \
+    _(System,               "/input/system")                    \
+    _(SystemTouch,          "/input/system/touch")              \
+    _(SqueezeClick,         "/input/squeeze/click")             \
+    _(SqueezeValue,         "/input/squeeze/value")             \
+    _(SqueezeForce,         "/input/squeeze/force")             \
+    _(Squeeze,              "/input/squeeze")                   \
+    _(MenuClick,            "/input/menu/click")                \
+    _(Menu,                 "/input/menu")                      \
+    _(TriggerClick,         "/input/trigger/click")             \
+    _(TriggerValue,         "/input/trigger/value")             \
+    _(TriggerTouch,         "/input/trigger/touch")             \
+    _(Trigger,              "/input/trigger")                   \
+    _(Trackpad,             "/input/trackpad")                  \
+    _(TrackpadX,            "/input/trackpad/x")                \
+    _(TrackpadY,            "/input/trackpad/y")                \
+    _(TrackpadClick,        "/input/trackpad/click")            \
+    _(TrackpadForce,        "/input/trackpad/force")            \
+    _(TrackpadTouch,        "/input/trackpad/touch")            \
+    _(Thumbstick,           "/input/thumbstick")                \
+    _(ThumbstickX,          "/input/thumbstick/x")              \
+    _(ThumbstickY,          "/input/thumbstick/y")              \
+    _(ThumbstickClick,      "/input/thumbstick/click")          \
+    _(ThumbstickForce,      "/input/thumbstick/force")          \
+    _(ThumbstickTouch,      "/input/thumbstick/touch")          \
+    _(Thumbrest,            "/input/thumbrest")                 \
+    _(ThumbrestTouch,       "/input/thumbrest/touch")           \
+    _(A,                    "/input/a")                         \
+    _(AClick,               "/input/a/click")                   \
+    _(ATouch,               "/input/a/touch")                   \
+    _(B,                    "/input/b")                         \
+    _(BClick,               "/input/b/click")                   \
+    _(BTouch,               "/input/b/touch")                   \
+    _(X,                    "/input/x")                         \
+    _(XClick,               "/input/x/click")                   \
+    _(XTouch,               "/input/x/touch")                   \
+    _(Y,                    "/input/y")                         \
+    _(YClick,               "/input/y/click")                   \
+    _(YTouch,               "/input/y/touch")                   \
+    _(Select,               "/input/select")                    \
+    _(SelectClick,          "/input/select/click")              \
+    _(Grip,                 "/input/grip")                      \
+    _(GripPose,             "/input/grip/pose")                 \
+    _(Aim,                  "/input/aim")                       \
+    _(AimPose,              "/input/aim/pose")                  \
+    _(Haptic,               "/output/haptic")                   \
+    _(Back,                 "/input/back")                      \
+    _(BackClick,            "/input/back/click")                \
+    _(VolumeUp,             "/input/volume_up")                 \
+    _(VolumeUpClick,        "/input/volume_up/click")           \
+    _(VolumeDown,           "/input/volume_down")               \
+    _(VolumeDownClick,      "/input/volume_down/click")         \
+    _(MuteMic,              "/input/mute_mic")                  \
+    _(MuteMicClick,         "/input/mute_mic/click")            \
+    _(View,                 "/input/view")                      \
+    _(ViewClick,            "/input/view/click")                \
+    _(DpadDown,             "/input/dpad_down")                 \
+    _(DpadDownClick,        "/input/dpad_down/click")           \
+    _(DpadRight,            "/input/dpad_right")                \
+    _(DpadRightClick,       "/input/dpad_right/click")          \
+    _(DpadUp,               "/input/dpad_up")                   \
+    _(DpadUpClick,          "/input/dpad_up/click")             \
+    _(DpadLeft,             "/input/dpad_left")                 \
+    _(DpadLeftClick,        "/input/dpad_left/click")           \
+    _(ShoulderLeft,         "/input/shoulder_left")             \
+    _(ShoulderLeftClick,    "/input/shoulder_left/click")       \
+    _(ShoulderRight,        "/input/shoulder_right")            \
+    _(ShoulderRightClick,   "/input/shoulder_right/click")      \
+    _(TriggerLeft,          "/input/trigger_left")              \
+    _(TriggerLeftClick,     "/input/trigger_left/click")        \
+    _(TriggerLeftValue,     "/input/trigger_left/value")        \
+    _(TriggerLeftForce,     "/input/trigger_left/force")        \
+    _(TriggerRight,         "/input/trigger_right")             \
+    _(TriggerRightClick,    "/input/trigger_right/click")       \
+    _(TriggerRightValue,    "/input/trigger_right/value")       \
+    _(TriggerRightForce,    "/input/trigger_right/force")       \
+    _(ThumbstickLeft,       "/input/thumbstick_left")           \
+    _(ThumbstickLeftX,      "/input/thumbstick_left/x")         \
+    _(ThumbstickLeftY,      "/input/thumbstick_left/y")         \
+    _(ThumbstickLeftClick,  "/input/thumbstick_left/click")     \
+    _(ThumbstickLeftForce,  "/input/thumbstick_left/force")     \
+    _(ThumbstickRight,      "/input/thumbstick_right")          \
+    _(ThumbstickRightX,     "/input/thumbstick_right/x")        \
+    _(ThumbstickRightY,     "/input/thumbstick_right/y")        \
+    _(ThumbstickRightClick, "/input/thumbstick_right/click")    \
+    _(ThumbstickRightForce, "/input/thumbstick_right/force")    \
+    _(HapticLeft,           "/output/haptic_left")              \
+    _(HapticRight,          "/output/haptic_right")             \
+    _(HapticLeftTrigger,    "/output/haptic_left_trigger")      \
+    _(HapticRightTrigger,   "/output/haptic_right_trigger")
+// clang-format on
+
+namespace pimax_openxr::mappings {
+
+    // The interaction profiles that applications may suggest bindings for. Only the first ones can be remapped onto a
+    // physical controller.
+    enum class Profile : uint8_t {
+        SimpleController,
+        ViveController,
+        IndexController,
+        // Also used for the Crystal controller.
+        OculusTouchController,
+        MicrosoftMotionController,
+        GoogleDaydreamController,
+        HtcVivePro,
+        MicrosoftXboxController,
+        OculusGoController,
+
+        Count
+    };
+
+    constexpr size_t k_remappableProfileCount = static_cast<size_t>(Profile::MicrosoftMotionController) + 1;
+
+    constexpr std::array<std::string_view, static_cast<size_t>(Profile::Count)> k_profilePaths = {
+        "/interaction_profiles/khr/simple_controller",
+        "/interaction_profiles/htc/vive_controller",
+        "/interaction_profiles/valve/index_controller",
+        "/interaction_profiles/oculus/touch_controller",
+        "/interaction_profiles/microsoft/motion_controller",
+        "/interaction_profiles/google/daydream_controller",
+        "/interaction_profiles/htc/vive_pro",
+        "/interaction_profiles/microsoft/xbox_controller",
+        "/interaction_profiles/oculus/go_controller",
+    };
+
+    constexpr std::optional<Profile> findProfile(std::string_view path) {
+        for (size_t i = 0; i < k_profilePaths.size(); i++) {
+            if (k_profilePaths[i] == path) {
+                return static_cast<Profile>(i);
+            }
+        }
+        return {};
+    }
+
+    // The components of the input devices, relative to the top-level user path.
+    enum class Component : uint8_t {
+#define COMPONENT_ENUM(name, path) name,
+        PIMAX_CONTROLLER_COMPONENTS(COMPONENT_ENUM)
+#undef COMPONENT_ENUM
+
+        Count
+    };
+
+    constexpr size_t k_componentCount = static_cast<size_t>(Component::Count);
+
+    constexpr std::array<std::string_view, k_componentCount> k_componentPaths = {
+#define COMPONENT_PATH(name, path) path,
+        PIMAX_CONTROLLER_COMPONENTS(COMPONENT_PATH)
+#undef COMPONENT_PATH
+    };
+
+    // The top-level user paths that bindings can be suggested for.
+    enum class UserPath : uint8_t {
+        HandLeft,
+        HandRight,
+        Head,
+        Gamepad,
+        EyesExt,
+
+        Count
+    };
+
+    constexpr std::array<std::string_view, static_cast<size_t>(UserPath::Count)> k_userPaths = {
+        "/user/hand/left",
+        "/user/hand/right",
+        "/user/head",
+        "/user/gamepad",
+        "/user/eyes_ext",
+    };
+
+    constexpr std::optional<UserPath> findUserPath(std::string_view path) {
+        for (size_t i = 0; i < k_userPaths.size(); i++) {
+            if (k_userPaths[i] == path) {
+                return static_cast<UserPath>(i);
+            }
+        }
+        return {};
+    }
+
+    constexpr uint8_t getUserBit(UserPath user) {
+        return static_cast<uint8_t>(1 << static_cast<uint32_t>(user));
+    }
+
+    // The top-level user paths that a table entry applies to.
+    namespace UserMask {
+        constexpr uint8_t Left = getUserBit(UserPath::HandLeft);
+        constexpr uint8_t Right = getUserBit(UserPath::HandRight);
+        constexpr uint8_t Head = getUserBit(UserPath::Head);
+        constexpr uint8_t Gamepad = getUserBit(UserPath::Gamepad);
+        constexpr uint8_t Any = (1 << static_cast<uint32_t>(UserPath::Count)) - 1;
+    } // namespace UserMask
+
+    // FNV-1a, with a seed chosen so that every known component lands in its own slot (see the static_assert below).
+    constexpr uint32_t k_componentHashSeed = 222077516;
+    constexpr uint32_t k_componentHashBits = 8;
+
+    constexpr uint32_t hashComponent(std::string_view component) {
+        uint32_t hash = 2166136261u ^ k_componentHashSeed;
+        for (const char c : component) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        // The low bits of FNV-1a are poorly mixed, use the high bits.
+        return hash >> (32 - k_componentHashBits);
+    }
+
+    constexpr auto k_componentSlots = [] {
+        std::array<Component, 1 << k_componentHashBits> slots{};
+        for (auto& slot : slots) {
+            slot = Component::Count;
+        }
+        for (size_t i = 0; i < k_componentCount; i++) {
+            slots[hashComponent(k_componentPaths[i])] = static_cast<Component>(i);
+        }
+        return slots;
+    }();
+
+    constexpr std::optional<Component> findComponent(std::string_view component) {
+        const Component candidate = k_componentSlots[hashComponent(component)];
+        if (candidate != Component::Count && k_componentPaths[static_cast<size_t>(candidate)] == component) {
+            return candidate;
+        }
+        return {};
+    }
+
+    struct PathParts {
+        UserPath user;
+        Component component;
+    };
+
+    // Split a full path such as /user/hand/left/input/trigger/value into its top-level user path and its component.
+    constexpr std::optional<PathParts> splitPath(std::string_view fullPath) {
+        const size_t input = fullPath.find("/input/");
+        const size_t output = fullPath.find("/output/");
+        const size_t split = input < output ? input : output;
+        if (split == std::string_view::npos) {
+            return {};
+        }
+
+        const auto component = findComponent(fullPath.substr(split));
+        if (!component) {
+            return {};
+        }
+
+        const auto user = findUserPath(fullPath.substr(0, split));
+        if (!user) {
+            return {};
+        }
+
+        return PathParts{user.value(), component.value()};
+    }
+
+    // Where to read a component from in the PVR input state.
+    enum class InputState : uint8_t {
+        // No possible binding.
+        Unbound,
+        // Bound, but there is no input state to read (poses and haptics).
+        None,
+        HandButtons,
+        HandTouches,
+        Trigger,
+        Grip,
+        GripForce,
+        TouchPadForce,
+        JoyStick,
+        TouchPad,
+        // Grip, or the grip button as a workaround for bogus controller firmware.
+        AnalogGrip,
+    };
+
+    // Mirrors the pvrButton values that are used by the tables.
+    enum class Button : uint8_t {
+        None,
+        System,
+        ApplicationMenu,
+        Grip,
+        Trigger,
+        TouchPad,
+        A,
+        B,
+        JoyStick,
+    };
+
+    struct InputField {
+        InputState state{InputState::Unbound};
+        Button button{Button::None};
+        int8_t vector2fIndex{-1};
+    };
+
+    // Some components resolve differently based on the type of the action bound to them.
+    enum class ValueType : uint8_t {
+        Boolean,
+        Float,
+        Other,
+
+        Count
+    };
+
+    struct ComponentBinding {
+        uint8_t users{0};
+        std::array<InputField, static_cast<size_t>(ValueType::Count)> fields{};
+        std::string_view localizedName;
+    };
+
+    using BindingTable = std::array<ComponentBinding, k_componentCount>;
+
+    namespace detail {
+
+        struct BindingEntry {
+            Component component;
+            uint8_t users;
+            InputField boolean;
+            InputField value;
+            InputField other;
+            std::string_view localizedName;
+        };
+
+        constexpr InputField k_noState{InputState::None};
+
+        constexpr InputField button(Button button) {
+            return {InputState::HandButtons, button};
+        }
+
+        constexpr InputField touch(Button button) {
+            return {InputState::HandTouches, button};
+        }
+
+        constexpr InputField analog(InputState state) {
+            return {state};
+        }
+
+        constexpr InputField axis(InputState state, int8_t index) {
+            return {state, Button::None, index};
+        }
+
+        constexpr BindingEntry bind(Component component, InputField field, std::string_view name) {
+            return {component, UserMask::Any, field, field, field, name};
+        }
+
+        constexpr BindingEntry bind(Component component, uint8_t users, InputField field, std::string_view name) {
+            return {component, users, field, field, field, name};
+        }
+
+        constexpr BindingEntry bindByType(Component component,
+                                          InputField boolean,
+                                          InputField value,
+                                          std::string_view name) {
+            return {component, UserMask::Any, boolean, value, {}, name};
+        }
+
+        template <size_t N>
+        constexpr BindingTable makeBindingTable(const std::array<BindingEntry, N>& entries) {
+            BindingTable table{};
+            for (const auto& entry : entries) {
+                auto& binding = table[static_cast<size_t>(entry.component)];
+                binding.users |= entry.users;
+                binding.fields = {entry.boolean, entry.value, entry.other};
+                binding.localizedName = entry.localizedName;
+            }
+
+            // Poses and haptics are always bound.
+            for (const auto& [component, name] : {std::pair{Component::GripPose, "Grip Pose"},
+                                                  std::pair{Component::Grip, "Grip Pose"},
+                                                  std::pair{Component::AimPose, "Aim Pose"},
+                                                  std::pair{Component::Aim, "Aim Pose"},
+                                                  std::pair{Component::Haptic, "Haptics"}}) {
+                auto& binding = table[static_cast<size_t>(component)];
+                binding.users = UserMask::Any;
+                binding.fields = {k_noState, k_noState, k_noState};
+                binding.localizedName = name;
+            }
+
+            return table;
+        }
+
+        template <size_t N>
+        constexpr bool hasUniqueEntries(const std::array<BindingEntry, N>& entries) {
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i + 1; j < N; j++) {
+                    if (entries[i].component == entries[j].component && (entries[i].users & entries[j].users)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        using C = Component;
+        using S = InputState;
+
+        constexpr std::array k_viveControllerEntries = {
+            bind(C::SystemClick, button(Button::System), "System Button"),
+            bind(C::System, button(Button::System), "System Button"),
+            bind(C::SqueezeClick, button(Button::Grip), "Grip Press"),
+            bind(C::SqueezeForce, button(Button::Grip), "Grip Press"),
+            bind(C::Squeeze, button(Button::Grip), "Grip Press"),
+            bind(C::MenuClick, button(Button::ApplicationMenu), "Menu Button"),
+            bind(C::Menu, button(Button::ApplicationMenu), "Menu Button"),
+            bind(C::TriggerClick, button(Button::Trigger), "Trigger Press"),
+            bindByType(C::Trigger, button(Button::Trigger), analog(S::Trigger), "Trigger"),
+            bind(C::TriggerValue, analog(S::Trigger), "Trigger"),
+            bind(C::Trackpad, axis(S::TouchPad, -1), "Trackpad"),
+            bind(C::TrackpadX, axis(S::TouchPad, 0), "Trackpad X axis"),
+            bind(C::TrackpadY, axis(S::TouchPad, 1), "Trackpad Y axis"),
+            bind(C::TrackpadClick, button(Button::TouchPad), "Trackpad Press"),
+            bind(C::TrackpadForce, button(Button::TouchPad), "Trackpad Press"),
+            bind(C::TrackpadTouch, touch(Button::TouchPad), "Trackpad Touch"),
+        };
+
+        constexpr std::array k_indexControllerEntries = {
+            bind(C::SystemClick, button(Button::System), "System Button"),
+            bind(C::System, button(Button::System), "System Button"),
+            bind(C::SystemTouch, touch(Button::System), "System Touch"),
+            bind(C::AClick, button(Button::A), "A Button"),
+            bind(C::A, button(Button::A), "A Button"),
+            bind(C::ATouch, touch(Button::A), "A Touch"),
+            bind(C::BClick, button(Button::B), "B Button"),
+            bind(C::B, button(Button::B), "B Button"),
+            bind(C::BTouch, touch(Button::B), "B Touch"),
+            // We use the floatValue for squeeze/click since the threshhold for HandButtons seems too high.
+            bind(C::SqueezeValue, analog(S::Grip), "Grip"),
+            bind(C::SqueezeClick, analog(S::Grip), "Grip"),
+            bind(C::Squeeze, analog(S::Grip), "Grip"),
+            bind(C::SqueezeForce, analog(S::GripForce), "Grip Force"),
+            bind(C::TriggerClick, button(Button::Trigger), "Trigger Press"),
+            bindByType(C::Trigger, button(Button::Trigger), analog(S::Trigger), "Trigger"),
+            bind(C::TriggerValue, analog(S::Trigger), "Trigger"),
+            bind(C::TriggerTouch, touch(Button::Trigger), "Trigger Touch"),
+            bind(C::Thumbstick, axis(S::JoyStick, -1), "Joystick"),
+            bind(C::ThumbstickX, axis(S::JoyStick, 0), "Joystic X axis"),
+            bind(C::ThumbstickY, axis(S::JoyStick, 1), "Joystick Y axis"),
+            bind(C::ThumbstickClick, button(Button::JoyStick), "Joystick Press"),
+            bind(C::ThumbstickTouch, touch(Button::JoyStick), "Joystick Touch"),
+            bind(C::Trackpad, axis(S::TouchPad, -1), "Trackpad"),
+            bind(C::TrackpadX, axis(S::TouchPad, 0), "Trackpad X axis"),
+            bind(C::TrackpadY, axis(S::TouchPad, 1), "Trackpad Y axis"),
+            bind(C::TrackpadForce, analog(S::TouchPadForce), "Trackpad Force"),
+            bind(C::TrackpadTouch, touch(Button::TouchPad), "Trackpad Touch"),
+        };
+
+        constexpr std::array k_crystalControllerEntries = {
+            bind(C::XClick, UserMask::Left, button(Button::A), "X Button"),
+            bind(C::X, UserMask::Left, button(Button::A), "X Button"),
+            bind(C::XTouch, UserMask::Left, touch(Button::A), "X Touch"),
+            bind(C::YClick, UserMask::Left, button(Button::B), "Y Button"),
+            bind(C::Y, UserMask::Left, button(Button::B), "Y Button"),
+            bind(C::YTouch, UserMask::Left, touch(Button::B), "Y Touch"),
+            bind(C::MenuClick, UserMask::Left, button(Button::ApplicationMenu), "Menu Button"),
+            bind(C::Menu, UserMask::Left, button(Button::ApplicationMenu), "Menu Button"),
+            bind(C::AClick, UserMask::Right, button(Button::A), "A Button"),
+            bind(C::A, UserMask::Right, button(Button::A), "A Button"),
+            bind(C::ATouch, UserMask::Right, touch(Button::A), "A Touch"),
+            bind(C::BClick, UserMask::Right, button(Button::B), "B Button"),
+            bind(C::B, UserMask::Right, button(Button::B), "B Button"),
+            bind(C::BTouch, UserMask::Right, touch(Button::B), "B Touch"),
+            bind(C::SystemClick, UserMask::Right, button(Button::System), "System Button"),
+            bind(C::System, UserMask::Right, button(Button::System), "System Button"),
+            bind(C::SqueezeClick, button(Button::Grip), "Grip"),
+            bindByType(C::Squeeze, button(Button::Grip), analog(S::AnalogGrip), "Grip"),
+            bind(C::SqueezeValue, analog(S::AnalogGrip), "Grip"),
+            bind(C::SqueezeForce, analog(S::GripForce), "Grip Force"),
+            bind(C::TriggerClick, button(Button::Trigger), "Trigger Press"),
+            bindByType(C::Trigger, button(Button::Trigger), analog(S::Trigger), "Trigger"),
+            bind(C::TriggerValue, analog(S::Trigger), "Trigger"),
+            bind(C::TriggerTouch, touch(Button::Trigger), "Trigger Touch"),
+            bind(C::Thumbstick, axis(S::JoyStick, -1), "Joystick"),
+            bind(C::ThumbstickX, axis(S::JoyStick, 0), "Joystic X axis"),
+            bind(C::ThumbstickY, axis(S::JoyStick, 1), "Joystick Y axis"),
+            bind(C::ThumbstickClick, button(Button::JoyStick), "Joystick Press"),
+            bind(C::ThumbstickTouch, touch(Button::JoyStick), "Joystick Touch"),
+            bind(C::ThumbrestTouch, touch(Button::TouchPad), "Thumbrest Touch"),
+            bind(C::Thumbrest, touch(Button::TouchPad), "Thumbrest Touch"),
+        };
+
+        constexpr std::array k_simpleControllerEntries = {
+            bind(C::SelectClick, button(Button::Trigger), "Trigger Press"),
+            bind(C::Select, button(Button::Trigger), "Trigger Press"),
+            bind(C::MenuClick, button(Button::ApplicationMenu), "Menu Button"),
+            bind(C::Menu, button(Button::ApplicationMenu), "Menu Button"),
+        };
+
+        static_assert(hasUniqueEntries(k_viveControllerEntries));
+        static_assert(hasUniqueEntries(k_indexControllerEntries));
+        static_assert(hasUniqueEntries(k_crystalControllerEntries));
+        static_assert(hasUniqueEntries(k_simpleControllerEntries));
+
+    } // namespace detail
+
+    // The components of the physical controller, indexed by the interaction profile it is exposed as. There is no
+    // physical controller behind the Microsoft motion controller profile.
+    constexpr std::array<BindingTable, k_remappableProfileCount> k_bindingTables = {
+        detail::makeBindingTable(detail::k_simpleControllerEntries),
+        detail::makeBindingTable(detail::k_viveControllerEntries),
+        detail::makeBindingTable(detail::k_indexControllerEntries),
+        detail::makeBindingTable(detail::k_crystalControllerEntries),
+        BindingTable{},
+    };
+
+    // For each component of the suggested interaction profile, the component of the physical controller that it maps
+    // to, for each top-level user path. Component::Count means there is no possible binding.
+    using RemapTable = std::array<std::array<Component, static_cast<size_t>(UserPath::Count)>, k_componentCount>;
+
+    namespace detail {
+
+        struct RemapEntry {
+            Component from;
+            uint8_t users;
+            Component to;
+        };
+
+        constexpr RemapEntry remap(Component from, Component to) {
+            return {from, UserMask::Any, to};
+        }
+
+        constexpr RemapEntry remap(Component from, uint8_t users, Component to) {
+            return {from, users, to};
+        }
+
+        constexpr RemapEntry keep(Component component) {
+            return {component, UserMask::Any, component};
+        }
+
+        constexpr RemapEntry keep(Component component, uint8_t users) {
+            return {component, users, component};
+        }
+
+        constexpr RemapTable makeIdentityRemapTable() {
+            RemapTable table{};
+            for (size_t i = 0; i < k_componentCount; i++) {
+                for (auto& to : table[i]) {
+                    to = static_cast<Component>(i);
+                }
+            }
+            return table;
+        }
+
+        template <size_t N>
+        constexpr RemapTable makeRemapTable(const std::array<RemapEntry, N>& entries) {
+            RemapTable table{};
+            for (auto& targets : table) {
+                for (auto& to : targets) {
+                    to = Component::Count;
+                }
+            }
+            for (const auto& entry : entries) {
+                for (uint32_t user = 0; user < static_cast<uint32_t>(UserPath::Count); user++) {
+                    if (entry.users & (1 << user)) {
+                        table[static_cast<size_t>(entry.from)][user] = entry.to;
+                    }
+                }
+            }
+
+            // Poses and haptics are always passed through.
+            for (const auto component : {C::GripPose, C::Grip, C::AimPose, C::Aim, C::Haptic}) {
+                for (auto& to : table[static_cast<size_t>(component)]) {
+                    to = component;
+                }
+            }
+
+            return table;
+        }
+
+        template <size_t N>
+        constexpr bool hasUniqueEntries(const std::array<RemapEntry, N>& entries) {
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i + 1; j < N; j++) {
+                    if (entries[i].from == entries[j].from && (entries[i].users & entries[j].users)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        constexpr std::array k_simpleControllerToViveController = {
+            remap(C::SelectClick, C::TriggerClick),
+            remap(C::Select, C::Trigger),
+            keep(C::MenuClick),
+            keep(C::Menu),
+        };
+
+        constexpr std::array k_oculusTouchControllerToViveController = {
+            remap(C::ThumbstickX, C::TrackpadX),
+            remap(C::ThumbstickY, C::TrackpadY),
+            remap(C::ThumbstickClick, C::TrackpadClick),
+            remap(C::ThumbstickTouch, C::TrackpadTouch),
+            remap(C::Thumbstick, C::Trackpad),
+            remap(C::SqueezeValue, C::SqueezeClick),
+            remap(C::SqueezeForce, C::SqueezeClick),
+            remap(C::AClick, UserMask::Right, C::MenuClick),
+            remap(C::A, UserMask::Right, C::MenuClick),
+            keep(C::SystemClick),
+            keep(C::System),
+            keep(C::MenuClick),
+            keep(C::Menu),
+            keep(C::SqueezeClick),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+        };
+
+        constexpr std::array k_microsoftMotionControllerToViveController = {
+            remap(C::SqueezeValue, C::SqueezeClick),
+            remap(C::SqueezeForce, C::SqueezeClick),
+            keep(C::MenuClick),
+            keep(C::Menu),
+            keep(C::SqueezeClick),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+            keep(C::TrackpadX),
+            keep(C::TrackpadY),
+            keep(C::TrackpadClick),
+            keep(C::TrackpadForce),
+            keep(C::TrackpadTouch),
+            keep(C::Trackpad),
+        };
+
+        constexpr std::array k_indexControllerToViveController = {
+            remap(C::AClick, C::MenuClick),
+            remap(C::A, C::Menu),
+            remap(C::ThumbstickX, C::TrackpadX),
+            remap(C::ThumbstickY, C::TrackpadY),
+            remap(C::ThumbstickClick, C::TrackpadClick),
+            remap(C::ThumbstickForce, C::TrackpadForce),
+            remap(C::ThumbstickTouch, C::TrackpadTouch),
+            remap(C::Thumbstick, C::Trackpad),
+            remap(C::SqueezeValue, C::SqueezeClick),
+            remap(C::SqueezeForce, C::SqueezeClick),
+            keep(C::SystemClick),
+            keep(C::System),
+            keep(C::SqueezeClick),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::TriggerTouch),
+            keep(C::Trigger),
+        };
+
+        constexpr std::array k_simpleControllerToIndexController = {
+            remap(C::SelectClick, C::TriggerClick),
+            remap(C::Select, C::Trigger),
+            remap(C::MenuClick, C::AClick),
+            remap(C::Menu, C::A),
+        };
+
+        constexpr std::array k_oculusTouchControllerToIndexController = {
+            remap(C::XClick, UserMask::Left, C::AClick),
+            remap(C::XTouch, UserMask::Left, C::ATouch),
+            remap(C::X, UserMask::Left, C::A),
+            remap(C::YClick, UserMask::Left, C::BClick),
+            remap(C::YTouch, UserMask::Left, C::BTouch),
+            remap(C::Y, UserMask::Left, C::B),
+            remap(C::ThumbrestTouch, C::TrackpadTouch),
+            remap(C::Thumbrest, C::Trackpad),
+            keep(C::AClick, UserMask::Right),
+            keep(C::ATouch, UserMask::Right),
+            keep(C::A, UserMask::Right),
+            keep(C::BClick, UserMask::Right),
+            keep(C::BTouch, UserMask::Right),
+            keep(C::B, UserMask::Right),
+            keep(C::SystemClick, UserMask::Right),
+            keep(C::System, UserMask::Right),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeValue),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+            keep(C::ThumbstickX),
+            keep(C::ThumbstickY),
+            keep(C::ThumbstickClick),
+            keep(C::ThumbstickTouch),
+            keep(C::Thumbstick),
+        };
+
+        constexpr std::array k_microsoftMotionControllerToIndexController = {
+            remap(C::MenuClick, C::AClick),
+            remap(C::Menu, C::A),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeValue),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+            keep(C::TrackpadX),
+            keep(C::TrackpadY),
+            keep(C::TrackpadClick),
+            keep(C::TrackpadForce),
+            keep(C::TrackpadTouch),
+            keep(C::Trackpad),
+            keep(C::ThumbstickX),
+            keep(C::ThumbstickY),
+            keep(C::ThumbstickClick),
+            keep(C::ThumbstickTouch),
+            keep(C::Thumbstick),
+        };
+
+        constexpr std::array k_viveControllerToIndexController = {
+            remap(C::MenuClick, C::AClick),
+            remap(C::Menu, C::A),
+            remap(C::TrackpadX, C::ThumbstickX),
+            remap(C::TrackpadY, C::ThumbstickY),
+            remap(C::TrackpadClick, C::ThumbstickClick),
+            remap(C::TrackpadForce, C::ThumbstickForce),
+            remap(C::TrackpadTouch, C::ThumbstickTouch),
+            remap(C::Trackpad, C::Thumbstick),
+            keep(C::SystemClick),
+            keep(C::System),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::TriggerTouch),
+            keep(C::Trigger),
+        };
+
+        constexpr std::array k_simpleControllerToCrystalController = {
+            remap(C::SelectClick, C::TriggerClick),
+            remap(C::Select, C::Trigger),
+            remap(C::MenuClick, UserMask::Right, C::AClick),
+            remap(C::Menu, UserMask::Right, C::A),
+            keep(C::MenuClick, UserMask::Left),
+            keep(C::Menu, UserMask::Left),
+        };
+
+        constexpr std::array k_microsoftMotionControllerToCrystalController = {
+            remap(C::MenuClick, UserMask::Right, C::AClick),
+            remap(C::Menu, UserMask::Right, C::A),
+            keep(C::MenuClick, UserMask::Left),
+            keep(C::Menu, UserMask::Left),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeValue),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+            keep(C::Trackpad),
+            keep(C::ThumbstickX),
+            keep(C::ThumbstickY),
+            keep(C::ThumbstickClick),
+            keep(C::ThumbstickTouch),
+            keep(C::Thumbstick),
+        };
+
+        constexpr std::array k_viveControllerToCrystalController = {
+            remap(C::MenuClick, UserMask::Right, C::AClick),
+            remap(C::Menu, UserMask::Right, C::A),
+            remap(C::TrackpadX, C::ThumbstickX),
+            remap(C::TrackpadY, C::ThumbstickY),
+            remap(C::TrackpadClick, C::ThumbstickClick),
+            remap(C::TrackpadForce, C::ThumbstickForce),
+            remap(C::TrackpadTouch, C::ThumbstickTouch),
+            remap(C::Trackpad, C::Thumbstick),
+            keep(C::SystemClick, UserMask::Right),
+            keep(C::System, UserMask::Right),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::MenuClick, UserMask::Left),
+            keep(C::Menu, UserMask::Left),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+        };
+
+        constexpr std::array k_indexControllerToCrystalController = {
+            remap(C::AClick, UserMask::Left, C::XClick),
+            remap(C::ATouch, UserMask::Left, C::XTouch),
+            remap(C::A, UserMask::Left, C::X),
+            remap(C::BClick, UserMask::Left, C::YClick),
+            remap(C::BTouch, UserMask::Left, C::YTouch),
+            remap(C::B, UserMask::Left, C::Y),
+            remap(C::TrackpadTouch, C::ThumbrestTouch),
+            keep(C::AClick, UserMask::Right),
+            keep(C::ATouch, UserMask::Right),
+            keep(C::A, UserMask::Right),
+            keep(C::BClick, UserMask::Right),
+            keep(C::BTouch, UserMask::Right),
+            keep(C::B, UserMask::Right),
+            keep(C::SystemClick, UserMask::Right),
+            keep(C::System, UserMask::Right),
+            keep(C::SqueezeClick),
+            keep(C::SqueezeValue),
+            keep(C::SqueezeForce),
+            keep(C::Squeeze),
+            keep(C::TriggerClick),
+            keep(C::TriggerValue),
+            keep(C::Trigger),
+            keep(C::ThumbstickX),
+            keep(C::ThumbstickY),
+            keep(C::ThumbstickClick),
+            keep(C::ThumbstickTouch),
+            keep(C::Thumbstick),
+        };
+
+        // All the controllers expose their trigger as select and their main button as menu.
+        constexpr std::array k_anyControllerToSimpleController = {
+            remap(C::TriggerClick, C::SelectClick),
+            remap(C::Trigger, C::Select),
+            remap(C::TriggerValue, C::SelectClick),
+            keep(C::MenuClick),
+            keep(C::Menu),
+        };
+
+        constexpr std::array k_indexControllerToSimpleController = {
+            remap(C::TriggerClick, C::SelectClick),
+            remap(C::Trigger, C::Select),
+            remap(C::TriggerValue, C::SelectClick),
+            remap(C::AClick, C::MenuClick),
+            remap(C::A, C::Menu),
+        };
+
+        static_assert(hasUniqueEntries(k_simpleControllerToViveController));
+        static_assert(hasUniqueEntries(k_oculusTouchControllerToViveController));
+        static_assert(hasUniqueEntries(k_microsoftMotionControllerToViveController));
+        static_assert(hasUniqueEntries(k_indexControllerToViveController));
+        static_assert(hasUniqueEntries(k_simpleControllerToIndexController));
+        static_assert(hasUniqueEntries(k_oculusTouchControllerToIndexController));
+        static_assert(hasUniqueEntries(k_microsoftMotionControllerToIndexController));
+        static_assert(hasUniqueEntries(k_viveControllerToIndexController));
+        static_assert(hasUniqueEntries(k_simpleControllerToCrystalController));
+        static_assert(hasUniqueEntries(k_microsoftMotionControllerToCrystalController));
+        static_assert(hasUniqueEntries(k_viveControllerToCrystalController));
+        static_assert(hasUniqueEntries(k_indexControllerToCrystalController));
+        static_assert(hasUniqueEntries(k_anyControllerToSimpleController));
+        static_assert(hasUniqueEntries(k_indexControllerToSimpleController));
+
+    } // namespace detail
+
+    // Indexed by [suggested interaction profile][interaction profile of the physical controller].
+    constexpr std::array<std::array<RemapTable, k_remappableProfileCount>, k_remappableProfileCount> k_remapTables = {{
+        // From the Simple controller.
+        {
+            detail::makeIdentityRemapTable(),
+            detail::makeRemapTable(detail::k_simpleControllerToViveController),
+            detail::makeRemapTable(detail::k_simpleControllerToIndexController),
+            detail::makeRemapTable(detail::k_simpleControllerToCrystalController),
+            detail::makeRemapTable(std::array<detail::RemapEntry, 0>{}),
+        },
+        // From the Vive controller.
+        {
+            detail::makeRemapTable(detail::k_anyControllerToSimpleController),
+            detail::makeIdentityRemapTable(),
+            detail::makeRemapTable(detail::k_viveControllerToIndexController),
+            detail::makeRemapTable(detail::k_viveControllerToCrystalController),
+            detail::makeRemapTable(std::array<detail::RemapEntry, 0>{}),
+        },
+        // From the Index controller.
+        {
+            detail::makeRemapTable(detail::k_indexControllerToSimpleController),
+            detail::makeRemapTable(detail::k_indexControllerToViveController),
+            detail::makeIdentityRemapTable(),
+            detail::makeRemapTable(detail::k_indexControllerToCrystalController),
+            detail::makeRemapTable(std::array<detail::RemapEntry, 0>{}),
+        },
+        // From the Oculus Touch controller.
+        {
+            detail::makeRemapTable(detail::k_anyControllerToSimpleController),
+            detail::makeRemapTable(detail::k_oculusTouchControllerToViveController),
+            detail::makeRemapTable(detail::k_oculusTouchControllerToIndexController),
+            detail::makeIdentityRemapTable(),
+            detail::makeRemapTable(std::array<detail::RemapEntry, 0>{}),
+        },
+        // From the Microsoft motion controller.
+        {
+            detail::makeRemapTable(detail::k_anyControllerToSimpleController),
+            detail::makeRemapTable(detail::k_microsoftMotionControllerToViveController),
+            detail::makeRemapTable(detail::k_microsoftMotionControllerToIndexController),
+            detail::makeRemapTable(detail::k_microsoftMotionControllerToCrystalController),
+            detail::makeRemapTable(std::array<detail::RemapEntry, 0>{}),
+        },
+    }};
+
+    struct ResolvedBinding {
+        InputField field;
+        // The component of the physical controller.
+        Component component;
+    };
+
+    // Resolve a binding suggested for an interaction profile onto the physical controller exposed as another (or the
+    // same) interaction profile.
+    constexpr std::optional<ResolvedBinding> resolveBinding(
+        Profile suggestedProfile, Profile controllerProfile, UserPath user, Component component, ValueType type) {
+        if (static_cast<size_t>(suggestedProfile) >= k_remappableProfileCount ||
+            static_cast<size_t>(controllerProfile) >= k_remappableProfileCount || user == UserPath::Count ||
+            component == Component::Count) {
+            return {};
+        }
+
+        const Component target =
+            k_remapTables[static_cast<size_t>(suggestedProfile)][static_cast<size_t>(controllerProfile)]
+                         [static_cast<size_t>(component)][static_cast<size_t>(user)];
+        if (target == Component::Count) {
+            return {};
+        }
+
+        const auto& binding = k_bindingTables[static_cast<size_t>(controllerProfile)][static_cast<size_t>(target)];
+        const InputField& field = binding.fields[static_cast<size_t>(type)];
+        if (!(binding.users & getUserBit(user)) || field.state == InputState::Unbound) {
+            return {};
+        }
+
+        return ResolvedBinding{field, target};
+    }
+
+    constexpr std::optional<ResolvedBinding> resolveBinding(Profile suggestedProfile,
+                                                            Profile controllerProfile,
+                                                            std::string_view fullPath,
+                                                            ValueType type) {
+        const auto parts = splitPath(fullPath);
+        if (!parts) {
+            return {};
+        }
+        return resolveBinding(suggestedProfile, controllerProfile, parts->user, parts->component, type);
+    }
+
+    // Returns an empty string for components that do not exist on the controller.
+    constexpr std::string_view getLocalizedSourceName(Profile controllerProfile, std::string_view fullPath) {
+        const auto parts = splitPath(fullPath);
+        if (!parts || static_cast<size_t>(controllerProfile) >= k_remappableProfileCount) {
+            return {};
+        }
+
+        const auto& binding =
+            k_bindingTables[static_cast<size_t>(controllerProfile)][static_cast<size_t>(parts->component)];
+        if (!(binding.users & getUserBit(parts->user))) {
+            return {};
+        }
+        return binding.localizedName;
+    }
+
+    // For each component, the top-level user paths it can be suggested for.
+    using ValidComponentTable = std::array<uint8_t, k_componentCount>;
+
+    namespace detail {
+
+        struct ValidComponentEntry {
+            Component component;
+            uint8_t users;
+        };
+
+        constexpr ValidComponentTable makeValidComponentTable(const BindingTable& bindings) {
+            ValidComponentTable table{};
+            for (size_t i = 0; i < k_componentCount; i++) {
+                table[i] = bindings[i].users;
+            }
+            return table;
+        }
+
+        template <size_t N>
+        constexpr ValidComponentTable makeValidComponentTable(const std::array<ValidComponentEntry, N>& entries) {
+            ValidComponentTable table{};
+            for (const auto& entry : entries) {
+                table[static_cast<size_t>(entry.component)] |= entry.users;
+            }
+            return table;
+        }
+
+        constexpr ValidComponentEntry valid(Component component, uint8_t users = UserMask::Any) {
+            return {component, users};
+        }
+
+        constexpr std::array k_microsoftMotionControllerComponents = {
+            valid(C::MenuClick),
+            valid(C::Menu),
+            valid(C::SqueezeClick),
+            valid(C::SqueezeValue),
+            valid(C::SqueezeForce),
+            valid(C::Squeeze),
+            valid(C::TriggerClick),
+            valid(C::TriggerValue),
+            valid(C::Trigger),
+            valid(C::Thumbstick),
+            valid(C::ThumbstickX),
+            valid(C::ThumbstickY),
+            valid(C::ThumbstickClick),
+            valid(C::ThumbstickForce),
+            valid(C::ThumbstickTouch),
+            valid(C::Trackpad),
+            valid(C::TrackpadX),
+            valid(C::TrackpadY),
+            valid(C::TrackpadClick),
+            valid(C::TrackpadForce),
+            valid(C::TrackpadTouch),
+            valid(C::GripPose),
+            valid(C::Grip),
+            valid(C::AimPose),
+            valid(C::Aim),
+            valid(C::Haptic),
+        };
+
+        constexpr std::array k_googleDaydreamControllerComponents = {
+            valid(C::SelectClick),
+            valid(C::Select),
+            valid(C::Trackpad),
+            valid(C::TrackpadX),
+            valid(C::TrackpadY),
+            valid(C::TrackpadClick),
+            valid(C::TrackpadForce),
+            valid(C::TrackpadTouch),
+            valid(C::GripPose),
+            valid(C::Grip),
+            valid(C::AimPose),
+            valid(C::Aim),
+        };
+
+        constexpr std::array k_htcViveProComponents = {
+            valid(C::SystemClick, UserMask::Head),
+            valid(C::System, UserMask::Head),
+            valid(C::VolumeUpClick, UserMask::Head),
+            valid(C::VolumeUp, UserMask::Head),
+            valid(C::VolumeDownClick, UserMask::Head),
+            valid(C::VolumeDown, UserMask::Head),
+            valid(C::MuteMicClick, UserMask::Head),
+            valid(C::MuteMic, UserMask::Head),
+        };
+
+        constexpr std::array k_microsoftXboxControllerComponents = {
+            valid(C::MenuClick, UserMask::Gamepad),
+            valid(C::Menu, UserMask::Gamepad),
+            valid(C::ViewClick, UserMask::Gamepad),
+            valid(C::View, UserMask::Gamepad),
+            valid(C::AClick, UserMask::Gamepad),
+            valid(C::A, UserMask::Gamepad),
+            valid(C::BClick, UserMask::Gamepad),
+            valid(C::B, UserMask::Gamepad),
+            valid(C::XClick, UserMask::Gamepad),
+            valid(C::X, UserMask::Gamepad),
+            valid(C::YClick, UserMask::Gamepad),
+            valid(C::Y, UserMask::Gamepad),
+            valid(C::DpadDownClick, UserMask::Gamepad),
+            valid(C::DpadDown, UserMask::Gamepad),
+            valid(C::DpadRightClick, UserMask::Gamepad),
+            valid(C::DpadRight, UserMask::Gamepad),
+            valid(C::DpadUpClick, UserMask::Gamepad),
+            valid(C::DpadUp, UserMask::Gamepad),
+            valid(C::DpadLeftClick, UserMask::Gamepad),
+            valid(C::DpadLeft, UserMask::Gamepad),
+            valid(C::ShoulderLeftClick, UserMask::Gamepad),
+            valid(C::ShoulderLeft, UserMask::Gamepad),
+            valid(C::ShoulderRightClick, UserMask::Gamepad),
+            valid(C::ShoulderRight, UserMask::Gamepad),
+            valid(C::TriggerLeftClick, UserMask::Gamepad),
+            valid(C::TriggerLeftValue, UserMask::Gamepad),
+            valid(C::TriggerLeftForce, UserMask::Gamepad),
+            valid(C::TriggerLeft, UserMask::Gamepad),
+            valid(C::TriggerRightClick, UserMask::Gamepad),
+            valid(C::TriggerRightValue, UserMask::Gamepad),
+            valid(C::TriggerRightForce, UserMask::Gamepad),
+            valid(C::TriggerRight, UserMask::Gamepad),
+            valid(C::ThumbstickLeft, UserMask::Gamepad),
+            valid(C::ThumbstickLeftX, UserMask::Gamepad),
+            valid(C::ThumbstickLeftY, UserMask::Gamepad),
+            valid(C::ThumbstickLeftClick, UserMask::Gamepad),
+            valid(C::ThumbstickLeftForce, UserMask::Gamepad),
+            valid(C::ThumbstickRight, UserMask::Gamepad),
+            valid(C::ThumbstickRightX, UserMask::Gamepad),
+            valid(C::ThumbstickRightY, UserMask::Gamepad),
+            valid(C::ThumbstickRightClick, UserMask::Gamepad),
+            valid(C::ThumbstickRightForce, UserMask::Gamepad),
+            valid(C::HapticLeft, UserMask::Gamepad),
+            valid(C::HapticRight, UserMask::Gamepad),
+            valid(C::HapticLeftTrigger, UserMask::Gamepad),
+            valid(C::HapticRightTrigger, UserMask::Gamepad),
+        };
+
+        constexpr std::array k_oculusGoControllerComponents = {
+            valid(C::SystemClick),
+            valid(C::System),
+            valid(C::TriggerClick),
+            valid(C::Trigger),
+            valid(C::BackClick),
+            valid(C::Back),
+            valid(C::Trackpad),
+            valid(C::TrackpadX),
+            valid(C::TrackpadY),
+            valid(C::TrackpadClick),
+            valid(C::TrackpadForce),
+            valid(C::TrackpadTouch),
+            valid(C::GripPose),
+            valid(C::Grip),
+            valid(C::AimPose),
+            valid(C::Aim),
+        };
+
+    } // namespace detail
+
+    constexpr std::array<ValidComponentTable, static_cast<size_t>(Profile::Count)> k_validComponentTables = {
+        detail::makeValidComponentTable(k_bindingTables[static_cast<size_t>(Profile::SimpleController)]),
+        detail::makeValidComponentTable(k_bindingTables[static_cast<size_t>(Profile::ViveController)]),
+        detail::makeValidComponentTable(k_bindingTables[static_cast<size_t>(Profile::IndexController)]),
+        detail::makeValidComponentTable(k_bindingTables[static_cast<size_t>(Profile::OculusTouchController)]),
+        detail::makeValidComponentTable(detail::k_microsoftMotionControllerComponents),
+        detail::makeValidComponentTable(detail::k_googleDaydreamControllerComponents),
+        detail::makeValidComponentTable(detail::k_htcViveProComponents),
+        detail::makeValidComponentTable(detail::k_microsoftXboxControllerComponents),
+        detail::makeValidComponentTable(detail::k_oculusGoControllerComponents),
+    };
+
+    // Whether a binding to this component may be suggested for the interaction profile.
+    constexpr bool isValidComponent(Profile profile, UserPath user, Component component) {
+        if (profile == Profile::Count || user == UserPath::Count || component == Component::Count) {
+            return false;
+        }
+        return k_validComponentTables[static_cast<size_t>(profile)][static_cast<size_t>(component)] &
+               getUserBit(user);
+    }
+
+    // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#well-formed-path-strings
+    namespace detail {
+
+        // The characters allowed in a path, remapped to a dense alphabet: a-z, 0-9, '-', '_', '.' and '/'.
+        constexpr uint8_t k_invalidSymbol = 0xff;
+        constexpr uint8_t k_dotSymbol = 38;
+        constexpr uint8_t k_slashSymbol = 39;
+        constexpr uint32_t k_symbolCount = 40;
+
+        constexpr auto k_pathSymbols = [] {
+            std::array<uint8_t, 256> symbols{};
+            for (auto& symbol : symbols) {
+                symbol = k_invalidSymbol;
+            }
+            for (uint8_t c = 'a'; c <= 'z'; c++) {
+                symbols[c] = c - 'a';
+            }
+            for (uint8_t c = '0'; c <= '9'; c++) {
+                symbols[c] = 26 + c - '0';
+            }
+            symbols['-'] = 36;
+            symbols['_'] = 37;
+            symbols['.'] = k_dotSymbol;
+            symbols['/'] = k_slashSymbol;
+            return symbols;
+        }();
+
+        constexpr uint8_t getPathSymbol(char c) {
+            return k_pathSymbols[static_cast<uint8_t>(c)];
+        }
+
+        // The path syntax, one state per position within a path element.
+        enum class SyntaxState : uint8_t {
+            // Expecting the leading '/'.
+            Start,
+            // Right after a '/', an element may not be empty.
+            ElementStart,
+            // An element made of dots only so far, which is not allowed.
+            DotsOnly,
+            // A well-formed element, the path may end here.
+            Element,
+            Rejected,
+
+            Count
+        };
+
+        constexpr auto k_syntaxTransitions = [] {
+            // Indexed by [state][0 for '/', 1 for '.', 2 for other valid characters].
+            std::array<std::array<SyntaxState, 3>, static_cast<size_t>(SyntaxState::Count)> transitions{};
+            using S = SyntaxState;
+            transitions[static_cast<size_t>(S::Start)] = {S::ElementStart, S::Rejected, S::Rejected};
+            transitions[static_cast<size_t>(S::ElementStart)] = {S::Rejected, S::DotsOnly, S::Element};
+            transitions[static_cast<size_t>(S::DotsOnly)] = {S::Rejected, S::DotsOnly, S::Element};
+            transitions[static_cast<size_t>(S::Element)] = {S::ElementStart, S::Element, S::Element};
+            transitions[static_cast<size_t>(S::Rejected)] = {S::Rejected, S::Rejected, S::Rejected};
+            return transitions;
+        }();
+
+        constexpr SyntaxState nextSyntaxState(SyntaxState state, uint8_t symbol) {
+            const size_t input = symbol == k_slashSymbol ? 0 : (symbol == k_dotSymbol ? 1 : 2);
+            return k_syntaxTransitions[static_cast<size_t>(state)][input];
+        }
+
+    } // namespace detail
+
+    // Whether a string only uses the characters allowed in a path element (for action and action set names).
+    constexpr bool isWellFormedName(std::string_view name) {
+        for (const char c : name) {
+            const uint8_t symbol = detail::getPathSymbol(c);
+            if (symbol == detail::k_invalidSymbol || symbol == detail::k_slashSymbol) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool isWellFormedPath(std::string_view path) {
+        detail::SyntaxState state = detail::SyntaxState::Start;
+        for (const char c : path) {
+            const uint8_t symbol = detail::getPathSymbol(c);
+            if (symbol == detail::k_invalidSymbol) {
+                return false;
+            }
+            state = detail::nextSyntaxState(state, symbol);
+        }
+        return state == detail::SyntaxState::Element;
+    }
+
+    struct PathMatch {
+        bool isWellFormed{false};
+        // Only set when the path is a known top-level user path followed by a known component.
+        UserPath user{UserPath::Count};
+        Component component{Component::Count};
+    };
+
+    // An automaton that checks the path syntax and recognizes the binding paths in a single pass. It walks a trie of
+    // the top-level user paths, whose final states continue into a trie of all the components, in lockstep with the
+    // syntax automaton above.
+    class PathAutomaton {
+      public:
+        PathAutomaton() {
+            m_transitions.emplace_back(); // Dead state.
+            const uint16_t userRoot = addState();
+            const uint16_t componentRoot = addState();
+
+            for (size_t i = 0; i < k_componentCount; i++) {
+                m_components[insert(componentRoot, k_componentPaths[i])] = static_cast<Component>(i);
+            }
+            for (size_t i = 0; i < k_userPaths.size(); i++) {
+                const uint16_t state = insert(userRoot, k_userPaths[i]);
+                m_users[state] = static_cast<UserPath>(i);
+
+                // Continue with the components. No user path is a prefix of another, so there is no conflict.
+                m_transitions[state] = m_transitions[componentRoot];
+            }
+        }
+
+        PathMatch match(std::string_view path) const {
+            detail::SyntaxState syntax = detail::SyntaxState::Start;
+            uint16_t state = k_userRoot;
+            UserPath user = UserPath::Count;
+            for (const char c : path) {
+                const uint8_t symbol = detail::getPathSymbol(c);
+                if (symbol == detail::k_invalidSymbol) {
+                    return {};
+                }
+                syntax = detail::nextSyntaxState(syntax, symbol);
+                state = m_transitions[state][symbol];
+                if (m_users[state] != UserPath::Count) {
+                    user = m_users[state];
+                }
+            }
+
+            PathMatch result;
+            result.isWellFormed = syntax == detail::SyntaxState::Element;
+            if (result.isWellFormed && m_components[state] != Component::Count) {
+                result.user = user;
+                result.component = m_components[state];
+            }
+            return result;
+        }
+
+      private:
+        static constexpr uint16_t k_userRoot = 1;
+
+        uint16_t addState() {
+            m_transitions.emplace_back();
+            m_users.resize(m_transitions.size(), UserPath::Count);
+            m_components.resize(m_transitions.size(), Component::Count);
+            return static_cast<uint16_t>(m_transitions.size() - 1);
+        }
+
+        uint16_t insert(uint16_t state, std::string_view str) {
+            for (const char c : str) {
+                const uint8_t symbol = detail::getPathSymbol(c);
+                if (!m_transitions[state][symbol]) {
+                    const uint16_t next = addState();
+                    m_transitions[state][symbol] = next;
+                }
+                state = m_transitions[state][symbol];
+            }
+            return state;
+        }
+
+        // State 0 is the dead state, all its transitions loop back to it.
+        std::vector<std::array<uint16_t, detail::k_symbolCount>> m_transitions;
+        std::vector<UserPath> m_users;
+        std::vector<Component> m_components;
+    };
+
+    // The automaton is built on first use.
+    inline const PathAutomaton& getPathAutomaton() {
+        static const PathAutomaton automaton;
+        return automaton;
+    }
+
+    namespace detail {
+
+        constexpr bool hasPerfectComponentHash() {
+            size_t used = 0;
+            for (const auto slot : k_componentSlots) {
+                if (slot != Component::Count) {
+                    used++;
+                }
+            }
+            return used == k_componentCount;
+        }
+
+        constexpr bool resolvesTo(Profile from,
+                                  Profile to,
+                                  std::string_view fullPath,
+                                  ValueType type,
+                                  Component component,
+                                  InputState state,
+                                  Button button = Button::None) {
+            const auto resolved = resolveBinding(from, to, fullPath, type);
+            return resolved && resolved->component == component && resolved->field.state == state &&
+                   resolved->field.button == button;
+        }
+
+        constexpr bool isUnbound(Profile from, Profile to, std::string_view fullPath, ValueType type) {
+            return !resolveBinding(from, to, fullPath, type);
+        }
+
+        constexpr auto Simple = Profile::SimpleController;
+        constexpr auto Vive = Profile::ViveController;
+        constexpr auto Index = Profile::IndexController;
+        constexpr auto Touch = Profile::OculusTouchController;
+        constexpr auto Microsoft = Profile::MicrosoftMotionController;
+
+        static_assert(hasPerfectComponentHash(), "Component hash has collisions, pick another seed");
+        static_assert(findProfile("/interaction_profiles/valve/index_controller") == Index);
+        static_assert(!findProfile("/interaction_profiles/valve/index_controller/"));
+        static_assert(findComponent("/input/thumbstick/click") == Component::ThumbstickClick);
+        static_assert(!findComponent("/input/thumbstick/clic"));
+
+        // Type-dependent components.
+        static_assert(resolvesTo(Vive,
+                                 Vive,
+                                 "/user/hand/left/input/trigger",
+                                 ValueType::Boolean,
+                                 C::Trigger,
+                                 S::HandButtons,
+                                 Button::Trigger));
+        static_assert(
+            resolvesTo(Vive, Vive, "/user/hand/left/input/trigger", ValueType::Float, C::Trigger, S::Trigger));
+        static_assert(isUnbound(Vive, Vive, "/user/hand/left/input/trigger", ValueType::Other));
+        static_assert(
+            resolvesTo(Touch, Touch, "/user/hand/right/input/squeeze", ValueType::Float, C::Squeeze, S::AnalogGrip));
+
+        // Side-specific components.
+        static_assert(resolvesTo(Touch,
+                                 Touch,
+                                 "/user/hand/left/input/menu",
+                                 ValueType::Boolean,
+                                 C::Menu,
+                                 S::HandButtons,
+                                 Button::ApplicationMenu));
+        static_assert(isUnbound(Touch, Touch, "/user/hand/right/input/menu", ValueType::Boolean));
+        static_assert(isUnbound(Touch, Touch, "/user/hand/left/input/a/click", ValueType::Boolean));
+        static_assert(resolvesTo(Touch,
+                                 Vive,
+                                 "/user/hand/right/input/a",
+                                 ValueType::Boolean,
+                                 C::MenuClick,
+                                 S::HandButtons,
+                                 Button::ApplicationMenu));
+        static_assert(isUnbound(Touch, Vive, "/user/hand/left/input/a", ValueType::Boolean));
+        static_assert(resolvesTo(Simple,
+                                 Touch,
+                                 "/user/hand/right/input/menu/click",
+                                 ValueType::Boolean,
+                                 C::AClick,
+                                 S::HandButtons,
+                                 Button::A));
+        static_assert(resolvesTo(Index,
+                                 Touch,
+                                 "/user/hand/left/input/b/touch",
+                                 ValueType::Boolean,
+                                 C::YTouch,
+                                 S::HandTouches,
+                                 Button::B));
+
+        // Remapped components that do not exist on the physical controller.
+        static_assert(isUnbound(Microsoft, Index, "/user/hand/left/input/trackpad/click", ValueType::Boolean));
+        static_assert(isUnbound(Microsoft, Touch, "/user/hand/left/input/trackpad", ValueType::Other));
+        static_assert(resolvesTo(
+            Microsoft, Simple, "/user/hand/left/input/trigger/value", ValueType::Float, C::SelectClick, S::HandButtons,
+            Button::Trigger));
+        static_assert(
+            resolvesTo(Index, Vive, "/user/hand/right/input/aim/pose", ValueType::Other, C::AimPose, S::None));
+
+        // Localized names and path validation.
+        static_assert(getLocalizedSourceName(Index, "/user/hand/left/input/thumbstick") == "Joystick");
+        static_assert(getLocalizedSourceName(Touch, "/user/hand/left/input/x") == "X Button");
+        static_assert(getLocalizedSourceName(Touch, "/user/hand/right/input/x").empty());
+        static_assert(isValidComponent(Vive, UserPath::HandRight, C::Haptic));
+        static_assert(isValidComponent(Vive, UserPath::Head, C::SystemClick));
+        static_assert(!isValidComponent(Simple, UserPath::HandRight, C::Trigger));
+        static_assert(isValidComponent(Profile::MicrosoftXboxController, UserPath::Gamepad, C::ThumbstickLeftForce));
+        static_assert(!isValidComponent(Profile::MicrosoftXboxController, UserPath::HandLeft, C::A));
+        static_assert(!isValidComponent(Profile::HtcVivePro, UserPath::Head, C::Haptic));
+
+        // Path syntax.
+        static_assert(isWellFormedPath("/user/hand/left/input/trigger/value"));
+        static_assert(isWellFormedPath("/a/..b/c.d"));
+        static_assert(!isWellFormedPath(""));
+        static_assert(!isWellFormedPath("/"));
+        static_assert(!isWellFormedPath("user/hand"));
+        static_assert(!isWellFormedPath("/user/hand/"));
+        static_assert(!isWellFormedPath("/user//hand"));
+        static_assert(!isWellFormedPath("/user/../hand"));
+        static_assert(!isWellFormedPath("/user/Hand"));
+        static_assert(isWellFormedName("my_action-1.0"));
+        static_assert(!isWellFormedName("my/action"));
+
+    } // namespace detail
+
+} // namespace pimax_openxr::mappings
@@ -24,10 +24,14 @@
 
 // Standard library.
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
 #include <deque>
 #include <intrin.h>
@@ -40,8 +44,13 @@
 #include <mutex>
 #include <set>
 #include <optional>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #pragma intrinsic(_ReturnAddress)
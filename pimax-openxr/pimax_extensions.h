@@ -0,0 +1,74 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Definitions of the experimental vendor extensions of the runtime that are not part of the OpenXR registry. This header
+// is internal and is not distributed: no extension number is reserved with Khronos yet, so the structure type values
+// below are provisional and will change once one is. They are placed in the block of extension number 100000, far from
+// the numbers the registry allocates. The extensions are only advertised when enabled with the "enable_experimental"
+// setting.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XR_PIMAX_action_state_batch 1
+#define XR_PIMAX_action_state_batch_SPEC_VERSION 1
+#define XR_PIMAX_ACTION_STATE_BATCH_EXTENSION_NAME "XR_PIMAX_action_state_batch"
+
+static const XrStructureType XR_TYPE_ACTION_STATES_GET_INFO_PIMAX = (XrStructureType)1099999000;
+static const XrStructureType XR_TYPE_ACTION_STATES_PIMAX = (XrStructureType)1099999001;
+
+// The (action, subactionPath) pairs to query. subactionPaths may be NULL to query all the actions without a subaction
+// path.
+typedef struct XrActionStatesGetInfoPIMAX {
+    XrStructureType type;
+    const void* XR_MAY_ALIAS next;
+    uint32_t actionCount;
+    const XrAction* actions;
+    const XrPath* subactionPaths;
+} XrActionStatesGetInfoPIMAX;
+
+// The states of the queried actions, as a structure of arrays of actionCount elements each. results and isActive are
+// required, changedSinceLastSync and lastChangeTimes are optional. The value array for the type of an action may only
+// be NULL if no action of that type is queried. results[i] receives what the corresponding xrGetActionState*() call
+// would have returned, and the other outputs are only written upon success. Pose actions only report isActive.
+typedef struct XrActionStatesPIMAX {
+    XrStructureType type;
+    void* XR_MAY_ALIAS next;
+    XrResult* results;
+    XrBool32* isActive;
+    XrBool32* changedSinceLastSync;
+    XrTime* lastChangeTimes;
+    XrBool32* booleanValues;
+    float* floatValues;
+    XrVector2f* vector2fValues;
+} XrActionStatesPIMAX;
+
+typedef XrResult(XRAPI_PTR* PFN_xrGetActionStatesPIMAX)(XrSession session,
+                                                        const XrActionStatesGetInfoPIMAX* getInfo,
+                                                        XrActionStatesPIMAX* states);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,321 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "pose_extrapolation.h"
+
+namespace pimax_openxr::extrapolation {
+
+    namespace {
+
+        constexpr double k_nanosecondsPerSecond = 1e9;
+
+        // Hamilton product: the rotation b followed by the rotation a.
+        XrQuaternionf multiply(const XrQuaternionf& a, const XrQuaternionf& b) {
+            return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                    a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                    a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                    a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+        }
+
+        XrQuaternionf conjugate(const XrQuaternionf& q) {
+            return {-q.x, -q.y, -q.z, q.w};
+        }
+
+        XrQuaternionf normalize(const XrQuaternionf& q) {
+            const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+            if (length < 1e-6f) {
+                return {0, 0, 0, 1};
+            }
+            return {q.x / length, q.y / length, q.z / length, q.w / length};
+        }
+
+        float length(const XrVector3f& v) {
+            return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        }
+
+    } // namespace
+
+    XrPosef integrate(const XrPosef& pose,
+                      const XrVector3f& angularVelocity,
+                      const XrVector3f& linearVelocity,
+                      double durationSeconds) {
+        XrPosef result = pose;
+
+        const float speed = length(angularVelocity);
+        const float angle = static_cast<float>(speed * durationSeconds);
+        if (std::abs(angle) > 1e-6f) {
+            const float s = std::sin(angle / 2) / speed;
+            const XrQuaternionf delta{
+                angularVelocity.x * s, angularVelocity.y * s, angularVelocity.z * s, std::cos(angle / 2)};
+            result.orientation = normalize(multiply(delta, pose.orientation));
+        }
+
+        const float t = static_cast<float>(durationSeconds);
+        result.position = {pose.position.x + linearVelocity.x * t,
+                           pose.position.y + linearVelocity.y * t,
+                           pose.position.z + linearVelocity.z * t};
+
+        return result;
+    }
+
+    float angleBetween(const XrQuaternionf& a, const XrQuaternionf& b) {
+        const float dot = std::abs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w);
+        return 2.f * std::acos(std::min(dot, 1.f));
+    }
+
+    XrVector3f angularVelocityBetween(const XrQuaternionf& from, const XrQuaternionf& to, double durationSeconds) {
+        XrQuaternionf delta = multiply(to, conjugate(from));
+
+        // Take the shortest path.
+        if (delta.w < 0) {
+            delta = {-delta.x, -delta.y, -delta.z, -delta.w};
+        }
+
+        const float sinHalfAngle = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+        if (sinHalfAngle < 1e-6f || durationSeconds <= 0) {
+            return {0, 0, 0};
+        }
+
+        const float angle = 2.f * std::atan2(sinHalfAngle, delta.w);
+        const float scale = static_cast<float>(angle / (sinHalfAngle * durationSeconds));
+        return {delta.x * scale, delta.y * scale, delta.z * scale};
+    }
+
+    DeviceExtrapolator::DeviceExtrapolator(XrDuration maxDropout) : m_maxDropout(maxDropout) {
+    }
+
+    void DeviceExtrapolator::addSample(const Sample& sample) {
+        if (!(sample.hasOrientation || sample.hasPosition)) {
+            return;
+        }
+
+        // The same poses are queried many times per frame.
+        const Sample* latest = getSample(0);
+        if (latest && sample.time <= latest->time) {
+            return;
+        }
+
+        // Measure how well the motion model would have predicted this sample.
+        if (latest && sample.time - latest->time <= k_maxSampleInterval) {
+            const double dt = (sample.time - latest->time) / k_nanosecondsPerSecond;
+            const XrPosef predicted = integrate(latest->pose,
+                                                latest->hasAngularVelocity ? latest->angularVelocity : XrVector3f{},
+                                                latest->hasLinearVelocity ? latest->linearVelocity : XrVector3f{},
+                                                dt);
+
+            bool evaluated = false;
+            if (latest->hasOrientation && sample.hasOrientation) {
+                const double error = angleBetween(predicted.orientation, sample.pose.orientation);
+                m_statistics.sumAngularError += error;
+                m_statistics.maxAngularError = std::max(m_statistics.maxAngularError, error);
+                evaluated = true;
+            }
+            if (latest->hasPosition && sample.hasPosition) {
+                const XrVector3f delta{predicted.position.x - sample.pose.position.x,
+                                       predicted.position.y - sample.pose.position.y,
+                                       predicted.position.z - sample.pose.position.z};
+                const double error = length(delta);
+                m_statistics.sumPositionError += error;
+                m_statistics.maxPositionError = std::max(m_statistics.maxPositionError, error);
+                evaluated = true;
+            }
+            if (evaluated) {
+                m_statistics.evaluations++;
+            }
+        }
+
+        m_history[m_nextSample] = sample;
+        m_nextSample = (m_nextSample + 1) % k_historySize;
+        m_historyCount = std::min(m_historyCount + 1, k_historySize);
+        m_statistics.samples++;
+    }
+
+    bool DeviceExtrapolator::extrapolateOrientation(XrTime time, XrQuaternionf& orientation) {
+        size_t age;
+        const Sample* latest = getLatestSample(true /* needOrientation */, &age);
+        if (!latest || (m_maxDropout && time - latest->time > m_maxDropout)) {
+            return false;
+        }
+
+        XrVector3f angularVelocity = latest->angularVelocity;
+        if (!latest->hasAngularVelocity) {
+            // Estimate the velocity from the previous sample.
+            angularVelocity = {0, 0, 0};
+            for (const Sample* previous = getSample(age + 1); previous; previous = getSample(++age + 1)) {
+                if (previous->hasOrientation) {
+                    if (latest->time - previous->time <= k_maxSampleInterval) {
+                        const double dt = (latest->time - previous->time) / k_nanosecondsPerSecond;
+                        angularVelocity =
+                            angularVelocityBetween(previous->pose.orientation, latest->pose.orientation, dt);
+                    }
+                    break;
+                }
+            }
+        }
+
+        orientation = integrate(latest->pose, angularVelocity, {0, 0, 0}, clampHorizon(time, *latest)).orientation;
+
+        return true;
+    }
+
+    bool DeviceExtrapolator::extrapolatePosition(XrTime time, XrVector3f& position) {
+        size_t age;
+        const Sample* latest = getLatestSample(false /* needOrientation */, &age);
+        if (!latest || (m_maxDropout && time - latest->time > m_maxDropout)) {
+            return false;
+        }
+
+        XrVector3f linearVelocity = latest->linearVelocity;
+        if (!latest->hasLinearVelocity) {
+            // Estimate the velocity from the previous sample.
+            linearVelocity = {0, 0, 0};
+            for (const Sample* previous = getSample(age + 1); previous; previous = getSample(++age + 1)) {
+                if (previous->hasPosition) {
+                    if (latest->time - previous->time <= k_maxSampleInterval) {
+                        const float dt = static_cast<float>((latest->time - previous->time) / k_nanosecondsPerSecond);
+                        linearVelocity = {(latest->pose.position.x - previous->pose.position.x) / dt,
+                                          (latest->pose.position.y - previous->pose.position.y) / dt,
+                                          (latest->pose.position.z - previous->pose.position.z) / dt};
+                    }
+                    break;
+                }
+            }
+        }
+
+        position = integrate(latest->pose, {0, 0, 0}, linearVelocity, clampHorizon(time, *latest)).position;
+
+        return true;
+    }
+
+    void DeviceExtrapolator::clearHistory() {
+        m_historyCount = 0;
+        m_nextSample = 0;
+    }
+
+    const Sample* DeviceExtrapolator::getSample(size_t age) const {
+        if (age >= m_historyCount) {
+            return nullptr;
+        }
+        return &m_history[(m_nextSample + k_historySize - 1 - age) % k_historySize];
+    }
+
+    const Sample* DeviceExtrapolator::getLatestSample(bool needOrientation, size_t* age) const {
+        for (size_t i = 0; i < m_historyCount; i++) {
+            const Sample* sample = getSample(i);
+            if (needOrientation ? sample->hasOrientation : sample->hasPosition) {
+                if (age) {
+                    *age = i;
+                }
+                return sample;
+            }
+        }
+        return nullptr;
+    }
+
+    double DeviceExtrapolator::clampHorizon(XrTime time, const Sample& sample) {
+        m_statistics.extrapolations++;
+
+        XrDuration horizon = time - sample.time;
+        if (horizon > k_maxHorizon || horizon < -k_maxHorizon) {
+            m_statistics.clampedExtrapolations++;
+            horizon = std::clamp(horizon, -k_maxHorizon, k_maxHorizon);
+        }
+
+        return horizon / k_nanosecondsPerSecond;
+    }
+
+    void SkeletonExtrapolator::addSample(XrTime time, const Joints& joints) {
+        const Sample* latest = getSample(0);
+        if (latest) {
+            if (time <= latest->time) {
+                return;
+            }
+
+            // The skeleton is polled much more often than it is refreshed. Keep the time it was first seen.
+            const bool isUnchanged = !std::memcmp(joints.data(), latest->joints.data(), sizeof(Joints));
+            if (isUnchanged && time - latest->time < k_restInterval) {
+                return;
+            }
+        }
+
+        m_history[m_nextSample] = {time, joints};
+        m_nextSample = (m_nextSample + 1) % k_historySize;
+        m_historyCount = std::min(m_historyCount + 1, k_historySize);
+    }
+
+    bool SkeletonExtrapolator::extrapolate(XrTime time,
+                                           Joints& joints,
+                                           Velocities* angularVelocities,
+                                           Velocities* linearVelocities,
+                                           bool& hasVelocities) const {
+        const Sample* latest = getSample(0);
+        if (!latest) {
+            hasVelocities = false;
+            return false;
+        }
+
+        const Sample* previous = getSample(1);
+        hasVelocities = previous && latest->time - previous->time <= DeviceExtrapolator::k_maxSampleInterval;
+        if (!hasVelocities) {
+            joints = latest->joints;
+            return true;
+        }
+
+        const XrDuration horizon =
+            std::clamp(time - latest->time, -DeviceExtrapolator::k_maxHorizon, DeviceExtrapolator::k_maxHorizon);
+        const double dt = (latest->time - previous->time) / k_nanosecondsPerSecond;
+        for (size_t i = 0; i < joints.size(); i++) {
+            const XrPosef& from = previous->joints[i];
+            const XrPosef& to = latest->joints[i];
+
+            const XrVector3f angularVelocity = angularVelocityBetween(from.orientation, to.orientation, dt);
+            const XrVector3f linearVelocity{static_cast<float>((to.position.x - from.position.x) / dt),
+                                            static_cast<float>((to.position.y - from.position.y) / dt),
+                                            static_cast<float>((to.position.z - from.position.z) / dt)};
+
+            joints[i] = integrate(to, angularVelocity, linearVelocity, horizon / k_nanosecondsPerSecond);
+            if (angularVelocities) {
+                (*angularVelocities)[i] = angularVelocity;
+            }
+            if (linearVelocities) {
+                (*linearVelocities)[i] = linearVelocity;
+            }
+        }
+
+        return true;
+    }
+
+    void SkeletonExtrapolator::clearHistory() {
+        m_historyCount = 0;
+        m_nextSample = 0;
+    }
+
+    const SkeletonExtrapolator::Sample* SkeletonExtrapolator::getSample(size_t age) const {
+        if (age >= m_historyCount) {
+            return nullptr;
+        }
+        return &m_history[(m_nextSample + k_historySize - 1 - age) % k_historySize];
+    }
+
+} // namespace pimax_openxr::extrapolation
@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// PVR reports the poses it predicted for the requested time, but during a tracking dropout it has nothing to report.
+// The extrapolator keeps a short history of the tracked poses of a device, and bridges the dropouts by integrating the
+// last known velocities over a bounded horizon. It only depends on the OpenXR types, so it can be exercised without a
+// device.
+
+namespace pimax_openxr::extrapolation {
+
+    // Integrate a constant angular and linear velocity (both expressed in the reference space) over a duration.
+    XrPosef integrate(const XrPosef& pose,
+                      const XrVector3f& angularVelocity,
+                      const XrVector3f& linearVelocity,
+                      double durationSeconds);
+
+    // The angle (in radians) of the rotation between two orientations.
+    float angleBetween(const XrQuaternionf& a, const XrQuaternionf& b);
+
+    // The angular velocity (in the reference space) that rotates one orientation into the other over a duration.
+    XrVector3f angularVelocityBetween(const XrQuaternionf& from, const XrQuaternionf& to, double durationSeconds);
+
+    struct Sample {
+        XrTime time{0};
+        XrPosef pose{{0, 0, 0, 1}, {0, 0, 0}};
+        XrVector3f angularVelocity{0, 0, 0};
+        XrVector3f linearVelocity{0, 0, 0};
+        bool hasOrientation{false};
+        bool hasPosition{false};
+        bool hasAngularVelocity{false};
+        bool hasLinearVelocity{false};
+    };
+
+    struct Statistics {
+        uint64_t samples{0};
+
+        // The error of the motion model, measured by predicting each tracked sample from the previous one.
+        uint64_t evaluations{0};
+        double sumPositionError{0}; // meters
+        double maxPositionError{0};
+        double sumAngularError{0}; // radians
+        double maxAngularError{0};
+
+        // The poses that were extrapolated, and how many hit the horizon.
+        uint64_t extrapolations{0};
+        uint64_t clampedExtrapolations{0};
+    };
+
+    class DeviceExtrapolator {
+      public:
+        // How far from the last tracked sample the velocities are integrated. Beyond, the pose is held.
+        static constexpr XrDuration k_maxHorizon = 50'000'000;
+
+        // Samples further apart are not used to measure the prediction error or to estimate the velocities.
+        static constexpr XrDuration k_maxSampleInterval = 100'000'000;
+
+        static constexpr size_t k_historySize = 8;
+
+        // After maxDropout without a tracked sample, extrapolation gives up. A null maxDropout never gives up.
+        DeviceExtrapolator(XrDuration maxDropout = 0);
+
+        // Record the pose reported by the device. Samples that are not newer than the latest one are ignored.
+        void addSample(const Sample& sample);
+
+        // Extrapolate the orientation or the position for the given time from the latest tracked sample. Returns false
+        // when there is no suitable sample.
+        bool extrapolateOrientation(XrTime time, XrQuaternionf& orientation);
+        bool extrapolatePosition(XrTime time, XrVector3f& position);
+
+        // Forget the history, for example when the reference space is moved. The statistics are kept.
+        void clearHistory();
+
+        const Statistics& getStatistics() const {
+            return m_statistics;
+        }
+        void resetStatistics() {
+            m_statistics = {};
+        }
+
+      private:
+        // Iterate the history from the most recent sample.
+        const Sample* getSample(size_t age) const;
+        const Sample* getLatestSample(bool needOrientation, size_t* age = nullptr) const;
+        double clampHorizon(XrTime time, const Sample& sample);
+
+        const XrDuration m_maxDropout;
+
+        std::array<Sample, k_historySize> m_history;
+        size_t m_historyCount{0};
+        size_t m_nextSample{0};
+
+        Statistics m_statistics;
+    };
+
+    // PVR reports the hand skeleton without a timestamp, and only as often as the controller firmware refreshes it.
+    // The extrapolator stamps each skeleton when it is first observed, derives the joint velocities from the two most
+    // recent skeletons, and integrates them towards the requested time. The joints are expressed relative to the
+    // controller, so that the motion of the hand itself is left to the (already predicted) controller pose.
+    class SkeletonExtrapolator {
+      public:
+        using Joints = std::array<XrPosef, XR_HAND_JOINT_COUNT_EXT>;
+        using Velocities = std::array<XrVector3f, XR_HAND_JOINT_COUNT_EXT>;
+
+        // An unchanged skeleton observed for that long is recorded again, so that a hand at rest has no velocity.
+        static constexpr XrDuration k_restInterval = 20'000'000;
+
+        static constexpr size_t k_historySize = 4;
+
+        // Record the skeleton observed at the given time. Samples that are not newer than the latest one are ignored.
+        void addSample(XrTime time, const Joints& joints);
+
+        // Extrapolate the joints for the given time from the latest sample. The velocities are only written (and
+        // hasVelocities is set) when they could be derived. Returns false when there is no sample.
+        bool extrapolate(XrTime time,
+                         Joints& joints,
+                         Velocities* angularVelocities,
+                         Velocities* linearVelocities,
+                         bool& hasVelocities) const;
+
+        void clearHistory();
+
+      private:
+        struct Sample {
+            XrTime time{0};
+            Joints joints;
+        };
+
+        const Sample* getSample(size_t age) const;
+
+        std::array<Sample, k_historySize> m_history;
+        size_t m_historyCount{0};
+        size_t m_nextSample{0};
+    };
+
+} // namespace pimax_openxr::extrapolation
@@ -25,6 +25,13 @@
 #include "framework/dispatch.gen.h"
 
 #include "appinsights.h"
+#include "gaze_history.h"
+#include "hand_skeleton.h"
+#include "haptics.h"
+#include "mappings.h"
+#include "pimax_extensions.h"
+#include "pose_extrapolation.h"
+#include "space_motion.h"
 #include "utils.h"
 
 namespace pimax_openxr {
@@ -241,6 +248,14 @@ namespace pimax_openxr {
                                                   float* displayRefreshRates) override;
         XrResult xrGetDisplayRefreshRateFB(XrSession session, float* displayRefreshRate) override;
         XrResult xrRequestDisplayRefreshRateFB(XrSession session, float displayRefreshRate) override;
+        XrResult xrLocateSpacesKHR(XrSession session,
+                                   const XrSpacesLocateInfoKHR* locateInfo,
+                                   XrSpaceLocationsKHR* spaceLocations) override;
+
+        // Vendor extensions, dispatched by hand since they are not in the registry.
+        XrResult xrGetActionStatesPIMAX(XrSession session,
+                                        const XrActionStatesGetInfoPIMAX* getInfo,
+                                        XrActionStatesPIMAX* states);
 
       private:
         enum class ForcedInteractionProfile {
@@ -301,28 +316,101 @@ namespace pimax_openxr {
             XrAction action{XR_NULL_HANDLE};
             XrPath subActionPath{XR_NULL_PATH};
             XrPosef poseInSpace;
+
+            // Precomposed static transforms (see updateSpaceGraph()).
+            XrPosef poseInSpaceInverse;
+            bool isStatic{false};
+            XrPosef originPose;
+            XrPosef originPoseInverse;
+            XrPosef gripOffset[2];
+            XrPosef aimOffset[2];
         };
 
+        // The fields of the input state (arrays indexed by side) that an action source reads from.
         struct ActionSource {
-            const float* floatValue{nullptr};
+            decltype(pvrInputState::Trigger) pvrInputState::*floatValue{nullptr};
 
-            const pvrVector2f* vector2fValue{nullptr};
+            decltype(pvrInputState::JoyStick) pvrInputState::*vector2fValue{nullptr};
             int vector2fIndex{-1};
 
-            const uint32_t* buttonMap{nullptr};
+            decltype(pvrInputState::HandButtons) pvrInputState::*buttonMap{nullptr};
             pvrButton buttonType;
 
             std::string realPath;
         };
 
+        // A flattened form of an ActionSource, built upon (re)binding, that can be evaluated without any string or
+        // map lookups.
+        struct CompiledActionSource {
+            enum class Kind : uint8_t {
+                Unbound,
+                Button,
+                Float,
+                Vector2f,
+                GripPose,
+                AimPose,
+                EyeTrackerPose,
+                Haptic,
+            };
+
+            Kind kind{Kind::Unbound};
+
+            // 0 = left hand, 1 = right hand, 2 = eye tracker.
+            uint8_t side{0};
+
+            // For Vector2f: -1 = both components, 0 = X, 1 = Y.
+            int8_t vector2fIndex{-1};
+
+            // Byte offset of the value (already adjusted for the side) within the pvrInputState.
+            uint16_t offset{0};
+            uint32_t buttonMask{0};
+
+            // For Button: index of the bitmask (0-1 = HandButtons, 2-3 = HandTouches) and of the bit within it.
+            int8_t buttonWord{-1};
+            uint8_t buttonBit{0};
+
+            XrPath path{XR_NULL_PATH};
+        };
+
+        // The time of the last transition of each input, as observed by the background input sampler.
+        struct InputChangeTimes {
+            // Indexed by 32-bit word within the pvrInputState.
+            double field[sizeof(pvrInputState) / sizeof(uint32_t)]{};
+
+            // Indexed by bitmask (0-1 = HandButtons, 2-3 = HandTouches) then bit.
+            double button[4][32]{};
+        };
+
+        // An immutable copy of the input state, shared by all the actionsets synced by the same xrSyncActions() call.
+        struct InputSnapshot {
+            uint64_t version{0};
+            pvrInputState state{};
+
+            // Only available when the background input sampler is used.
+            bool hasChangeTimes{false};
+            InputChangeTimes changeTimes;
+        };
+
+        struct InputSample {
+            // Odd while the sample is being written.
+            std::atomic<uint64_t> sequence{0};
+            pvrInputState state{};
+        };
+
         struct ActionSet {
             std::string name;
             std::string localizedName;
 
             std::set<XrPath> subactionPaths;
 
-            // A copy of the input state. This is to handle when xrSyncActions() does not update all actionsets at once.
-            pvrInputState cachedInputState;
+            // Views into the names owned by the live actions in the actionset, to detect duplicates. Actions never move
+            // and are only retired when destroyed, so the views remain valid until they are erased.
+            std::unordered_set<std::string_view> actionNames;
+            std::unordered_set<std::string_view> actionLocalizedNames;
+
+            // The input state as of the last time the actionset was synced. This is to handle when xrSyncActions()
+            // does not update all actionsets at once.
+            std::shared_ptr<const InputSnapshot> inputSnapshot;
         };
 
         struct Action {
@@ -332,6 +420,8 @@ namespace pimax_openxr {
 
             XrActionSet actionSet{XR_NULL_HANDLE};
 
+            // The getters run concurrently under a shared m_actionsMutex, so the last values have their own lock.
+            std::mutex lastValueMutex;
             float lastFloatValue[2]{0.f, 0.f};
             XrTime lastFloatValueChangedTime[2]{0, 0};
 
@@ -343,10 +433,62 @@ namespace pimax_openxr {
 
             std::set<XrPath> subactionPaths;
             std::map<std::string, ActionSource> actionSources;
+
+            // Rebuilt from actionSources by compileActionSources().
+            std::vector<CompiledActionSource> compiledSources;
+            std::vector<XrPath> boundSources;
+        };
+
+        // A suggested binding, along with the path components identified when it was suggested.
+        struct SuggestedBinding {
+            XrActionSuggestedBinding binding;
+            mappings::UserPath user;
+            mappings::Component component;
+        };
+
+        // The inputs needed to rebind the actions for one controller, captured under the action lock so that the plan
+        // can be built without holding it.
+        struct RebindRequest {
+            int side;
+            uint64_t generation;
+            std::string controllerType;
+            std::optional<ForcedInteractionProfile> forcedInteractionProfile;
+            std::map<std::string, std::vector<std::pair<SuggestedBinding, const Action*>>> suggestedBindings;
+        };
+
+        // The new bindings for one controller, ready to be swapped in by applyRebindPlan().
+        struct RebindPlan {
+            struct Binding {
+                XrAction action;
+                std::string fullPath;
+                ActionSource source;
+            };
+
+            int side;
+            uint64_t generation;
+            std::string localizedControllerType;
+            std::string interactionProfile;
+            XrPosef gripPose;
+            XrPosef aimPose;
+            std::vector<Binding> bindings;
         };
 
         struct HandTracker {
             int side;
+
+            // The joints relative to the controller, as last reported by PVR for this motion range.
+            pvrSkeletalMotionRange motionRange{pvrSkeletalMotionRange_WithoutController};
+            extrapolation::SkeletonExtrapolator skeleton;
+        };
+
+        // The skeleton last queried from PVR for one hand, valid for one frame (pose cache epoch) and display time.
+        struct SkeletalCacheEntry {
+            uint64_t epoch{0};
+            XrTime time{0};
+            pvrSkeletalMotionRange motionRange{pvrSkeletalMotionRange_WithoutController};
+            bool isActive{false};
+            XrTime sampleTime{0};
+            extrapolation::SkeletonExtrapolator::Joints joints;
         };
 
         enum class EyeTracking {
@@ -371,47 +513,53 @@ namespace pimax_openxr {
 
         // action.cpp
         void rebindControllerActions(int side);
-        std::string getXrPath(XrPath path) const;
+        RebindRequest makeRebindRequest(int side);
+        RebindPlan buildRebindPlan(const RebindRequest& request);
+        void applyRebindPlan(const RebindPlan& plan);
+        void requestRebindControllerActions(int side);
+        void applyPendingRebindPlans();
+        void stopRebindingThread();
+        void rebindingThread();
+        const std::string& getXrPath(XrPath path) const;
         XrPath stringToPath(const std::string& path, bool validate = false);
+        bool isKnownPath(XrPath path) const;
+        void compileActionSources(Action& xrAction);
+        int getSubactionSide(XrPath subactionPath) const;
+        XrResult checkActionStateQuery(const Action& xrAction, XrPath subactionPath) const;
+        void getActionStateBoolean(Action& xrAction, XrPath subactionPath, XrActionStateBoolean& state);
+        void getActionStateFloat(Action& xrAction, XrPath subactionPath, XrActionStateFloat& state);
+        void getActionStateVector2f(Action& xrAction, XrPath subactionPath, XrActionStateVector2f& state);
+        void getActionStatePose(const Action& xrAction, XrPath subactionPath, XrActionStatePose& state) const;
+        double getInputChangeTime(const InputSnapshot& snapshot, const CompiledActionSource& source) const;
         int getActionSide(const std::string& fullPath, bool allowExtraPaths = false) const;
+        std::string buildInputSourceLocalizedName(const std::string& path,
+                                                  int side,
+                                                  XrInputSourceLocalizedNameFlags whichComponents) const;
         bool isActionEyeTracker(const std::string& fullPath) const;
         XrVector2f handleJoystickDeadzone(pvrVector2f raw) const;
         void handleBuiltinActions(bool wasRecenteringPressed = false, bool wasSystemPressed = false);
 
+        // controller_poller.cpp
+        void startControllerPollingThread();
+        void stopControllerPollingThread();
+        void controllerPollingThread();
+        void pollControllerTypes();
+
+        // input_sampler.cpp
+        void startInputSamplingThread();
+        void stopInputSamplingThread();
+        void inputSamplingThread();
+        bool latchSampledInputState(InputSnapshot& snapshot);
+
         // mappings.cpp
-        void initializeRemappingTables();
-        bool mapPathToViveControllerInputState(const Action& xrAction,
-                                               const std::string& path,
-                                               ActionSource& source) const;
-        bool mapPathToIndexControllerInputState(const Action& xrAction,
-                                                const std::string& path,
+        bool mapComponentToControllerInputState(mappings::Profile suggestedProfile,
+                                                mappings::Profile controllerProfile,
+                                                const Action& xrAction,
+                                                mappings::UserPath user,
+                                                mappings::Component component,
                                                 ActionSource& source) const;
-        bool mapPathToCrystalControllerInputState(const Action& xrAction,
-                                                  const std::string& path,
-                                                  ActionSource& source) const;
-        bool mapPathToSimpleControllerInputState(const Action& xrAction,
-                                                 const std::string& path,
-                                                 ActionSource& source) const;
-        std::string getViveControllerLocalizedSourceName(const std::string& path) const;
-        std::string getIndexControllerLocalizedSourceName(const std::string& path) const;
-        std::string getCrystalControllerLocalizedSourceName(const std::string& path) const;
-        std::string getSimpleControllerLocalizedSourceName(const std::string& path) const;
-        std::optional<std::string> remapSimpleControllerToViveController(const std::string& path) const;
-        std::optional<std::string> remapOculusTouchControllerToViveController(const std::string& path) const;
-        std::optional<std::string> remapMicrosoftMotionControllerToViveController(const std::string& path) const;
-        std::optional<std::string> remapIndexControllerToViveController(const std::string& path) const;
-        std::optional<std::string> remapSimpleControllerToIndexController(const std::string& path) const;
-        std::optional<std::string> remapOculusTouchControllerToIndexController(const std::string& path) const;
-        std::optional<std::string> remapMicrosoftMotionControllerToIndexController(const std::string& path) const;
-        std::optional<std::string> remapViveControllerToIndexController(const std::string& path) const;
-        std::optional<std::string> remapSimpleControllerToCrystalController(const std::string& path) const;
-        std::optional<std::string> remapMicrosoftMotionControllerToCrystalController(const std::string& path) const;
-        std::optional<std::string> remapViveControllerToCrystalController(const std::string& path) const;
-        std::optional<std::string> remapIndexControllerToCrystalController(const std::string& path) const;
-        std::optional<std::string> remapOculusTouchControllerToSimpleController(const std::string& path) const;
-        std::optional<std::string> remapMicrosoftMotionControllerToSimpleController(const std::string& path) const;
-        std::optional<std::string> remapViveControllerToSimpleController(const std::string& path) const;
-        std::optional<std::string> remapIndexControllerToSimpleController(const std::string& path) const;
+        std::string getControllerLocalizedSourceName(mappings::Profile controllerProfile,
+                                                     const std::string& path) const;
 
         // space.cpp
 
@@ -426,9 +574,29 @@ namespace pimax_openxr {
                                                  XrPosef& pose,
                                                  XrSpaceVelocity* velocity,
                                                  XrEyeGazeSampleTimeEXT* gazeSampleTime) const;
+        XrSpaceLocationFlags locateSpaceToHead(const Space& xrSpace,
+                                               XrTime time,
+                                               XrPosef& pose,
+                                               XrSpaceVelocity* velocity,
+                                               XrEyeGazeSampleTimeEXT* gazeSampleTime) const;
+        bool isSameSpaceOrigin(const Space& xrSpace, const Space& xrBaseSpace) const;
+        bool isHeadLockedSpace(const Space& xrSpace) const;
+        const CompiledActionSource* getActionSpaceSource(const Space& xrSpace) const;
+        void updateSpaceGraph(Space& xrSpace) const;
+        pvrPoseStatef getTrackedDevicePoseState(pvrTrackedDeviceType device, XrTime time) const;
+        void prefetchDevicePoses(XrTime time);
+        void invalidatePoseCache();
+        XrSpaceLocationFlags extrapolateDevicePose(size_t deviceIndex,
+                                                   XrTime time,
+                                                   const pvrPoseStatef& state,
+                                                   bool isOrientationTracked,
+                                                   bool isPositionTracked,
+                                                   XrPosef& pose) const;
+        void logPoseExtrapolationStatistics() const;
         XrSpaceLocationFlags getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const;
         XrSpaceLocationFlags getEyeTrackerPose(XrTime time, XrPosef& pose, XrEyeGazeSampleTimeEXT* sampleTime) const;
+        XrSpaceLocationFlags getEyeGazePose(XrTime time, XrPosef& pose, XrEyeGazeSampleTimeEXT* sampleTime) const;
 
         // eye_tracking.cpp
         bool getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector, double& sampleTime) const;
@@ -528,11 +696,6 @@ namespace pimax_openxr {
         float m_floorHeight{0.f};
         LARGE_INTEGER m_qpcFrequency{};
         double m_pvrTimeFromQpcTimeOffset{0};
-        XrPath m_stringIndex{0};
-        using MappingFunction = std::function<bool(const Action&, XrPath, ActionSource&)>;
-        using CheckValidPathFunction = std::function<bool(const std::string&)>;
-        std::map<std::pair<std::string, std::string>, MappingFunction> m_controllerMappingTable;
-        std::map<std::string, CheckValidPathFunction> m_controllerValidPathsTable;
         wil::unique_registry_watcher m_registryWatcher;
         bool m_loggedResolution{false};
         std::string m_applicationName;
@@ -543,13 +706,14 @@ namespace pimax_openxr {
         bool m_useApplicationDeviceForSubmission{true};
         EyeTracking m_eyeTrackingType{EyeTracking::None};
 #ifndef NOASEEVRCLIENT
+        // Only accessed from the aSeeVR callbacks, which are serialized on the tracker thread (and before they are
+        // registered). The gaze itself is published through m_gazeHistory.
         aSeeVRCoefficient m_droolonCoefficients{};
-        mutable std::mutex m_droolonMutex;
-        bool m_isDroolonReady{false};
-        double m_droolonTimestamp{0};
-        XrVector2f m_droolonGaze{};
+        gaze::ClockMapping m_droolonClock;
+        std::atomic<bool> m_isDroolonReady{false};
 #endif
-        float m_droolonProjectionDistance{0.35f};
+        mutable gaze::History m_gazeHistory;
+        std::atomic<float> m_droolonProjectionDistance{0.35f}; // also read from the aSeeVR callbacks
         bool m_isEyeTrackingAvailable{false};
         float m_focusPixelDensity{1.f};
         float m_peripheralPixelDensity{0.5f};
@@ -583,18 +747,33 @@ namespace pimax_openxr {
         // [4] = left focus foveated, [5] = right focus foveated
         XrFovf m_cachedEyeFov[xr::QuadView::Count + 2];
         XrVector2f m_centerOfFov[xr::StereoView::Count];
-        std::mutex m_actionsAndSpacesMutex;
-        std::map<XrPath, std::string> m_strings; // protected by actionsAndSpacesMutex
-        std::set<XrActionSet> m_actionSets;
+        // Lock ordering: m_swapchainsMutex, then m_frameMutex, then m_actionsMutex, then m_spacesMutex, then
+        // m_handTrackersMutex, then any of the leaf locks (m_pathsMutex, m_controllerPollingMutex, m_inputLatchMutex,
+        // Action::lastValueMutex, m_poseExtrapolationMutex, m_poseCacheMutex, m_focusFovMutex, m_focusStabilizerMutex,
+        // m_asyncSubmissionMutex). xrEndFrame() nests the swapchains, frame, actions and spaces locks in that order.
+        // The read-mostly entry points only take the shared side.
+        mutable std::shared_mutex m_pathsMutex;
+        std::deque<std::string> m_strings;                       // protected by pathsMutex
+        std::unordered_map<std::string_view, XrPath> m_pathIndex; // protected by pathsMutex
+        XrPath m_leftHandPath{XR_NULL_PATH};
+        XrPath m_rightHandPath{XR_NULL_PATH};
+        XrPath m_eyesPath{XR_NULL_PATH};
+        std::shared_mutex m_actionsMutex;
+        HandleTable<XrActionSet, ActionSet> m_actionSets;
+        // Views into the names owned by the live actionsets, to detect duplicates.
+        std::unordered_set<std::string_view> m_actionSetNames;
+        std::unordered_set<std::string_view> m_actionSetLocalizedNames;
         std::set<XrActionSet> m_activeActionSets;
-        std::set<XrAction> m_actions;
-        std::set<XrAction> m_actionsForCleanup;
+        // Destroyed actions are retired rather than erased, since action spaces may still reference them.
+        HandleTable<XrAction, Action> m_actions;
         std::mutex m_handTrackersMutex;
-        std::set<XrHandTrackerEXT> m_handTrackers;
-        std::set<XrSpace> m_spaces;
+        HandleTable<XrHandTrackerEXT, HandTracker> m_handTrackers;
+        SkeletalCacheEntry m_skeletalCache[2]; // protected by handTrackersMutex
+        std::shared_mutex m_spacesMutex;
+        HandleTable<XrSpace, Space> m_spaces;
         Space* m_originSpace{nullptr};
         Space* m_viewSpace{nullptr};
-        std::map<std::string, std::vector<XrActionSuggestedBinding>> m_suggestedBindings;
+        std::map<std::string, std::vector<SuggestedBinding>> m_suggestedBindings;
         bool m_isControllerActive[2]{false, false};
         std::string m_cachedControllerType[2];
         XrPosef m_controllerAimOffset;
@@ -624,7 +803,7 @@ namespace pimax_openxr {
 
         // Swapchains and other graphics stuff.
         std::mutex m_swapchainsMutex;
-        std::set<XrSwapchain> m_swapchains;
+        HandleTable<XrSwapchain, Swapchain> m_swapchains;
 
         // Mirror window.
         bool m_useMirrorWindow{false};
@@ -636,6 +815,55 @@ namespace pimax_openxr {
         pvrMirrorTexture m_pvrMirrorSwapChain{nullptr};
         ComPtr<ID3D11Texture2D> m_mirrorTexture;
 
+        // Controller type polling thread.
+        std::thread m_controllerPollingThread;
+        wil::unique_event m_controllerPollingTerminateEvent;
+        std::mutex m_controllerPollingMutex;
+        bool m_polledControllerActive[2]{false, false};       // protected by controllerPollingMutex
+        std::string m_polledControllerType[2];                // protected by controllerPollingMutex
+        std::atomic<uint64_t> m_controllerTypeGeneration{0};
+        uint64_t m_lastControllerTypeGeneration[2]{0, 0};
+
+        // Haptics pulse trains.
+        std::unique_ptr<haptics::Scheduler> m_hapticsScheduler;
+
+        // Background input sampling thread.
+        static constexpr uint32_t k_inputSampleRingSize = 64;
+        uint32_t m_inputSamplingRate{0};
+        std::thread m_inputSamplingThread;
+        wil::unique_event m_inputSamplingTerminateEvent;
+        InputSample m_inputSamples[k_inputSampleRingSize];
+        std::atomic<uint64_t> m_inputSamplesWritten{0};
+        // Serializes the latching of the samples, which happens outside of m_actionsMutex.
+        std::mutex m_inputLatchMutex;
+        uint64_t m_inputSamplesRead{0};
+        std::optional<pvrInputState> m_lastSampledInputState;
+        pvrInputState m_lastReportedInputState{};
+        InputChangeTimes m_inputChangeTimes;
+        // The buttons whose transition was latched on the last sync, and the time of the edge that reverts it.
+        std::array<uint32_t, 4> m_latchedInputButtons{};
+        InputChangeTimes m_latchedInputRevertTimes;
+
+        // Controller rebinding thread.
+        std::thread m_rebindingThread;
+        std::mutex m_rebindingMutex;
+        std::condition_variable m_rebindingCondVar;
+        bool m_terminateRebindingThread{false};
+        uint64_t m_rebindGeneration[2]{0, 0};
+        uint64_t m_appliedRebindGeneration[2]{0, 0};
+
+        // Localized input source names, keyed by path and components, built once per rebind of the controller they
+        // refer to. Protected by localizedNamesCacheMutex.
+        struct LocalizedNameCacheEntry {
+            int side;
+            uint64_t generation;
+            std::string name;
+        };
+        std::shared_mutex m_localizedNamesCacheMutex;
+        std::unordered_map<uint64_t, LocalizedNameCacheEntry> m_localizedNamesCache;
+        std::optional<RebindRequest> m_pendingRebindRequest[2]; // protected by rebindingMutex
+        std::optional<RebindPlan> m_completedRebindPlan[2];     // protected by rebindingMutex
+
         // Async submittion thread.
         bool m_useAsyncSubmission{false};
         bool m_needStartAsyncSubmissionThread{false};
@@ -718,17 +946,43 @@ namespace pimax_openxr {
         uint64_t m_frameCompleted{0};
         uint64_t m_lastCpuFrameTimeUs{0};
         uint64_t m_lastGpuFrameTimeUs{0};
-        pvrInputState m_cachedInputState;
+        uint64_t m_inputSnapshotVersion{0}; // protected by inputLatchMutex
         bool m_actionsSyncedThisFrame{false};
         XrTime m_lastPredictedDisplayTime{0};
-        mutable std::optional<XrPosef> m_lastValidHmdPose;
+
+        // Bridges the tracking dropouts of the HMD and both controllers. The HMD pose is extrapolated indefinitely,
+        // while the controllers give up after a short while. Protected by poseExtrapolationMutex.
+        static constexpr XrDuration k_controllerMaxDropout = 250'000'000;
+        mutable std::mutex m_poseExtrapolationMutex;
+        mutable extrapolation::DeviceExtrapolator m_poseExtrapolators[3]{
+            {}, {k_controllerMaxDropout}, {k_controllerMaxDropout}};
+
+        // Device poses queried from PVR, for the HMD and both controllers. The entries are kept for the current and
+        // the previous frame, since the application may still be locating the previous frame while waiting for the
+        // next one. Protected by poseCacheMutex.
+        struct PoseCacheEntry {
+            XrTime time{0};
+            uint64_t epoch{0};
+            pvrPoseStatef state{};
+        };
+        static constexpr size_t k_poseCacheSize = 4;
+        mutable std::mutex m_poseCacheMutex;
+        mutable PoseCacheEntry m_poseCache[3][k_poseCacheSize];
+        mutable uint32_t m_poseCacheNextEntry[3]{0, 0, 0};
+        uint64_t m_poseCacheEpoch{1};
         std::deque<uint64_t> m_frameTimeFilter;
         bool m_isSmartSmoothingEnabled{false};
         bool m_isSmartSmoothingActive{false};
 
         // FOV submission correction.
         bool m_needFocusFovCorrectionQuirk{false};
-        std::map<XrTime, std::pair<XrFovf, XrFovf>> m_focusFovForDisplayTime; // protected by actionsAndSpacesMutex
+        std::mutex m_focusFovMutex;
+        std::map<XrTime, std::pair<XrFovf, XrFovf>> m_focusFovForDisplayTime; // protected by focusFovMutex
+
+        // Focus region stabilization.
+        bool m_useFocusStabilizer{false};
+        std::mutex m_focusStabilizerMutex;
+        gaze::FocusStabilizer m_focusStabilizer; // protected by focusStabilizerMutex
 
         // Statistics.
         AppInsights m_telemetry;
@@ -172,6 +172,13 @@ namespace pimax_openxr {
         updateSessionState(true);
 
         m_frameTimes.clear();
+        {
+            std::unique_lock lock(m_poseExtrapolationMutex);
+            for (auto& extrapolator : m_poseExtrapolators) {
+                extrapolator.clearHistory();
+                extrapolator.resetStatistics();
+            }
+        }
 
         m_isControllerActive[0] = m_isControllerActive[1] = false;
         m_controllerAimPose[0] = m_controllerGripPose[0] = m_controllerAimPose[1] = m_controllerGripPose[1] =
@@ -191,6 +198,8 @@ namespace pimax_openxr {
             m_viewSpace = new Space;
             m_viewSpace->referenceType = XR_REFERENCE_SPACE_TYPE_VIEW;
             m_viewSpace->poseInSpace = Pose::Identity();
+            updateSpaceGraph(*m_originSpace);
+            updateSpaceGraph(*m_viewSpace);
         } catch (std::exception& exc) {
             m_sessionCreated = false;
             throw exc;
@@ -223,6 +232,11 @@ namespace pimax_openxr {
             m_needStartAsyncSubmissionThread = true;
         }
 
+        stopInputSamplingThread();
+        stopControllerPollingThread();
+        stopRebindingThread();
+        m_hapticsScheduler.reset();
+
         // Shutdown the mirror window.
         if (m_mirrorWindowThread.joinable()) {
             // Avoid race conditions where the window will not receive the message.
@@ -237,6 +251,7 @@ namespace pimax_openxr {
         }
 
         m_telemetry.logUsage(pvr_getTimeSeconds(m_pvr) - m_sessionStartTime, m_sessionTotalFrameCount);
+        logPoseExtrapolationStatistics();
 
 #ifndef NOASEEVRCLIENT
         // Stop the eye tracker.
@@ -246,17 +261,9 @@ namespace pimax_openxr {
 #endif
 
         // Destroy hand trackers (tied to session).
-        for (auto handTracker : m_handTrackers) {
-            HandTracker* xrHandTracker = (HandTracker*)handTracker;
-            delete xrHandTracker;
-        }
         m_handTrackers.clear();
 
         // Destroy action spaces (tied to session).
-        for (auto space : m_spaces) {
-            Space* xrSpace = (Space*)space;
-            delete xrSpace;
-        }
         m_spaces.clear();
         if (m_guardianSpace) {
             delete m_guardianSpace;
@@ -266,10 +273,10 @@ namespace pimax_openxr {
         m_guardianSpace = m_originSpace = m_viewSpace = nullptr;
 
         // Destroy all swapchains (tied to session).
-        while (m_swapchains.size()) {
+        for (const auto swapchain : m_swapchains.handles()) {
             // TODO: Ideally we do not invoke OpenXR public APIs to avoid confusing event tracing and possible
             // deadlocks.
-            CHECK_XRCMD(xrDestroySwapchain(*m_swapchains.begin()));
+            CHECK_XRCMD(xrDestroySwapchain(swapchain));
         }
         if (m_guardianSwapchain) {
             pvr_destroyTextureSwapChain(m_pvrSession, m_guardianSwapchain);
@@ -357,6 +364,16 @@ namespace pimax_openxr {
         m_needStartAsyncSubmissionThread = m_useAsyncSubmission;
         // Creation of the submission threads is deferred to the first xrWaitFrame() to accomodate OpenComposite quirks.
 
+        // Value is in Hz, 0 means to only sample the inputs upon xrSyncActions().
+        m_inputSamplingRate = std::min(getSetting("input_sampling_rate").value_or(0), 2000);
+        startInputSamplingThread();
+
+        startControllerPollingThread();
+
+        if (!m_hapticsScheduler) {
+            m_hapticsScheduler = std::make_unique<haptics::Scheduler>(haptics::createPvrPulseSink(m_pvrSession));
+        }
+
         // Re-assert our compulsive smoothing setting.
         pvr_setIntConfig(m_pvrSession, "dbg_force_framerate_divide_by", m_lockFramerate ? 2 : 1);
 
@@ -454,6 +471,11 @@ namespace pimax_openxr {
             }
 
             if (m_sessionState != oldSessionState) {
+                // Do not leave the controllers vibrating once the application can no longer stop them.
+                if (oldSessionState == XR_SESSION_STATE_FOCUSED && m_hapticsScheduler) {
+                    m_hapticsScheduler->stopAll();
+                }
+
                 TraceLoggingWrite(g_traceProvider,
                                   "PXR_State",
                                   TLArg(xr::ToCString(oldSessionState), "From"),
@@ -534,6 +556,7 @@ namespace pimax_openxr {
         m_lockFramerate = getSetting("lock_framerate").value_or(false);
 
         m_postProcessFocusView = getSetting("postprocess_focus_view").value_or(true);
+        m_useFocusStabilizer = getSetting("focus_stabilizer").value_or(false);
 
         m_honorPremultiplyFlagOnProj0 = getSetting("honor_premultiply_flag_on_proj0").value_or(false);
 
@@ -554,10 +577,11 @@ namespace pimax_openxr {
             TLArg(m_frameTimeOverrideUs, "FrameTimeOverride"),
             TLArg(m_frameTimeFilterLength, "FrameTimeFilterLength"),
             TLArg(m_useMirrorWindow, "MirrorWindow"),
-            TLArg(m_droolonProjectionDistance, "DroolonProjectionDistance"),
+            TLArg(m_droolonProjectionDistance.load(), "DroolonProjectionDistance"),
             TLArg(m_useDeferredFrameWait, "UseDeferredFrameWait"),
             TLArg(m_lockFramerate, "LockFramerate"),
             TLArg(m_postProcessFocusView, "PostProcessFocusView"),
+            TLArg(m_useFocusStabilizer, "FocusStabilizer"),
             TLArg(m_honorPremultiplyFlagOnProj0, "HonorPremultiplyFlagOnProj0"),
             TLArg(m_swapGripAimPoses, "SwapGripAimPoses"),
             TLArg(m_useRunningStart, "UseRunningStart"),
@@ -637,6 +661,7 @@ namespace pimax_openxr {
         m_guardianSpace->referenceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
         m_guardianSpace->poseInSpace =
             Pose::MakePose(Quaternion::RotationRollPitchYaw({PVR::DegreeToRad(-90.f), 0.f, 0.f}), XrVector3f{0, -1, 0});
+        updateSpaceGraph(*m_guardianSpace);
     }
 
 } // namespace pimax_openxr
@@ -102,17 +102,15 @@ namespace pimax_openxr {
             return XR_ERROR_POSE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_spacesMutex);
 
-        // Create the internal struct.
-        Space& xrSpace = *new Space;
+        // Create the internal struct. The table also maintains the list of known spaces for validation and cleanup.
+        auto [newSpace, xrSpace] = m_spaces.emplace();
         xrSpace.referenceType = createInfo->referenceSpaceType;
         xrSpace.poseInSpace = createInfo->poseInReferenceSpace;
+        updateSpaceGraph(xrSpace);
 
-        *space = (XrSpace)&xrSpace;
-
-        // Maintain a list of known spaces for validation and cleanup.
-        m_spaces.insert(*space);
+        *space = newSpace;
 
         TraceLoggingWrite(g_traceProvider, "xrCreateReferenceSpace", TLXArg(*space, "Space"));
 
@@ -138,31 +136,29 @@ namespace pimax_openxr {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock actionsLock(m_actionsMutex);
+        std::unique_lock lock(m_spacesMutex);
 
         if (createInfo->action != XR_NULL_HANDLE) {
-            if (!m_actions.count(createInfo->action)) {
+            const Action* xrAction = m_actions.get(createInfo->action);
+            if (!xrAction) {
                 return XR_ERROR_HANDLE_INVALID;
             }
 
-            Action& xrAction = *(Action*)createInfo->action;
-
-            if (xrAction.type != XR_ACTION_TYPE_POSE_INPUT) {
+            if (xrAction->type != XR_ACTION_TYPE_POSE_INPUT) {
                 return XR_ERROR_ACTION_TYPE_MISMATCH;
             }
         }
 
-        // Create the internal struct.
-        Space& xrSpace = *new Space;
+        // Create the internal struct. The table also maintains the list of known spaces for validation and cleanup.
+        auto [newSpace, xrSpace] = m_spaces.emplace();
         xrSpace.referenceType = XR_REFERENCE_SPACE_TYPE_MAX_ENUM;
         xrSpace.action = createInfo->action;
         xrSpace.subActionPath = createInfo->subactionPath;
         xrSpace.poseInSpace = createInfo->poseInActionSpace;
+        updateSpaceGraph(xrSpace);
 
-        *space = (XrSpace)&xrSpace;
-
-        // Maintain a list of known spaces for validation and cleanup.
-        m_spaces.insert(*space);
+        *space = newSpace;
 
         TraceLoggingWrite(g_traceProvider, "xrCreateActionSpace", TLXArg(*space, "Space"));
 
@@ -206,9 +202,12 @@ namespace pimax_openxr {
 
         location->locationFlags = 0;
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock actionsLock(m_actionsMutex);
+        std::shared_lock lock(m_spacesMutex);
 
-        if (!m_spaces.count(space) || !m_spaces.count(baseSpace)) {
+        const Space* xrSpace = m_spaces.get(space);
+        const Space* xrBaseSpace = m_spaces.get(baseSpace);
+        if (!xrSpace || !xrBaseSpace) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -232,10 +231,7 @@ namespace pimax_openxr {
             gazeSampleTime = reinterpret_cast<XrEyeGazeSampleTimeEXT*>(gazeSampleTime->next);
         }
 
-        Space& xrSpace = *(Space*)space;
-        Space& xrBaseSpace = *(Space*)baseSpace;
-
-        location->locationFlags = locateSpace(xrSpace, xrBaseSpace, time, location->pose, velocity, gazeSampleTime);
+        location->locationFlags = locateSpace(*xrSpace, *xrBaseSpace, time, location->pose, velocity, gazeSampleTime);
 
         if (!velocity) {
             TraceLoggingWrite(g_traceProvider,
@@ -255,6 +251,191 @@ namespace pimax_openxr {
         return XR_SUCCESS;
     }
 
+    // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#xrLocateSpacesKHR
+    XrResult OpenXrRuntime::xrLocateSpacesKHR(XrSession session,
+                                              const XrSpacesLocateInfoKHR* locateInfo,
+                                              XrSpaceLocationsKHR* spaceLocations) {
+        if (locateInfo->type != XR_TYPE_SPACES_LOCATE_INFO_KHR || spaceLocations->type != XR_TYPE_SPACE_LOCATIONS_KHR) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        TraceLoggingWrite(g_traceProvider,
+                          "xrLocateSpacesKHR",
+                          TLXArg(session, "Session"),
+                          TLXArg(locateInfo->baseSpace, "BaseSpace"),
+                          TLArg(locateInfo->time, "Time"),
+                          TLArg(locateInfo->spaceCount, "SpaceCount"));
+
+        if (!m_sessionCreated || session != (XrSession)1) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        if (!locateInfo->spaceCount || !locateInfo->spaces ||
+            spaceLocations->locationCount != locateInfo->spaceCount || !spaceLocations->locations) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        XrSpaceVelocitiesKHR* velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(spaceLocations->next);
+        while (velocities) {
+            if (velocities->type == XR_TYPE_SPACE_VELOCITIES_KHR) {
+                break;
+            }
+            velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(velocities->next);
+        }
+        if (velocities && (velocities->velocityCount != locateInfo->spaceCount || !velocities->velocities)) {
+            return XR_ERROR_VALIDATION_FAILURE;
+        }
+
+        if (locateInfo->time <= 0) {
+            return XR_ERROR_TIME_INVALID;
+        }
+
+        const uint32_t count = locateInfo->spaceCount;
+
+        std::shared_lock actionsLock(m_actionsMutex);
+        std::shared_lock lock(m_spacesMutex);
+
+        const Space* xrBaseSpace = m_spaces.get(locateInfo->baseSpace);
+        if (!xrBaseSpace) {
+            return XR_ERROR_HANDLE_INVALID;
+        }
+
+        std::vector<const Space*> xrSpaces(count);
+        for (uint32_t i = 0; i < count; i++) {
+            xrSpaces[i] = m_spaces.get(locateInfo->spaces[i]);
+            if (!xrSpaces[i]) {
+                return XR_ERROR_HANDLE_INVALID;
+            }
+        }
+
+        // Locate all spaces relative to the origin. The tracked devices are fetched at most once for the given time
+        // through the pose cache, regardless of how many spaces reference them. Spaces rigidly attached to the headset
+        // are located relative to it instead when the base space is too, since the headset pose cancels out.
+        const bool isBaseSpaceHeadLocked = isHeadLockedSpace(*xrBaseSpace);
+        enum class Resolution { Origin, SameOrigin, Head };
+        struct ResolvedLocation {
+            Resolution resolution;
+            XrSpaceLocationFlags flags;
+            XrPosef pose;
+            XrSpaceVelocity velocity;
+        };
+        std::vector<ResolvedLocation> resolvedLocations(count);
+        bool needBaseSpaceToOrigin = false;
+        bool needBaseSpaceToHead = false;
+        for (uint32_t i = 0; i < count; i++) {
+            ResolvedLocation& location = resolvedLocations[i];
+            location.velocity = {XR_TYPE_SPACE_VELOCITY};
+            if (isSameSpaceOrigin(*xrSpaces[i], *xrBaseSpace)) {
+                location.resolution = Resolution::SameOrigin;
+            } else if (isBaseSpaceHeadLocked && isHeadLockedSpace(*xrSpaces[i])) {
+                location.resolution = Resolution::Head;
+                location.flags = locateSpaceToHead(*xrSpaces[i],
+                                                   locateInfo->time,
+                                                   location.pose,
+                                                   velocities ? &location.velocity : nullptr,
+                                                   nullptr);
+                needBaseSpaceToHead = true;
+            } else {
+                location.resolution = Resolution::Origin;
+                location.flags = locateSpaceToOrigin(*xrSpaces[i],
+                                                     locateInfo->time,
+                                                     location.pose,
+                                                     velocities ? &location.velocity : nullptr,
+                                                     nullptr);
+                needBaseSpaceToOrigin = true;
+            }
+        }
+
+        // Resolve the base space only once for the whole batch.
+        XrPosef virtualToBaseSpace = Pose::Identity();
+        XrSpaceVelocity baseSpaceToVirtualVelocity{};
+        XrSpaceLocationFlags baseFlags = 0;
+        if (needBaseSpaceToOrigin) {
+            XrPosef baseSpaceToVirtual = Pose::Identity();
+            baseFlags = locateSpaceToOrigin(*xrBaseSpace,
+                                            locateInfo->time,
+                                            baseSpaceToVirtual,
+                                            velocities ? &baseSpaceToVirtualVelocity : nullptr,
+                                            nullptr);
+            virtualToBaseSpace =
+                xrBaseSpace->isStatic ? xrBaseSpace->originPoseInverse : Pose::Invert(baseSpaceToVirtual);
+        }
+        XrPosef headToBaseSpace = Pose::Identity();
+        XrSpaceVelocity baseSpaceToHeadVelocity{};
+        XrSpaceLocationFlags baseHeadFlags = 0;
+        if (needBaseSpaceToHead) {
+            XrPosef baseSpaceToHead = Pose::Identity();
+            baseHeadFlags = locateSpaceToHead(*xrBaseSpace,
+                                              locateInfo->time,
+                                              baseSpaceToHead,
+                                              velocities ? &baseSpaceToHeadVelocity : nullptr,
+                                              nullptr);
+            headToBaseSpace = xrBaseSpace->referenceType == XR_REFERENCE_SPACE_TYPE_VIEW
+                                  ? xrBaseSpace->poseInSpaceInverse
+                                  : Pose::Invert(baseSpaceToHead);
+        }
+
+        // Spaces sharing the origin of the base space only differ by their offset transforms (see locateSpace()).
+        constexpr XrSpaceLocationFlags k_sameOriginFlags =
+            XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+            XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+        XrSpaceVelocity sameOriginVelocity{XR_TYPE_SPACE_VELOCITY};
+        sameOriginVelocity.velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+
+        // Compose all the poses against the base space in a single pass.
+        for (uint32_t i = 0; i < count; i++) {
+            const ResolvedLocation& location = resolvedLocations[i];
+            XrSpaceLocationDataKHR& output = spaceLocations->locations[i];
+            XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+            switch (location.resolution) {
+            case Resolution::Origin:
+                output.locationFlags = motion::composeLocation(location.flags,
+                                                               location.pose,
+                                                               location.velocity,
+                                                               baseFlags,
+                                                               virtualToBaseSpace,
+                                                               baseSpaceToVirtualVelocity,
+                                                               output.pose,
+                                                               velocities ? &velocity : nullptr);
+                break;
+            case Resolution::SameOrigin:
+                output.locationFlags = motion::composeLocation(k_sameOriginFlags,
+                                                               xrSpaces[i]->poseInSpace,
+                                                               sameOriginVelocity,
+                                                               k_sameOriginFlags,
+                                                               xrBaseSpace->poseInSpaceInverse,
+                                                               sameOriginVelocity,
+                                                               output.pose,
+                                                               velocities ? &velocity : nullptr);
+                break;
+            case Resolution::Head:
+                output.locationFlags = motion::composeLocation(location.flags,
+                                                               location.pose,
+                                                               location.velocity,
+                                                               baseHeadFlags,
+                                                               headToBaseSpace,
+                                                               baseSpaceToHeadVelocity,
+                                                               output.pose,
+                                                               velocities ? &velocity : nullptr);
+                break;
+            }
+            if (velocities) {
+                XrSpaceVelocityDataKHR& outputVelocity = velocities->velocities[i];
+                outputVelocity.velocityFlags = output.locationFlags ? velocity.velocityFlags : 0;
+                outputVelocity.angularVelocity = velocity.angularVelocity;
+                outputVelocity.linearVelocity = velocity.linearVelocity;
+            }
+
+            TraceLoggingWrite(g_traceProvider,
+                              "xrLocateSpacesKHR",
+                              TLXArg(locateInfo->spaces[i], "Space"),
+                              TLArg(output.locationFlags, "LocationFlags"),
+                              TLArg(xr::ToString(output.pose).c_str(), "Pose"));
+        }
+
+        return XR_SUCCESS;
+    }
+
     // https://www.khronos.org/registry/OpenXR/specs/1.0/html/xrspec.html#xrLocateViews
     XrResult OpenXrRuntime::xrLocateViews(XrSession session,
                                           const XrViewLocateInfo* viewLocateInfo,
@@ -295,9 +476,11 @@ namespace pimax_openxr {
             return XR_ERROR_SIZE_INSUFFICIENT;
         }
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::shared_lock actionsLock(m_actionsMutex);
+        std::shared_lock lock(m_spacesMutex);
 
-        if (!m_spaces.count(viewLocateInfo->space)) {
+        const Space* xrBaseSpace = m_spaces.get(viewLocateInfo->space);
+        if (!xrBaseSpace) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -329,16 +512,36 @@ namespace pimax_openxr {
 
             // Get the HMD pose in the base space.
             XrPosef headPose;
-            viewState->viewStateFlags =
-                locateSpace(*m_viewSpace, *(Space*)viewLocateInfo->space, viewLocateInfo->displayTime, headPose);
+            viewState->viewStateFlags = locateSpace(*m_viewSpace, *xrBaseSpace, viewLocateInfo->displayTime, headPose);
 
             // Query the eye tracker if needed.
             bool isGazeValid = false;
             XrVector3f gazeUnitVector{};
+            float gazeConfidence = 1.f;
             if (foveatedRenderingActive) {
-                double dummyTime;
+                double sampleTime;
                 isGazeValid =
-                    getEyeGaze(viewLocateInfo->displayTime, false /* getStateOnly */, gazeUnitVector, dummyTime);
+                    getEyeGaze(viewLocateInfo->displayTime, false /* getStateOnly */, gazeUnitVector, sampleTime);
+
+                // Hold the focus region during fixations, rather than following the jitter of the gaze.
+                if (m_useFocusStabilizer) {
+                    std::unique_lock lock(m_focusStabilizerMutex);
+                    if (isGazeValid) {
+                        const gaze::FocusRegion region = m_focusStabilizer.update(
+                            xrTimeToPvrTime(viewLocateInfo->displayTime), gazeUnitVector, sampleTime);
+                        TraceLoggingWrite(g_traceProvider,
+                                          "FocusStabilizer",
+                                          TLArg(viewLocateInfo->displayTime, "DisplayTime"),
+                                          TLArg(sampleTime, "SampleTime"),
+                                          TLArg(xr::ToString(gazeUnitVector).c_str(), "Gaze"),
+                                          TLArg(xr::ToString(region.unitVector).c_str(), "Region"),
+                                          TLArg(region.confidence, "Confidence"));
+                        gazeUnitVector = region.unitVector;
+                        gazeConfidence = region.confidence;
+                    } else {
+                        m_focusStabilizer.reset();
+                    }
+                }
             }
 
             if (viewState->viewStateFlags & (XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT)) {
@@ -371,14 +574,16 @@ namespace pimax_openxr {
                     } else {
                         // Shift FOV according to the eye gaze.
                         // We also widen the FOV when near the edges of the headset to make sure there's enough overlap
-                        // between the two eyes.
+                        // between the two eyes, and when the gaze might not stay in the focus region.
                         const float MaxWidenAngle = PVR::DegreeToRad(7.f);
+                        const float MaxUncertaintyWidenAngle = PVR::DegreeToRad(5.f);
                         constexpr float Deadzone = 0.15f;
                         const XrVector2f centerOfFov{(projectedGaze.x + 1.f) / 2.f, (1.f - projectedGaze.y) / 2.f};
                         const XrVector2f v = centerOfFov - m_centerOfFov[i - 2];
                         const float distanceFromCenter = std::sqrt(v.x * v.x + v.y * v.y);
                         const float widenHalfAngle =
-                            std::clamp(distanceFromCenter - Deadzone, 0.f, 0.5f) * MaxWidenAngle;
+                            std::clamp(distanceFromCenter - Deadzone, 0.f, 0.5f) * MaxWidenAngle +
+                            (1.f - gazeConfidence) * MaxUncertaintyWidenAngle;
                         XrFovf globalFov = m_cachedEyeFov[i % xr::StereoView::Count];
                         std::tie(views[i].fov.angleLeft, views[i].fov.angleRight) =
                             Fov::Lerp(std::make_pair(globalFov.angleLeft, globalFov.angleRight),
@@ -402,6 +607,7 @@ namespace pimax_openxr {
                     // xrEndFrame(). We must keep track of the correct values for each frame.
                     if (m_needFocusFovCorrectionQuirk &&
                         viewLocateInfo->viewConfigurationType == XR_VIEW_CONFIGURATION_TYPE_PRIMARY_QUAD_VARJO) {
+                        std::unique_lock fovLock(m_focusFovMutex);
                         m_focusFovForDisplayTime.insert_or_assign(
                             viewLocateInfo->displayTime,
                             std::make_pair(views[xr::QuadView::FocusLeft].fov, views[xr::QuadView::FocusRight].fov));
@@ -421,15 +627,12 @@ namespace pimax_openxr {
     XrResult OpenXrRuntime::xrDestroySpace(XrSpace space) {
         TraceLoggingWrite(g_traceProvider, "xrDestroySpace", TLXArg(space, "Space"));
 
-        std::unique_lock lock(m_actionsAndSpacesMutex);
+        std::unique_lock lock(m_spacesMutex);
 
-        if (!m_spaces.count(space)) {
+        if (!m_spaces.contains(space)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Space* xrSpace = (Space*)space;
-
-        delete xrSpace;
         m_spaces.erase(space);
 
         return XR_SUCCESS;
@@ -444,61 +647,61 @@ namespace pimax_openxr {
         XrPosef spaceToVirtual = Pose::Identity();
         XrSpaceVelocity spaceToVirtualVelocity{};
         XrPosef baseSpaceToVirtual = Pose::Identity();
+        XrPosef virtualToBaseSpace;
         XrSpaceVelocity baseSpaceToVirtualVelocity{};
-        XrSpaceLocationFlags flags1, flags2, locationFlags;
-        if (xrSpace.referenceType != xrBaseSpace.referenceType ||
-            (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_MAX_ENUM && xrSpace.action != xrBaseSpace.action &&
-             xrSpace.subActionPath != xrBaseSpace.subActionPath)) {
-            flags1 = locateSpaceToOrigin(
-                xrSpace, time, spaceToVirtual, velocity ? &spaceToVirtualVelocity : nullptr, gazeSampleTime);
-            flags2 = locateSpaceToOrigin(xrBaseSpace,
-                                         time,
-                                         baseSpaceToVirtual,
-                                         velocity ? &baseSpaceToVirtualVelocity : nullptr,
-                                         gazeSampleTime);
-        } else {
+        XrSpaceLocationFlags flags1, flags2;
+        if (isSameSpaceOrigin(xrSpace, xrBaseSpace)) {
             // Optimize the case of locating against the same reference space or same action space.
             flags1 = flags2 = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
                               XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
             spaceToVirtual = xrSpace.poseInSpace;
-            baseSpaceToVirtual = xrBaseSpace.poseInSpace;
+            virtualToBaseSpace = xrBaseSpace.poseInSpaceInverse;
             if (velocity) {
                 spaceToVirtualVelocity.velocityFlags = baseSpaceToVirtualVelocity.velocityFlags =
                     XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
                 spaceToVirtualVelocity.angularVelocity = spaceToVirtualVelocity.linearVelocity =
                     baseSpaceToVirtualVelocity.angularVelocity = baseSpaceToVirtualVelocity.linearVelocity = {};
             }
+        } else if (isHeadLockedSpace(xrSpace) && isHeadLockedSpace(xrBaseSpace)) {
+            // Optimize the case of locating eye gaze against VIEW space (or any other space attached to the headset):
+            // the headset pose cancels out, so we locate both spaces relative to the headset instead.
+            flags1 = locateSpaceToHead(
+                xrSpace, time, spaceToVirtual, velocity ? &spaceToVirtualVelocity : nullptr, gazeSampleTime);
+            flags2 = locateSpaceToHead(xrBaseSpace,
+                                       time,
+                                       baseSpaceToVirtual,
+                                       velocity ? &baseSpaceToVirtualVelocity : nullptr,
+                                       gazeSampleTime);
+            virtualToBaseSpace = xrBaseSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW
+                                     ? xrBaseSpace.poseInSpaceInverse
+                                     : Pose::Invert(baseSpaceToVirtual);
+        } else {
+            flags1 = locateSpaceToOrigin(
+                xrSpace, time, spaceToVirtual, velocity ? &spaceToVirtualVelocity : nullptr, gazeSampleTime);
+            flags2 = locateSpaceToOrigin(xrBaseSpace,
+                                         time,
+                                         baseSpaceToVirtual,
+                                         velocity ? &baseSpaceToVirtualVelocity : nullptr,
+                                         gazeSampleTime);
+            virtualToBaseSpace =
+                xrBaseSpace.isStatic ? xrBaseSpace.originPoseInverse : Pose::Invert(baseSpaceToVirtual);
         }
 
-        // If either pose is not valid, we cannot locate.
-        if (!(Pose::IsPoseValid(flags1) && Pose::IsPoseValid(flags2))) {
-            pose = Pose::Identity();
-            return 0;
-        }
-
-        locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
-
-        // Both poses need to be tracked for the location to be tracked.
-        if (Pose::IsPoseTracked(flags1) && Pose::IsPoseTracked(flags2)) {
-            locationFlags |= XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
-        }
-
-        // Combine the poses.
-        pose = Pose::Multiply(spaceToVirtual, Pose::Invert(baseSpaceToVirtual));
-        if (velocity) {
-            velocity->velocityFlags = spaceToVirtualVelocity.velocityFlags & baseSpaceToVirtualVelocity.velocityFlags;
-            if (velocity->velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
-                velocity->angularVelocity =
-                    spaceToVirtualVelocity.angularVelocity - baseSpaceToVirtualVelocity.angularVelocity;
-            }
-            if (velocity->velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) {
-                // TODO: Does not account for centripetral forces.
-                velocity->linearVelocity =
-                    spaceToVirtualVelocity.linearVelocity - baseSpaceToVirtualVelocity.linearVelocity;
-            }
-        }
+        return motion::composeLocation(flags1,
+                                       spaceToVirtual,
+                                       spaceToVirtualVelocity,
+                                       flags2,
+                                       virtualToBaseSpace,
+                                       baseSpaceToVirtualVelocity,
+                                       pose,
+                                       velocity);
+    }
 
-        return locationFlags;
+    // Whether both spaces are relative to the same origin, ie: they only differ by their offset transform.
+    bool OpenXrRuntime::isSameSpaceOrigin(const Space& xrSpace, const Space& xrBaseSpace) const {
+        return !(xrSpace.referenceType != xrBaseSpace.referenceType ||
+                 (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_MAX_ENUM && xrSpace.action != xrBaseSpace.action &&
+                  xrSpace.subActionPath != xrBaseSpace.subActionPath));
     }
 
     XrSpaceLocationFlags OpenXrRuntime::locateSpaceToOrigin(const Space& xrSpace,
@@ -513,20 +716,16 @@ namespace pimax_openxr {
             velocity->velocityFlags = 0;
         }
 
+        // The offset transform to apply on top of the live pose.
+        const XrPosef* offset = &xrSpace.poseInSpace;
+
         if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
             // VIEW space if the headset pose.
             result = getHmdPose(time, pose, velocity);
-        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL) {
-            // LOCAL space is the origin reference.
-            pose = Pose::Identity();
-            result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
-                      XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
-            if (velocity) {
-                velocity->velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
-            }
-        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
-            // STAGE space is the origin reference at eye level.
-            pose = Pose::Translation({0, -m_floorHeight, 0});
+        } else if (xrSpace.isStatic) {
+            // LOCAL and STAGE spaces are rigidly attached to the origin, their transform is fully precomposed.
+            pose = xrSpace.originPose;
+            offset = nullptr;
             result = (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
                       XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
             if (velocity) {
@@ -541,55 +740,265 @@ namespace pimax_openxr {
                 result = XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
             }
         } else if (xrSpace.action != XR_NULL_HANDLE) {
-            // Action spaces for motion controllers.
-            Action& xrAction = *(Action*)xrSpace.action;
+            // Action spaces for motion controllers and eye tracker.
+            const CompiledActionSource* source = getActionSpaceSource(xrSpace);
+            if (source) {
+                TraceLoggingWrite(
+                    g_traceProvider, "xrLocateSpace", TLArg(getXrPath(source->path).c_str(), "ActionSourcePath"));
 
-            const std::string& subActionPath = getXrPath(xrSpace.subActionPath);
-            for (const auto& source : xrAction.actionSources) {
-                if (!startsWith(source.first, subActionPath)) {
-                    continue;
-                }
+                if (source->kind != CompiledActionSource::Kind::EyeTrackerPose) {
+                    const int side = source->side;
+                    result = getControllerPose(side, time, pose, velocity);
 
-                const std::string& fullPath = source.first;
-                TraceLoggingWrite(g_traceProvider, "xrLocateSpace", TLArg(fullPath.c_str(), "ActionSourcePath"));
-
-                if (!isActionEyeTracker(fullPath)) {
-                    const bool isGripPose = endsWith(fullPath, "/input/grip/pose");
-                    const bool isAimPose = endsWith(fullPath, "/input/aim/pose");
-                    const int side = getActionSide(fullPath);
-                    if ((isGripPose || isAimPose) && side >= 0) {
-                        result = getControllerPose(side, time, pose, velocity);
-
-                        // Apply the pose offsets.
-                        const bool useAimPose = m_swapGripAimPoses ? isGripPose : isAimPose;
-                        if (useAimPose) {
-                            pose = Pose::Multiply(m_controllerAimPose[side], pose);
-                        } else {
-                            pose = Pose::Multiply(m_controllerGripPose[side], pose);
-                        }
-
-                        // Per spec we must consistently pick one source. We pick the first one.
-                        break;
-                    }
+                    // The pose offsets are precomposed with the offset transform.
+                    offset = source->kind == CompiledActionSource::Kind::AimPose ? &xrSpace.aimOffset[side]
+                                                                                  : &xrSpace.gripOffset[side];
                 } else {
                     result = getEyeTrackerPose(time, pose, gazeSampleTime);
-
-                    // Per spec we must consistently pick one source. We pick the first one.
-                    break;
                 }
             }
         }
 
         // Apply the offset transform.
+        if (offset) {
+            motion::applyOffset(*offset, pose, velocity);
+        }
+
+        return result;
+    }
+
+    // Locate a head-locked space (see isHeadLockedSpace()) relative to the headset. This does not require to query the
+    // headset pose.
+    XrSpaceLocationFlags OpenXrRuntime::locateSpaceToHead(const Space& xrSpace,
+                                                          XrTime time,
+                                                          XrPosef& pose,
+                                                          XrSpaceVelocity* velocity,
+                                                          XrEyeGazeSampleTimeEXT* gazeSampleTime) const {
+        if (velocity) {
+            velocity->angularVelocity = velocity->linearVelocity = {0, 0, 0};
+            velocity->velocityFlags = 0;
+        }
+
+        if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
+            pose = xrSpace.poseInSpace;
+            if (velocity) {
+                velocity->velocityFlags = XR_SPACE_VELOCITY_ANGULAR_VALID_BIT | XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+            }
+            return XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
+                   XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+        }
+
+        const XrSpaceLocationFlags result = getEyeGazePose(time, pose, gazeSampleTime);
         pose = Pose::Multiply(xrSpace.poseInSpace, pose);
 
         return result;
     }
 
+    // Whether the space is rigidly attached to the headset, ie: VIEW space or an eye gaze action space.
+    bool OpenXrRuntime::isHeadLockedSpace(const Space& xrSpace) const {
+        if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
+            return true;
+        }
+
+        if (xrSpace.action != XR_NULL_HANDLE) {
+            const CompiledActionSource* source = getActionSpaceSource(xrSpace);
+            return source && source->kind == CompiledActionSource::Kind::EyeTrackerPose;
+        }
+
+        return false;
+    }
+
+    // Per spec we must consistently pick one pose source for an action space. We pick the first one.
+    const OpenXrRuntime::CompiledActionSource* OpenXrRuntime::getActionSpaceSource(const Space& xrSpace) const {
+        // The action may have been destroyed by the application, but it is retained for as long as the spaces
+        // referencing it.
+        const Action& xrAction = *m_actions.getRetained(xrSpace.action);
+
+        const int subActionSide = getSubactionSide(xrSpace.subActionPath);
+        for (const auto& source : xrAction.compiledSources) {
+            if (subActionSide >= 0 && source.side != subActionSide) {
+                continue;
+            }
+
+            if (source.kind == CompiledActionSource::Kind::GripPose ||
+                source.kind == CompiledActionSource::Kind::AimPose ||
+                source.kind == CompiledActionSource::Kind::EyeTrackerPose) {
+                return &source;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Precompose the static transforms of a space, so that only the live device pose remains to be multiplied in when
+    // locating the space. Must be called with the spaces lock held exclusively, upon creating the space and whenever the
+    // controller pose offsets change.
+    void OpenXrRuntime::updateSpaceGraph(Space& xrSpace) const {
+        xrSpace.poseInSpaceInverse = Pose::Invert(xrSpace.poseInSpace);
+        xrSpace.isStatic = false;
+        if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL) {
+            // LOCAL space is the origin reference.
+            xrSpace.isStatic = true;
+            xrSpace.originPose = xrSpace.poseInSpace;
+        } else if (xrSpace.referenceType == XR_REFERENCE_SPACE_TYPE_STAGE) {
+            // STAGE space is the origin reference at eye level.
+            xrSpace.isStatic = true;
+            xrSpace.originPose = Pose::Multiply(xrSpace.poseInSpace, Pose::Translation({0, -m_floorHeight, 0}));
+        } else if (xrSpace.action != XR_NULL_HANDLE) {
+            for (int side = 0; side < 2; side++) {
+                const XrPosef& gripPose = m_swapGripAimPoses ? m_controllerAimPose[side] : m_controllerGripPose[side];
+                const XrPosef& aimPose = m_swapGripAimPoses ? m_controllerGripPose[side] : m_controllerAimPose[side];
+                xrSpace.gripOffset[side] = Pose::Multiply(xrSpace.poseInSpace, gripPose);
+                xrSpace.aimOffset[side] = Pose::Multiply(xrSpace.poseInSpace, aimPose);
+            }
+        }
+
+        if (xrSpace.isStatic) {
+            xrSpace.originPoseInverse = Pose::Invert(xrSpace.originPose);
+        }
+    }
+
+    // Each pvr_getTrackedDevicePoseState() is a round-trip to the service, and the same poses are queried many times
+    // per frame (views, spaces, layers, overlay...).
+    pvrPoseStatef OpenXrRuntime::getTrackedDevicePoseState(pvrTrackedDeviceType device, XrTime time) const {
+        const size_t deviceIndex =
+            device == pvrTrackedDevice_HMD ? 0 : (device == pvrTrackedDevice_LeftController ? 1 : 2);
+        {
+            std::unique_lock lock(m_poseCacheMutex);
+
+            for (const PoseCacheEntry& entry : m_poseCache[deviceIndex]) {
+                if (entry.epoch && entry.epoch + 1 >= m_poseCacheEpoch && entry.time == time) {
+                    return entry.state;
+                }
+            }
+        }
+
+        pvrPoseStatef state{};
+        CHECK_PVRCMD(pvr_getTrackedDevicePoseState(m_pvrSession, device, xrTimeToPvrTime(time), &state));
+
+        std::unique_lock lock(m_poseCacheMutex);
+
+        PoseCacheEntry& entry = m_poseCache[deviceIndex][m_poseCacheNextEntry[deviceIndex]++ % k_poseCacheSize];
+        entry.time = time;
+        entry.epoch = m_poseCacheEpoch;
+        entry.state = state;
+
+        return state;
+    }
+
+    // Start a new frame in the pose cache, and query the poses the application is about to ask for.
+    void OpenXrRuntime::prefetchDevicePoses(XrTime time) {
+        {
+            std::unique_lock lock(m_poseCacheMutex);
+            m_poseCacheEpoch++;
+        }
+
+        bool isControllerActive[2];
+        {
+            std::unique_lock lock(m_controllerPollingMutex);
+            isControllerActive[0] = m_polledControllerActive[0];
+            isControllerActive[1] = m_polledControllerActive[1];
+        }
+
+        getTrackedDevicePoseState(pvrTrackedDevice_HMD, time);
+        for (uint32_t side = 0; side < 2; side++) {
+            if (isControllerActive[side]) {
+                getTrackedDevicePoseState(side == 0 ? pvrTrackedDevice_LeftController
+                                                    : pvrTrackedDevice_RightController,
+                                          time);
+            }
+        }
+    }
+
+    // Discard all cached poses, eg: after the tracking origin changed.
+    void OpenXrRuntime::invalidatePoseCache() {
+        {
+            std::unique_lock lock(m_poseCacheMutex);
+            m_poseCacheEpoch += 2;
+        }
+
+        // The history is relative to the previous origin.
+        std::unique_lock lock(m_poseExtrapolationMutex);
+        for (auto& extrapolator : m_poseExtrapolators) {
+            extrapolator.clearHistory();
+        }
+    }
+
+    // Record the pose reported by PVR, and extrapolate the components that are not tracked from the history.
+    XrSpaceLocationFlags OpenXrRuntime::extrapolateDevicePose(size_t deviceIndex,
+                                                              XrTime time,
+                                                              const pvrPoseStatef& state,
+                                                              bool isOrientationTracked,
+                                                              bool isPositionTracked,
+                                                              XrPosef& pose) const {
+        XrSpaceLocationFlags locationFlags = 0;
+        pose = pvrPoseToXrPose(state.ThePose);
+
+        extrapolation::Sample sample{};
+        sample.time = time;
+        sample.pose = pose;
+        sample.angularVelocity = pvrVector3dToXrVector3f(state.AngularVelocity);
+        sample.linearVelocity = pvrVector3dToXrVector3f(state.LinearVelocity);
+        sample.hasOrientation = sample.hasAngularVelocity = isOrientationTracked;
+        sample.hasPosition = isPositionTracked;
+        sample.hasLinearVelocity = state.StatusFlags & pvrStatus_PositionTracked;
+
+        std::unique_lock lock(m_poseExtrapolationMutex);
+        extrapolation::DeviceExtrapolator& extrapolator = m_poseExtrapolators[deviceIndex];
+        extrapolator.addSample(sample);
+
+        if (isOrientationTracked) {
+            locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+        } else if (extrapolator.extrapolateOrientation(time, pose.orientation)) {
+            locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+        } else {
+            pose.orientation = Quaternion::Identity();
+        }
+        if (isPositionTracked) {
+            locationFlags |= XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+        } else if (extrapolator.extrapolatePosition(time, pose.position)) {
+            locationFlags |= XR_SPACE_LOCATION_POSITION_VALID_BIT;
+        } else {
+            pose.position = {};
+        }
+
+        return locationFlags;
+    }
+
+    void OpenXrRuntime::logPoseExtrapolationStatistics() const {
+        std::unique_lock lock(m_poseExtrapolationMutex);
+        for (size_t i = 0; i < std::size(m_poseExtrapolators); i++) {
+            const extrapolation::Statistics& statistics = m_poseExtrapolators[i].getStatistics();
+            const char* const device = i == 0 ? "HMD" : (i == 1 ? "Left" : "Right");
+            const double evaluations = static_cast<double>(std::max(statistics.evaluations, 1ull));
+            TraceLoggingWrite(g_traceProvider,
+                              "PoseExtrapolation_Statistics",
+                              TLArg(device, "Device"),
+                              TLArg(statistics.samples, "Samples"),
+                              TLArg(statistics.evaluations, "Evaluations"),
+                              TLArg(statistics.sumPositionError / evaluations, "MeanPositionError"),
+                              TLArg(statistics.maxPositionError, "MaxPositionError"),
+                              TLArg(statistics.sumAngularError / evaluations, "MeanAngularError"),
+                              TLArg(statistics.maxAngularError, "MaxAngularError"),
+                              TLArg(statistics.extrapolations, "Extrapolations"),
+                              TLArg(statistics.clampedExtrapolations, "ClampedExtrapolations"));
+            if (statistics.extrapolations) {
+                Log("Pose extrapolation (%s): %llu extrapolations (%llu beyond horizon), prediction error "
+                    "%.1f/%.1f mm %.2f/%.2f deg (mean/max)\n",
+                    device,
+                    statistics.extrapolations,
+                    statistics.clampedExtrapolations,
+                    statistics.sumPositionError / evaluations * 1000,
+                    statistics.maxPositionError * 1000,
+                    PVR::RadToDegree(static_cast<float>(statistics.sumAngularError / evaluations)),
+                    PVR::RadToDegree(static_cast<float>(statistics.maxAngularError)));
+            }
+        }
+    }
+
     XrSpaceLocationFlags OpenXrRuntime::getHmdPose(XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
-        pvrPoseStatef state{};
-        CHECK_PVRCMD(pvr_getTrackedDevicePoseState(m_pvrSession, pvrTrackedDevice_HMD, xrTimeToPvrTime(time), &state));
+        const pvrPoseStatef state = getTrackedDevicePoseState(pvrTrackedDevice_HMD, time);
         TraceLoggingWrite(g_traceProvider,
                           "PVR_HmdPoseState",
                           TLArg(state.StatusFlags, "StatusFlags"),
@@ -597,29 +1006,10 @@ namespace pimax_openxr {
                           TLArg(xr::ToString(state.AngularVelocity).c_str(), "AngularVelocity"),
                           TLArg(xr::ToString(state.LinearVelocity).c_str(), "LinearVelocity"));
 
-        pose = pvrPoseToXrPose(state.ThePose);
-        if (state.StatusFlags & pvrStatus_OrientationTracked) {
-            locationFlags |= (XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT);
-        } else {
-            if (m_lastValidHmdPose) {
-                locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
-                pose.orientation = m_lastValidHmdPose.value().orientation;
-            } else {
-                pose.orientation = Quaternion::Identity();
-            }
-        }
         // For 9-axis setups, we propagate the Orientation bit to Position.
-        if (state.StatusFlags & pvrStatus_PositionTracked || state.StatusFlags & pvrStatus_OrientationTracked) {
-            locationFlags |= (XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT);
-        } else {
-            if (m_lastValidHmdPose) {
-                locationFlags |= XR_SPACE_LOCATION_POSITION_VALID_BIT;
-                pose.position = m_lastValidHmdPose.value().position;
-            } else {
-                pose.position = {};
-            }
-        }
-        m_lastValidHmdPose = pose;
+        const bool isOrientationTracked = state.StatusFlags & pvrStatus_OrientationTracked;
+        const bool isPositionTracked = state.StatusFlags & pvrStatus_PositionTracked || isOrientationTracked;
+        locationFlags = extrapolateDevicePose(0, time, state, isOrientationTracked, isPositionTracked, pose);
 
         if (velocity) {
             velocity->velocityFlags = 0;
@@ -640,12 +1030,8 @@ namespace pimax_openxr {
     XrSpaceLocationFlags
     OpenXrRuntime::getControllerPose(int side, XrTime time, XrPosef& pose, XrSpaceVelocity* velocity) const {
         XrSpaceLocationFlags locationFlags = 0;
-        pvrPoseStatef state{};
-        CHECK_PVRCMD(pvr_getTrackedDevicePoseState(m_pvrSession,
-                                                   side == 0 ? pvrTrackedDevice_LeftController
-                                                             : pvrTrackedDevice_RightController,
-                                                   xrTimeToPvrTime(time),
-                                                   &state));
+        const pvrPoseStatef state = getTrackedDevicePoseState(
+            side == 0 ? pvrTrackedDevice_LeftController : pvrTrackedDevice_RightController, time);
         TraceLoggingWrite(g_traceProvider,
                           "PVR_ControllerPoseState",
                           TLArg(side == 0 ? "Left" : "Right", "Side"),
@@ -654,17 +1040,12 @@ namespace pimax_openxr {
                           TLArg(xr::ToString(state.AngularVelocity).c_str(), "AngularVelocity"),
                           TLArg(xr::ToString(state.LinearVelocity).c_str(), "LinearVelocity"));
 
-        pose = pvrPoseToXrPose(state.ThePose);
-        if (state.StatusFlags & pvrStatus_OrientationTracked) {
-            locationFlags |= XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
-        } else {
-            pose.orientation = Quaternion::Identity();
-        }
-        if (state.StatusFlags & pvrStatus_PositionTracked) {
-            locationFlags |= XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
-        } else {
-            pose.position = {};
-        }
+        locationFlags = extrapolateDevicePose(1 + side,
+                                              time,
+                                              state,
+                                              state.StatusFlags & pvrStatus_OrientationTracked,
+                                              state.StatusFlags & pvrStatus_PositionTracked,
+                                              pose);
 
         if (velocity) {
             velocity->velocityFlags = 0;
@@ -685,18 +1066,13 @@ namespace pimax_openxr {
     XrSpaceLocationFlags OpenXrRuntime::getEyeTrackerPose(XrTime time,
                                                           XrPosef& pose,
                                                           XrEyeGazeSampleTimeEXT* sampleTime) const {
-        XrVector3f eyeGazeVector{0, 0, -1};
-        double pvrSampleTime;
-        if (!getEyeGaze(time, false /* getStateOnly */, eyeGazeVector, pvrSampleTime)) {
+        XrPosef eyeGaze;
+        if (!Pose::IsPoseValid(getEyeGazePose(time, eyeGaze, sampleTime))) {
             return 0;
         }
 
-        const XrPosef eyeGaze = Pose::MakePose(
-            Quaternion::RotationRollPitchYaw({-tan(eyeGazeVector.y), -tan(eyeGazeVector.x), 0.f}), XrVector3f{0, 0, 0});
-
-        // TODO: Need optimization here, in all likelyhood, the caller is looking for eye gaze relative to VIEW
-        // space,
-        // in which case we are doing 2 back-to-back getHmdPose() that are cancelling each other.
+        // When the caller is looking for eye gaze relative to VIEW space, locateSpace() bypasses this altogether (see
+        // locateSpaceToHead()).
         XrPosef headPose;
         if (!Pose::IsPoseValid(getHmdPose(time, headPose, nullptr))) {
             return 0;
@@ -705,6 +1081,24 @@ namespace pimax_openxr {
         // Combine poses.
         pose = Pose::Multiply(eyeGaze, headPose);
 
+        return XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT |
+               XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+    }
+
+    // The eye gaze pose relative to the headset.
+    XrSpaceLocationFlags OpenXrRuntime::getEyeGazePose(XrTime time,
+                                                       XrPosef& pose,
+                                                       XrEyeGazeSampleTimeEXT* sampleTime) const {
+        XrVector3f eyeGazeVector{0, 0, -1};
+        double pvrSampleTime;
+        if (!getEyeGaze(time, false /* getStateOnly */, eyeGazeVector, pvrSampleTime)) {
+            pose = Pose::Identity();
+            return 0;
+        }
+
+        pose = Pose::MakePose(
+            Quaternion::RotationRollPitchYaw({-tan(eyeGazeVector.y), -tan(eyeGazeVector.x), 0.f}), XrVector3f{0, 0, 0});
+
         if (sampleTime) {
             sampleTime->time = pvrTimeToXrTime(pvrSampleTime);
         }
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "space_motion.h"
+
+namespace pimax_openxr::motion {
+
+    using namespace xr::math;
+
+    XrSpaceLocationFlags composeLocation(XrSpaceLocationFlags flags1,
+                                         const XrPosef& spaceToVirtual,
+                                         const XrSpaceVelocity& spaceToVirtualVelocity,
+                                         XrSpaceLocationFlags flags2,
+                                         const XrPosef& virtualToBaseSpace,
+                                         const XrSpaceVelocity& baseSpaceToVirtualVelocity,
+                                         XrPosef& pose,
+                                         XrSpaceVelocity* velocity) {
+        // If either pose is not valid, we cannot locate.
+        if (!(Pose::IsPoseValid(flags1) && Pose::IsPoseValid(flags2))) {
+            pose = Pose::Identity();
+            return 0;
+        }
+
+        XrSpaceLocationFlags locationFlags =
+            XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT;
+
+        // Both poses need to be tracked for the location to be tracked.
+        if (Pose::IsPoseTracked(flags1) && Pose::IsPoseTracked(flags2)) {
+            locationFlags |= XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+        }
+
+        // Combine the poses.
+        pose = Pose::Multiply(spaceToVirtual, virtualToBaseSpace);
+        if (velocity) {
+            // The velocities are expressed in the base space. When the base space rotates, the located space also
+            // sees a tangential velocity (relative to the base space) proportional to its distance.
+            const XrSpaceVelocityFlags bothFlags =
+                spaceToVirtualVelocity.velocityFlags & baseSpaceToVirtualVelocity.velocityFlags;
+            velocity->velocityFlags = 0;
+
+            const DirectX::XMVECTOR toBaseSpace = LoadXrQuaternion(virtualToBaseSpace.orientation);
+            const DirectX::XMVECTOR baseAngularVelocity =
+                DirectX::XMVector3Rotate(LoadXrVector3(baseSpaceToVirtualVelocity.angularVelocity), toBaseSpace);
+            if (bothFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) {
+                const DirectX::XMVECTOR angularVelocity =
+                    DirectX::XMVector3Rotate(LoadXrVector3(spaceToVirtualVelocity.angularVelocity), toBaseSpace);
+                StoreXrVector3(&velocity->angularVelocity,
+                               DirectX::XMVectorSubtract(angularVelocity, baseAngularVelocity));
+                velocity->velocityFlags |= XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+            }
+            if ((bothFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT) &&
+                (baseSpaceToVirtualVelocity.velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT)) {
+                const DirectX::XMVECTOR linearVelocity = DirectX::XMVector3Rotate(
+                    DirectX::XMVectorSubtract(LoadXrVector3(spaceToVirtualVelocity.linearVelocity),
+                                              LoadXrVector3(baseSpaceToVirtualVelocity.linearVelocity)),
+                    toBaseSpace);
+                StoreXrVector3(&velocity->linearVelocity,
+                               DirectX::XMVectorSubtract(
+                                   linearVelocity,
+                                   DirectX::XMVector3Cross(baseAngularVelocity, LoadXrVector3(pose.position))));
+                velocity->velocityFlags |= XR_SPACE_VELOCITY_LINEAR_VALID_BIT;
+            }
+        }
+
+        return locationFlags;
+    }
+
+    void applyOffset(const XrPosef& offset, XrPosef& pose, XrSpaceVelocity* velocity) {
+        const XrVector3f devicePosition = pose.position;
+        pose = Pose::Multiply(offset, pose);
+
+        if (velocity && (velocity->velocityFlags & XR_SPACE_VELOCITY_ANGULAR_VALID_BIT) &&
+            (velocity->velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT)) {
+            const DirectX::XMVECTOR tangentialVelocity = DirectX::XMVector3Cross(
+                LoadXrVector3(velocity->angularVelocity), LoadXrVector3(pose.position - devicePosition));
+            StoreXrVector3(&velocity->linearVelocity,
+                           DirectX::XMVectorAdd(LoadXrVector3(velocity->linearVelocity), tangentialVelocity));
+        }
+    }
+
+} // namespace pimax_openxr::motion
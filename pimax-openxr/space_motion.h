@@ -0,0 +1,48 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// The locations of the spaces are composed as rigid-body motions: a space located relative to another carries the pose
+// and the velocities of its origin, expressed in the other space. When a frame rotates, a point away from its origin
+// also sees a tangential velocity (the cross product of the angular velocity and the lever arm). These only depend on
+// the OpenXR types, so they can be exercised without a device.
+
+namespace pimax_openxr::motion {
+
+    // Combine the location of a space relative to the origin with the inverse location of the base space relative to
+    // the origin. The velocities of both spaces are relative to the origin, and the velocity of the result is expressed
+    // in the base space.
+    XrSpaceLocationFlags composeLocation(XrSpaceLocationFlags flags1,
+                                         const XrPosef& spaceToVirtual,
+                                         const XrSpaceVelocity& spaceToVirtualVelocity,
+                                         XrSpaceLocationFlags flags2,
+                                         const XrPosef& virtualToBaseSpace,
+                                         const XrSpaceVelocity& baseSpaceToVirtualVelocity,
+                                         XrPosef& pose,
+                                         XrSpaceVelocity* velocity);
+
+    // Apply an offset transform on top of the location of a device. The offset moves the origin of the space away
+    // from the device, which adds a tangential velocity when the device rotates.
+    void applyOffset(const XrPosef& offset, XrPosef& pose, XrSpaceVelocity* velocity);
+
+} // namespace pimax_openxr::motion
@@ -424,8 +424,9 @@ namespace pimax_openxr {
         pvrTextureSwapChain pvrSwapchain{};
         CHECK_PVRCMD(pvr_createTextureSwapChainDX(m_pvrSession, m_pvrSubmissionDevice.Get(), &desc, &pvrSwapchain));
 
-        // Create the internal struct.
-        Swapchain& xrSwapchain = *new Swapchain;
+        // Create the internal struct. It is only added to the table (which also maintains the list of known swapchains
+        // for validation and cleanup) once fully built, so that a failure does not leave a half-built entry behind.
+        Swapchain xrSwapchain;
         xrSwapchain.pvrSwapchain.push_back(pvrSwapchain);
         CHECK_PVRCMD(pvr_getTextureSwapChainLength(m_pvrSession, pvrSwapchain, &xrSwapchain.pvrSwapchainLength));
         xrSwapchain.slices.push_back({});
@@ -445,14 +446,9 @@ namespace pimax_openxr {
             xrSwapchain.renderTargetView.push_back({});
         }
 
-        *swapchain = (XrSwapchain)&xrSwapchain;
-
-        // Maintain a list of known swapchains for validation and cleanup.
-        {
-            std::unique_lock lock(m_swapchainsMutex);
-
-            m_swapchains.insert(*swapchain);
-        }
+        std::unique_lock lock(m_swapchainsMutex);
+        *swapchain = m_swapchains.emplace(std::move(xrSwapchain)).first;
+        lock.unlock();
 
         TraceLoggingWrite(g_traceProvider, "xrCreateSwapchain", TLXArg(*swapchain, "Swapchain"));
 
@@ -465,7 +461,7 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        if (!m_swapchains.contains(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
@@ -484,7 +480,7 @@ namespace pimax_openxr {
         }
         flushSubmissionContext();
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *m_swapchains.get(swapchain);
 
         while (!xrSwapchain.pvrSwapchain.empty()) {
             auto pvrSwapchain = xrSwapchain.pvrSwapchain.back();
@@ -521,7 +517,6 @@ namespace pimax_openxr {
             xrSwapchain.glMemory.pop_back();
         }
 
-        delete &xrSwapchain;
         m_swapchains.erase(swapchain);
 
         return XR_SUCCESS;
@@ -539,11 +534,11 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        if (!m_swapchains.contains(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *m_swapchains.get(swapchain);
 
         int count = !xrSwapchain.pvrDesc.StaticImage ? xrSwapchain.pvrSwapchainLength : 1;
 
@@ -585,11 +580,11 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        if (!m_swapchains.contains(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *m_swapchains.get(swapchain);
 
         // Check that we can acquire an image.
         if (xrSwapchain.frozen || xrSwapchain.acquiredIndices.size() == xrSwapchain.pvrSwapchainLength) {
@@ -630,11 +625,11 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        if (!m_swapchains.contains(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *m_swapchains.get(swapchain);
 
         // Check an image is acquired but not waited.
         if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() == xrSwapchain.lastWaitedIndex) {
@@ -658,11 +653,11 @@ namespace pimax_openxr {
 
         std::unique_lock lock(m_swapchainsMutex);
 
-        if (!m_swapchains.count(swapchain)) {
+        if (!m_swapchains.contains(swapchain)) {
             return XR_ERROR_HANDLE_INVALID;
         }
 
-        Swapchain& xrSwapchain = *(Swapchain*)swapchain;
+        Swapchain& xrSwapchain = *m_swapchains.get(swapchain);
 
         // Check an image is acquired and waited.
         if (xrSwapchain.acquiredIndices.empty() || xrSwapchain.acquiredIndices.front() != xrSwapchain.lastWaitedIndex) {
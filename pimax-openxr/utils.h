@@ -412,6 +412,156 @@ namespace pimax_openxr::utils {
         HGLRC m_glRC;
     };
 
+    // A table of objects referenced through opaque OpenXR handles.
+    // A handle packs the generation of its slot (upper 32 bits) with the index of the slot + 1 (lower 32 bits, so that a
+    // handle is never XR_NULL_HANDLE). Validating a handle is an index and a compare, and a handle to a destroyed object
+    // is rejected even once its slot has been reused. The slots live in a deque, so objects never move once created.
+    // The table is not thread-safe: callers must hold the lock protecting it.
+    template <typename Handle, typename T>
+    class HandleTable {
+      public:
+        template <typename... Args>
+        std::pair<Handle, T&> emplace(Args&&... args) {
+            uint32_t index;
+            if (!m_freeList.empty()) {
+                index = m_freeList.back();
+                m_freeList.pop_back();
+            } else {
+                index = (uint32_t)m_slots.size();
+                m_slots.emplace_back();
+            }
+
+            Slot& slot = m_slots[index];
+            slot.object.emplace(std::forward<Args>(args)...);
+            slot.retired = false;
+            m_liveCount++;
+
+            return {makeHandle(index, slot.generation), slot.object.value()};
+        }
+
+        // Returns nullptr for invalid, stale or retired handles.
+        T* get(Handle handle) {
+            return const_cast<T*>(std::as_const(*this).get(handle));
+        }
+        const T* get(Handle handle) const {
+            const Slot* slot = lookup(handle);
+            return slot && !slot->retired ? &slot->object.value() : nullptr;
+        }
+
+        // Same as get(), but also accepts retired handles. Only for handles that are retained internally.
+        T* getRetained(Handle handle) {
+            return const_cast<T*>(std::as_const(*this).getRetained(handle));
+        }
+        const T* getRetained(Handle handle) const {
+            const Slot* slot = lookup(handle);
+            return slot ? &slot->object.value() : nullptr;
+        }
+
+        bool contains(Handle handle) const {
+            return get(handle) != nullptr;
+        }
+
+        // Invalidate the handle for the application, but keep the object alive until erase() or clear().
+        void retire(Handle handle) {
+            Slot* slot = const_cast<Slot*>(lookup(handle));
+            if (slot && !slot->retired) {
+                slot->retired = true;
+                m_liveCount--;
+            }
+        }
+
+        void erase(Handle handle) {
+            Slot* slot = const_cast<Slot*>(lookup(handle));
+            if (slot) {
+                release(*slot);
+                m_freeList.push_back(getIndex(handle));
+            }
+        }
+
+        // Destroy all objects, including retired ones.
+        void clear() {
+            m_freeList.clear();
+            for (uint32_t i = 0; i < m_slots.size(); i++) {
+                if (m_slots[i].object) {
+                    release(m_slots[i]);
+                }
+                m_freeList.push_back(i);
+            }
+        }
+
+        // The number of objects that are not retired.
+        size_t size() const {
+            return m_liveCount;
+        }
+
+        bool empty() const {
+            return m_liveCount == 0;
+        }
+
+        // Invoke the function for each object that is not retired.
+        template <typename F>
+        void forEach(F&& f) {
+            for (uint32_t i = 0; i < m_slots.size(); i++) {
+                Slot& slot = m_slots[i];
+                if (slot.object && !slot.retired) {
+                    f(makeHandle(i, slot.generation), slot.object.value());
+                }
+            }
+        }
+
+        std::vector<Handle> handles() const {
+            std::vector<Handle> handles;
+            handles.reserve(m_liveCount);
+            for (uint32_t i = 0; i < m_slots.size(); i++) {
+                const Slot& slot = m_slots[i];
+                if (slot.object && !slot.retired) {
+                    handles.push_back(makeHandle(i, slot.generation));
+                }
+            }
+            return handles;
+        }
+
+      private:
+        struct Slot {
+            uint32_t generation{1};
+            bool retired{false};
+            std::optional<T> object;
+        };
+
+        static Handle makeHandle(uint32_t index, uint32_t generation) {
+            return (Handle)(((uint64_t)generation << 32) | (index + 1));
+        }
+
+        static uint32_t getIndex(Handle handle) {
+            return (uint32_t)((uint64_t)handle & 0xffffffff) - 1;
+        }
+
+        const Slot* lookup(Handle handle) const {
+            const uint32_t index = getIndex(handle);
+            if (index >= m_slots.size()) {
+                return nullptr;
+            }
+            const Slot& slot = m_slots[index];
+            if (!slot.object || slot.generation != (uint32_t)((uint64_t)handle >> 32)) {
+                return nullptr;
+            }
+            return &slot;
+        }
+
+        void release(Slot& slot) {
+            if (!slot.retired) {
+                m_liveCount--;
+            }
+            slot.object.reset();
+            slot.retired = false;
+            slot.generation++;
+        }
+
+        std::deque<Slot> m_slots;
+        std::vector<uint32_t> m_freeList;
+        size_t m_liveCount{0};
+    };
+
     // https://docs.microsoft.com/en-us/archive/msdn-magazine/2017/may/c-use-modern-c-to-access-the-windows-registry
     static std::optional<int> RegGetDword(HKEY hKey, const std::string& subKey, const std::string& value) {
         DWORD data{};